@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+/*---------------------------------------------------------------------------*/
+/**
+ * \addtogroup arm
+ *
+ * Arm Cortex-M3/M4 time source of the profiler: the DWT cycle counter.
+ * The CPU must define PROFILE_CORTEX_CPU_HZ to its core clock.
+ *
+ * @{
+ */
+/*---------------------------------------------------------------------------*/
+#ifndef PROFILE_CORTEX_H_
+#define PROFILE_CORTEX_H_
+/*---------------------------------------------------------------------------*/
+#include "contiki.h"
+
+#include <stdint.h>
+/*---------------------------------------------------------------------------*/
+/* Architectural addresses, the same on every Cortex-M3/M4 */
+#define PROFILE_CORTEX_DEMCR       (*(volatile uint32_t *)0xE000EDFC)
+#define PROFILE_CORTEX_DWT_CTRL    (*(volatile uint32_t *)0xE0001000)
+#define PROFILE_CORTEX_DWT_CYCCNT  (*(volatile uint32_t *)0xE0001004)
+
+#define PROFILE_CORTEX_DEMCR_TRCENA      (1UL << 24)
+#define PROFILE_CORTEX_DWT_CYCCNTENA     (1UL << 0)
+/*---------------------------------------------------------------------------*/
+static inline uint32_t
+profile_cortex_now(void)
+{
+  return PROFILE_CORTEX_DWT_CYCCNT;
+}
+/*---------------------------------------------------------------------------*/
+static inline void
+profile_cortex_init(void)
+{
+  PROFILE_CORTEX_DEMCR |= PROFILE_CORTEX_DEMCR_TRCENA;
+  PROFILE_CORTEX_DWT_CYCCNT = 0;
+  PROFILE_CORTEX_DWT_CTRL |= PROFILE_CORTEX_DWT_CYCCNTENA;
+}
+/*---------------------------------------------------------------------------*/
+#define PROFILE_ARCH_CURRENT_TIME profile_cortex_now
+#define PROFILE_ARCH_TIME_T       uint32_t
+#define PROFILE_ARCH_SECOND       PROFILE_CORTEX_CPU_HZ
+#define PROFILE_ARCH_INIT         profile_cortex_init
+/*---------------------------------------------------------------------------*/
+#endif /* PROFILE_CORTEX_H_ */
+/*---------------------------------------------------------------------------*/
+/** @} */
@@ -230,6 +230,14 @@
 #ifndef CC2538_RF_CONF_RX_USE_DMA
 #define CC2538_RF_CONF_RX_USE_DMA            1 /**< RF RX over DMA */
 #endif
+
+/**
+ * Slots of the ring the RX ISR moves the received frames to, a power of two
+ * (the ring holds one frame less). 0: the driver process reads the RX FIFO
+ */
+#ifndef CC2538_RF_CONF_RX_FRAMES
+#define CC2538_RF_CONF_RX_FRAMES             0
+#endif
 /** @} */
 /*---------------------------------------------------------------------------*/
 /**
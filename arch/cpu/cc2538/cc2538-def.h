@@ -69,6 +69,10 @@
 #define MUTEX_CONF_ARCH_HEADER_PATH          "mutex-cortex.h"
 #define ATOMIC_CONF_ARCH_HEADER_PATH         "atomic-cortex.h"
 #define MEMORY_BARRIER_CONF_ARCH_HEADER_PATH "memory-barrier-cortex.h"
+
+/* The profiler counts the cycles of the core, 32 MHz by default */
+#define PROFILE_CONF_ARCH_HEADER_PATH        "profile-cortex.h"
+#define PROFILE_CORTEX_CPU_HZ                32000000UL
 /*---------------------------------------------------------------------------*/
 #define GPIO_HAL_CONF_ARCH_HDR_PATH          "dev/gpio-hal-arch.h"
 #define GPIO_HAL_CONF_ARCH_SW_TOGGLE         1
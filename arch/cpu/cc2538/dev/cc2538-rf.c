@@ -48,6 +48,7 @@
 #include "dev/rfcore.h"
 #include "dev/sys-ctrl.h"
 #include "dev/udma.h"
+#include "lib/frame-ring.h"
 #include "reg.h"
 
 #include <string.h>
@@ -108,8 +109,9 @@
 static uint8_t volatile poll_mode = 0;
 /* Do we perform a CCA before sending? Enabled by default. */
 static uint8_t send_on_cca = 1;
+/* RSSI and LQI of the last frame handed out by read() */
 static int8_t rssi;
-static uint8_t crc_corr;
+static uint8_t lqi;
 /*---------------------------------------------------------------------------*/
 static uint8_t rf_flags;
 static uint8_t rf_channel = IEEE802154_DEFAULT_CHANNEL;
@@ -155,6 +157,21 @@ static radio_result_t get_value(radio_param_t param, radio_value_t *value);
  */
 #define MAX_PAYLOAD_LEN (CC2538_RF_MAX_PACKET_LEN - CHECKSUM_LEN)
 /*---------------------------------------------------------------------------*/
+/* Reasons for read_frame() to drop a frame */
+#define RX_BAD_SYNC  -1
+#define RX_TOO_SHORT -2
+#define RX_TOO_LONG  -3
+#define RX_BAD_CRC   -4
+/*---------------------------------------------------------------------------*/
+#if CC2538_RF_CONF_RX_FRAMES
+/* Frames moved out of the RX FIFO by the ISR, for the driver process */
+FRAME_RING(rx_frames, CC2538_RF_CONF_RX_FRAMES, MAX_PAYLOAD_LEN);
+/* Invalid frames dropped by the ISR, which does not log: written by the
+   ISR only, and logged by the process */
+static volatile uint16_t rx_invalid_frames;
+static uint16_t rx_invalid_frames_logged;
+#endif /* CC2538_RF_CONF_RX_FRAMES */
+/*---------------------------------------------------------------------------*/
 PROCESS(cc2538_rf_process, "cc2538 RF driver");
 /*---------------------------------------------------------------------------*/
 /**
@@ -353,6 +370,10 @@ set_poll_mode(uint8_t enable)
     REG(RFCORE_XREG_RFIRQM0) &= ~RFCORE_XREG_RFIRQM0_FIFOP; /* mask out FIFOP interrupt source */
     REG(RFCORE_SFR_RFIRQF0) &= ~RFCORE_SFR_RFIRQF0_FIFOP;   /* clear pending FIFOP interrupt */
     NVIC_DisableIRQ(RF_TX_RX_IRQn);                         /* disable RF interrupts */
+#if CC2538_RF_CONF_RX_FRAMES
+    /* Frames are read from the RX FIFO in poll mode, drop the queued ones */
+    frame_ring_init(&rx_frames);
+#endif /* CC2538_RF_CONF_RX_FRAMES */
   } else {
     REG(RFCORE_XREG_RFIRQM0) |= RFCORE_XREG_RFIRQM0_FIFOP;  /* enable FIFOP interrupt source */
     NVIC_EnableIRQ(RF_TX_RX_IRQn);                          /* enable RF interrupts */
@@ -733,13 +754,19 @@ send(const void *payload, unsigned short payload_len)
   return transmit(payload_len);
 }
 /*---------------------------------------------------------------------------*/
+/*
+ * Read the next frame out of the RX FIFO, along with its RSSI and LQI.
+ * Returns its length without the checksum, 0 if there was no frame, or
+ * one of the RX_* reasons if it was invalid (the FIFO is then flushed).
+ * Also called from the RX ISR: no logging here.
+ */
 static int
-read(void *buf, unsigned short bufsize)
+read_frame(void *buf, unsigned short bufsize,
+           int8_t *frame_rssi, uint8_t *frame_lqi)
 {
   uint8_t i;
   uint8_t len;
-
-  LOG_INFO("Read\n");
+  uint8_t crc_corr;
 
   if((REG(RFCORE_XREG_FSMSTAT1) & RFCORE_XREG_FSMSTAT1_FIFOP) == 0) {
     return 0;
@@ -751,34 +778,25 @@ read(void *buf, unsigned short bufsize)
   /* Check for validity */
   if(len > CC2538_RF_MAX_PACKET_LEN) {
     /* Oops, we must be out of sync. */
-    LOG_ERR("RF: bad sync\n");
-
     CC2538_RF_CSP_ISFLUSHRX();
-    return 0;
+    return RX_BAD_SYNC;
   }
 
   if(len <= CC2538_RF_MIN_PACKET_LEN) {
-    LOG_ERR("RF: too short\n");
-
     CC2538_RF_CSP_ISFLUSHRX();
-    return 0;
+    return RX_TOO_SHORT;
   }
 
   if(len - CHECKSUM_LEN > bufsize) {
-    LOG_ERR("RF: too long\n");
-
     CC2538_RF_CSP_ISFLUSHRX();
-    return 0;
+    return RX_TOO_LONG;
   }
 
   /* If we reach here, chances are the FIFO is holding a valid frame */
-  LOG_INFO("read (0x%02x bytes) = ", len);
   len -= CHECKSUM_LEN;
 
   /* Don't bother with uDMA for short frames (e.g. ACKs) */
   if(CC2538_RF_CONF_RX_USE_DMA && len > UDMA_RX_SIZE_THRESHOLD) {
-    LOG_INFO_("<uDMA payload>");
-
     /* Set the transfer destination's end address */
     udma_set_channel_dst(CC2538_RF_CONF_RX_DMA_CHAN,
                          (uint32_t)(buf) + len - 1);
@@ -798,26 +816,86 @@ read(void *buf, unsigned short bufsize)
   } else {
     for(i = 0; i < len; ++i) {
       ((unsigned char *)(buf))[i] = REG(RFCORE_SFR_RFDATA);
-      LOG_INFO_("%02x", ((unsigned char *)(buf))[i]);
     }
   }
 
   /* Read the RSSI and CRC/Corr bytes */
-  rssi = ((int8_t)REG(RFCORE_SFR_RFDATA)) - RSSI_OFFSET;
+  *frame_rssi = ((int8_t)REG(RFCORE_SFR_RFDATA)) - RSSI_OFFSET;
   crc_corr = REG(RFCORE_SFR_RFDATA);
 
-  LOG_INFO_("%02x%02x\n", (uint8_t)rssi, crc_corr);
-
   /* MS bit CRC OK/Not OK, 7 LS Bits, Correlation value */
-  if(crc_corr & CRC_BIT_MASK) {
-    packetbuf_set_attr(PACKETBUF_ATTR_RSSI, rssi);
-    packetbuf_set_attr(PACKETBUF_ATTR_LINK_QUALITY, crc_corr & LQI_BIT_MASK);
-  } else {
-    LOG_ERR("Bad CRC\n");
+  if(!(crc_corr & CRC_BIT_MASK)) {
     CC2538_RF_CSP_ISFLUSHRX();
+    return RX_BAD_CRC;
+  }
+  *frame_lqi = crc_corr & LQI_BIT_MASK;
+
+  return len;
+}
+/*---------------------------------------------------------------------------*/
+static void
+log_frame(const uint8_t *frame, int len)
+{
+  int i;
+
+  switch(len) {
+  case RX_BAD_SYNC:
+    LOG_ERR("RF: bad sync\n");
+    break;
+  case RX_TOO_SHORT:
+    LOG_ERR("RF: too short\n");
+    break;
+  case RX_TOO_LONG:
+    LOG_ERR("RF: too long\n");
+    break;
+  case RX_BAD_CRC:
+    LOG_ERR("Bad CRC\n");
+    break;
+  default:
+    if(len > 0) {
+      LOG_INFO("read (0x%02x bytes) = ", len + CHECKSUM_LEN);
+      for(i = 0; i < len; i++) {
+        LOG_INFO_("%02x", frame[i]);
+      }
+      LOG_INFO_(" rssi %d lqi %u\n", rssi, lqi);
+    }
+    break;
+  }
+}
+/*---------------------------------------------------------------------------*/
+static int
+read(void *buf, unsigned short bufsize)
+{
+  int len;
+#if CC2538_RF_CONF_RX_FRAMES
+  struct frame_ring_info info;
+#endif /* CC2538_RF_CONF_RX_FRAMES */
+
+  LOG_INFO("Read\n");
+
+#if CC2538_RF_CONF_RX_FRAMES
+  if(!poll_mode) {
+    len = frame_ring_get(&rx_frames, buf, bufsize, &info);
+    if(len > 0) {
+      rssi = info.rssi;
+      lqi = info.lqi;
+      log_frame(buf, len);
+      packetbuf_set_attr(PACKETBUF_ATTR_RSSI, rssi);
+      packetbuf_set_attr(PACKETBUF_ATTR_LINK_QUALITY, lqi);
+    }
+    return len;
+  }
+#endif /* CC2538_RF_CONF_RX_FRAMES */
+
+  len = read_frame(buf, bufsize, &rssi, &lqi);
+  log_frame(buf, len);
+  if(len <= 0) {
     return 0;
   }
 
+  packetbuf_set_attr(PACKETBUF_ATTR_RSSI, rssi);
+  packetbuf_set_attr(PACKETBUF_ATTR_LINK_QUALITY, lqi);
+
   if(!poll_mode) {
     /* If FIFOP==1 and FIFO==0 then we had a FIFO overflow at some point. */
     if(REG(RFCORE_XREG_FSMSTAT1) & RFCORE_XREG_FSMSTAT1_FIFOP) {
@@ -853,6 +931,12 @@ pending_packet(void)
 {
   LOG_INFO("Pending\n");
 
+#if CC2538_RF_CONF_RX_FRAMES
+  if(frame_ring_count(&rx_frames) > 0) {
+    return 1;
+  }
+#endif /* CC2538_RF_CONF_RX_FRAMES */
+
   return REG(RFCORE_XREG_FSMSTAT1) & RFCORE_XREG_FSMSTAT1_FIFOP;
 }
 /*---------------------------------------------------------------------------*/
@@ -912,7 +996,7 @@ get_value(radio_param_t param, radio_value_t *value)
     *value = rssi;
     return RADIO_RESULT_OK;
   case RADIO_PARAM_LAST_LINK_QUALITY:
-    *value = crc_corr & LQI_BIT_MASK;
+    *value = lqi;
     return RADIO_RESULT_OK;
   case RADIO_CONST_CHANNEL_MIN:
     *value = CC2538_RF_CHANNEL_MIN;
@@ -1117,14 +1201,25 @@ PROCESS_THREAD(cc2538_rf_process, ev, data)
     PROCESS_YIELD_UNTIL((!poll_mode || (poll_mode && (rf_flags & RF_MUST_RESET))) && (ev == PROCESS_EVENT_POLL));
 
     if(!poll_mode) {
-      packetbuf_clear();
-      len = read(packetbuf_dataptr(), PACKETBUF_SIZE);
-
-      if(len > 0) {
-        packetbuf_set_datalen(len);
-
-        NETSTACK_MAC.input();
+      /* With the RX ring, hand all the queued frames over in one go */
+      do {
+        packetbuf_clear();
+        len = read(packetbuf_dataptr(), PACKETBUF_SIZE);
+
+        if(len > 0) {
+          packetbuf_set_datalen(len);
+
+          NETSTACK_MAC.input();
+        }
+      } while(len > 0 && CC2538_RF_CONF_RX_FRAMES && !poll_mode);
+
+#if CC2538_RF_CONF_RX_FRAMES
+      if(rx_invalid_frames != rx_invalid_frames_logged) {
+        LOG_ERR("RF: %u invalid frames dropped\n",
+                (uint16_t)(rx_invalid_frames - rx_invalid_frames_logged));
+        rx_invalid_frames_logged = rx_invalid_frames;
       }
+#endif /* CC2538_RF_CONF_RX_FRAMES */
     }
 
     /* If we were polled due to an RF error, reset the transceiver */
@@ -1150,17 +1245,55 @@ PROCESS_THREAD(cc2538_rf_process, ev, data)
   PROCESS_END();
 }
 /*---------------------------------------------------------------------------*/
+#if CC2538_RF_CONF_RX_FRAMES
+/* Move every complete frame out of the RX FIFO and into the RX ring */
+static void
+rx_frames_from_fifo(void)
+{
+  uint8_t *frame;
+  int8_t frame_rssi;
+  uint8_t frame_lqi;
+  int len;
+
+  while(REG(RFCORE_XREG_FSMSTAT1) & RFCORE_XREG_FSMSTAT1_FIFOP) {
+    /* If FIFOP==1 and FIFO==0 then we had a FIFO overflow at some point. */
+    if(!(REG(RFCORE_XREG_FSMSTAT1) & RFCORE_XREG_FSMSTAT1_FIFO)) {
+      CC2538_RF_CSP_ISFLUSHRX();
+      return;
+    }
+    frame = frame_ring_reserve(&rx_frames);
+    if(frame == NULL) {
+      /* The ring is full: the frames still in the FIFO are dropped */
+      CC2538_RF_CSP_ISFLUSHRX();
+      return;
+    }
+    len = read_frame(frame, MAX_PAYLOAD_LEN, &frame_rssi, &frame_lqi);
+    if(len > 0) {
+      frame_ring_commit(&rx_frames, len, frame_rssi, frame_lqi);
+    } else if(len < 0) {
+      rx_invalid_frames++;
+    }
+  }
+}
+#endif /* CC2538_RF_CONF_RX_FRAMES */
+/*---------------------------------------------------------------------------*/
 /**
  * \brief The cc2538 RF RX/TX ISR
  *
  *        This is the interrupt service routine for all RF interrupts relating
  *        to RX and TX. Error conditions are handled by cc2538_rf_err_isr().
  *        Currently, we only acknowledge the FIFOP interrupt source.
+ *
+ *        With CC2538_RF_CONF_RX_FRAMES, the received frames are moved to the
+ *        RX ring right away, which frees the RX FIFO for the next ones.
  */
 void
 cc2538_rf_rx_tx_isr(void)
 {
   if(!poll_mode) {
+#if CC2538_RF_CONF_RX_FRAMES
+    rx_frames_from_fifo();
+#endif /* CC2538_RF_CONF_RX_FRAMES */
     process_poll(&cc2538_rf_process);
   }
 
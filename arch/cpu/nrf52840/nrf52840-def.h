@@ -39,6 +39,10 @@
 #define ATOMIC_CONF_ARCH_HEADER_PATH         "atomic-cortex.h"
 #define MEMORY_BARRIER_CONF_ARCH_HEADER_PATH "memory-barrier-cortex.h"
 /*---------------------------------------------------------------------------*/
+/* The profiler counts the cycles of the 64 MHz core */
+#define PROFILE_CONF_ARCH_HEADER_PATH        "profile-cortex.h"
+#define PROFILE_CORTEX_CPU_HZ                64000000UL
+/*---------------------------------------------------------------------------*/
 /* Do the math in 32bits to save precision.
  * Round to nearest integer rather than truncate. */
 #define US_TO_RTIMERTICKS(US)  ((US) >= 0 ?                        \
@@ -116,6 +116,9 @@ typedef unsigned long clock_time_t;
 /* Use 64-bit rtimer (default in Contiki-NG is 32) */
 #define RTIMER_CONF_CLOCK_SIZE 8
 
+/* The profiler measures the host time */
+#define PROFILE_CONF_ARCH_HEADER_PATH "profile-cooja.h"
+
 /* 1 len byte, 2 bytes CRC */
 #define RADIO_PHY_OVERHEAD         3
 /* 250kbps data rate. One byte = 32us */
@@ -129,6 +132,7 @@ typedef unsigned long clock_time_t;
 #define CFS_CONF_OFFSET_TYPE	long
 
 #define PLATFORM_CONF_SUPPORTS_STACK_CHECK  0
+#define PLATFORM_CONF_SUPPORTS_IDLE_STATS   1
 
 /*---------------------------------------------------------------------------*/
 /* Support for the new GPIO HAL */
@@ -42,6 +42,7 @@
 
 #include "dev/radio.h"
 #include "dev/cooja-radio.h"
+#include "lib/frame-ring.h"
 
 /*
  * The maximum number of bytes this driver can accept from the MAC layer for
@@ -54,6 +55,19 @@
 #define COOJA_RADIO_BUFSIZE 125
 #endif
 
+/*
+ * The number of slots of the ring the received frames are moved to as soon
+ * as Cooja delivers them, so that the next frame does not overwrite one the
+ * MAC layer has not read yet. A power of two; the ring holds one frame less.
+ * 0 hands the frames over one at a time from the reception buffer. Not used
+ * in poll mode.
+ */
+#ifdef COOJA_RADIO_CONF_RX_FRAMES
+#define COOJA_RADIO_RX_FRAMES COOJA_RADIO_CONF_RX_FRAMES
+#else
+#define COOJA_RADIO_RX_FRAMES 4
+#endif
+
 #define MIN_CHANNEL 11
 #define MAX_CHANNEL 26
 #define CCA_SS_THRESHOLD -95
@@ -104,6 +118,13 @@ static int auto_ack = 0; /* AUTO_ACK is not supported; always 0 */
 static int addr_filter = 0; /* ADDRESS_FILTER is not supported; always 0 */
 static int send_on_cca = (COOJA_TRANSMIT_ON_CCA != 0);
 
+#if COOJA_RADIO_RX_FRAMES
+FRAME_RING(rx_frames, COOJA_RADIO_RX_FRAMES, COOJA_RADIO_BUFSIZE);
+/* RSSI and LQI of the last frame handed out from the ring */
+static int ring_last_rssi = RSSI_NO_SIGNAL;
+static int ring_last_lqi = LQI_NO_SIGNAL;
+#endif /* COOJA_RADIO_RX_FRAMES */
+
 PROCESS(cooja_radio_process, "cooja radio process");
 /*---------------------------------------------------------------------------*/
 static void
@@ -128,6 +149,12 @@ static void
 set_poll_mode(int enable)
 {
   poll_mode = enable;
+#if COOJA_RADIO_RX_FRAMES
+  if(enable) {
+    /* Frames are read from the reception buffer in poll mode */
+    frame_ring_init(&rx_frames);
+  }
+#endif /* COOJA_RADIO_RX_FRAMES */
 }
 /*---------------------------------------------------------------------------*/
 void
@@ -146,6 +173,12 @@ radio_set_txpower(unsigned char power)
 int
 radio_signal_strength_last(void)
 {
+#if COOJA_RADIO_RX_FRAMES
+  /* The simulator has moved on to the frames queued after it */
+  if(!poll_mode) {
+    return ring_last_rssi;
+  }
+#endif /* COOJA_RADIO_RX_FRAMES */
   return simLastSignalStrength;
 }
 /*---------------------------------------------------------------------------*/
@@ -164,6 +197,11 @@ radio_LQI(void)
 static
 int radio_lqi_last(void)
 {
+#if COOJA_RADIO_RX_FRAMES
+  if(!poll_mode) {
+    return ring_last_lqi;
+  }
+#endif /* COOJA_RADIO_RX_FRAMES */
   return simLastLQI;
 }
 
@@ -198,6 +236,13 @@ doInterfaceActionsBeforeTick(void)
   }
 
   if(simInSize > 0) {
+#if COOJA_RADIO_RX_FRAMES
+    if(!poll_mode) {
+      frame_ring_put(&rx_frames, simInDataBuffer, simInSize,
+                     simLastSignalStrength, simLastLQI);
+      simInSize = 0;
+    }
+#endif /* COOJA_RADIO_RX_FRAMES */
     process_poll(&cooja_radio_process);
   }
 }
@@ -212,6 +257,21 @@ radio_read(void *buf, unsigned short bufsize)
 {
   int tmp = simInSize;
 
+#if COOJA_RADIO_RX_FRAMES
+  struct frame_ring_info info;
+
+  if(!poll_mode) {
+    tmp = frame_ring_get(&rx_frames, buf, bufsize, &info);
+    if(tmp > 0) {
+      ring_last_rssi = info.rssi;
+      ring_last_lqi = info.lqi;
+      packetbuf_set_attr(PACKETBUF_ATTR_RSSI, info.rssi);
+      packetbuf_set_attr(PACKETBUF_ATTR_LINK_QUALITY, info.lqi);
+    }
+    return tmp;
+  }
+#endif /* COOJA_RADIO_RX_FRAMES */
+
   if(simInSize == 0) {
     return 0;
   }
@@ -327,6 +387,11 @@ receiving_packet(void)
 static int
 pending_packet(void)
 {
+#if COOJA_RADIO_RX_FRAMES
+  if(frame_ring_count(&rx_frames) > 0) {
+    return 1;
+  }
+#endif /* COOJA_RADIO_RX_FRAMES */
   return !simReceiving && simInSize > 0;
 }
 /*---------------------------------------------------------------------------*/
@@ -342,12 +407,15 @@ PROCESS_THREAD(cooja_radio_process, ev, data)
       continue;
     }
 
-    packetbuf_clear();
-    len = radio_read(packetbuf_dataptr(), PACKETBUF_SIZE);
-    if(len > 0) {
-      packetbuf_set_datalen(len);
-      NETSTACK_MAC.input();
-    }
+    /* Hand all the frames received since the last poll over in one go */
+    do {
+      packetbuf_clear();
+      len = radio_read(packetbuf_dataptr(), PACKETBUF_SIZE);
+      if(len > 0) {
+        packetbuf_set_datalen(len);
+        NETSTACK_MAC.input();
+      }
+    } while(len > 0 && COOJA_RADIO_RX_FRAMES && !poll_mode);
   }
 
   PROCESS_END();
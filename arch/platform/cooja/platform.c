@@ -42,6 +42,7 @@
 #include "contiki.h"
 #include "sys/cc.h"
 #include "sys/cooja_mt.h"
+#include "sys/idle.h"
 /*---------------------------------------------------------------------------*/
 /* Log configuration */
 #include "sys/log.h"
@@ -159,8 +160,12 @@ platform_main_loop()
       simProcessRunValue = 1;
     }
 
-    /* Return to COOJA */
+    /* Return to COOJA, which wakes the mote up at the next deadline */
+    if(simProcessRunValue == 0) {
+      idle_enter();
+    }
     cooja_mt_yield();
+    idle_exit();
   }
 }
 /*---------------------------------------------------------------------------*/
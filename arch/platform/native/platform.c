@@ -54,6 +54,8 @@
 
 #include "contiki.h"
 #include "net/netstack.h"
+#include "sys/energest.h"
+#include "sys/idle.h"
 
 #include "dev/serial-line.h"
 #include "dev/button-hal.h"
@@ -171,9 +173,14 @@ static void
 stdin_handle_fd(fd_set *rset, fd_set *wset)
 {
   char c;
+  ssize_t len;
   if(FD_ISSET(STDIN_FILENO, rset)) {
-    if(read(STDIN_FILENO, &c, 1) > 0) {
+    len = read(STDIN_FILENO, &c, 1);
+    if(len > 0) {
       input_handler(c);
+    } else if(len == 0) {
+      /* End of file: stdin would stay readable and the loop never idle */
+      select_set_callback(STDIN_FILENO, NULL);
     }
   }
 }
@@ -298,12 +305,17 @@ platform_main_loop()
     int maxfd;
     int i;
     int retval;
+    int idle;
+    clock_time_t ticks;
     struct timeval tv;
 
     retval = process_run();
 
-    tv.tv_sec = retval ? 0 : SELECT_TIMEOUT / 1000;
-    tv.tv_usec = retval ? 1 : (SELECT_TIMEOUT * 1000) % 1000000;
+    /* Sleep until the next deadline, unless an I/O comes first */
+    ticks = idle_ticks((clock_time_t)SELECT_TIMEOUT * CLOCK_SECOND / 1000);
+    idle = retval == 0 && ticks > 0;
+    tv.tv_sec = idle ? ticks / CLOCK_SECOND : 0;
+    tv.tv_usec = idle ? (ticks % CLOCK_SECOND) * 1000000 / CLOCK_SECOND : 1;
 
     FD_ZERO(&fdr);
     FD_ZERO(&fdw);
@@ -314,7 +326,15 @@ platform_main_loop()
       }
     }
 
+    if(idle) {
+      idle_enter();
+      ENERGEST_SWITCH(ENERGEST_TYPE_CPU, ENERGEST_TYPE_LPM);
+    }
     retval = select(maxfd + 1, &fdr, &fdw, NULL, &tv);
+    if(idle) {
+      ENERGEST_SWITCH(ENERGEST_TYPE_LPM, ENERGEST_TYPE_CPU);
+      idle_exit();
+    }
     if(retval < 0) {
       if(errno != EINTR) {
         perror("select");
@@ -37,6 +37,9 @@ node_id_to_device_id = {}
 
 output_stream = []
 
+# network-wide resource usage: pool name -> [peak, pool size, node with the peak, total failures]
+resource_pools = {}
+
 class NodeStats:
     def __init__(self, id):
         self.id = id
@@ -66,6 +69,11 @@ class NodeStats:
         self.energest_ticks_per_second = 1
         self.energest_joined = False
         self.energest_period_seconds = 60
+        # pool name -> [high-water mark, pool size, allocation failures]
+        self.resources = {}
+        # idle stretches of the platform, and their total length
+        self.idle_sleeps = 0
+        self.idle_ms = 0
 
         # final metrics (uninitialized)
         self.pdr = 0.0
@@ -355,6 +363,16 @@ def analyze_results(filename, is_testbed):
                     nodes[node].parent_packets_queue_dropped += queue_drops
                 continue
 
+            # 960073000 8 [INFO: Resources ] pool routememb: max=3 size=8 failed=0
+            if "INFO: Resources" in line and " pool " in line:
+                name = fields[6][:-1]
+                values = dict(kv.split("=") for kv in fields[7:10])
+                # the counters only grow between resets: keep the largest ones
+                pool = nodes[node].resources.setdefault(name, [0, int(values["size"]), 0])
+                pool[0] = max(pool[0], int(values["max"]))
+                pool[2] = max(pool[2], int(values["failed"]))
+                continue
+
             # 960073000 8 [INFO: Energest  ] Total time  :   60000000
             # 960073000 8 [INFO: Energest  ] CPU         :   60000000/  60000000 (69 permil)
             # 960073000 8 [INFO: Energest  ] LPM         :          0/  60000000 (0 permil)
@@ -362,9 +380,16 @@ def analyze_results(filename, is_testbed):
             # 960073000 8 [INFO: Energest  ] Radio Tx    :      49216/  60000000 (0 permil)
             # 960073000 8 [INFO: Energest  ] Radio Rx    :    2470552/  60000000 (41 permil)
             # 960073000 8 [INFO: Energest  ] Radio total :    2519768/  60000000 (41 permil)
+            # 960073000 8 [INFO: Energest  ] Idle        :         52 sleeps, 1130 ms on average
             if "INFO: Energest" in line:
                 if "Period" in line:
                     nodes[node].energest_period_seconds = int(fields[9][1:])
+                elif "Idle" in line:
+                    sleeps = int(fields[7])
+                    nodes[node].idle_sleeps += sleeps
+                    nodes[node].idle_ms += sleeps * int(fields[9])
+                elif "Maintenance" in line:
+                    pass
                 elif "Total time" in line:
                     total = int(fields[8])
                     nodes[node].energest_total += total
@@ -389,6 +414,13 @@ def analyze_results(filename, is_testbed):
                         nodes[node].energest_joined = nodes[node].has_joined
                     continue
 
+    for k in sorted(nodes.keys()):
+        for name, (peak, size, failed) in nodes[k].resources.items():
+            pool = resource_pools.setdefault(name, [0, size, k, 0])
+            if peak > pool[0]:
+                pool[0], pool[1], pool[2] = peak, size, k
+            pool[3] += failed
+
     if sim_time_ms is None:
         # failed to parse sim end time
         output_stream.append("WARNING: Could not parse the total simulation time. Using last timestamp recorded instead.")
@@ -440,7 +472,9 @@ def analyze_results(filename, is_testbed):
                 "charge": n.charge,
                 "time_joined": n.rpl_time_joined_msec / 1000,
                 "avg_e2e_delay": n.avg_e2e_delay,
-                "jitter": n.jitter
+                "jitter": n.jitter,
+                "idle_sleeps": n.idle_sleeps,
+                "idle_stretch": n.idle_ms / n.idle_sleeps if n.idle_sleeps else np.nan
             }
             r.append(d)
             total_ll_sent += ll_sent
@@ -549,6 +583,15 @@ def main():
     output_stream.append("End-to-end total delay = [ mean= {:.3f} std= {:.3f} ] ms End-to-end total jitter = [ mean= {:.3f} std= {:.3f} ] ms".format(
         np.nanmean(node_e2e_delay), np.nanstd(node_e2e_delay), np.nanmean(node_e2e_jitter), np.nanstd(node_e2e_jitter)))
     output_stream.append("Jain's Justice Index: PDR = {:.3f} Parent Switches = {:.3f} Delay = {:.3f} Jitter = {:.3f}".format(jus_idx_pdr, jus_idx_pc, jus_idx_delay, jus_idx_jitter))
+    idle_sleeps = [r["idle_sleeps"] for r in results]
+    if sum(idle_sleeps):
+        idle_stretch = [r["idle_stretch"] for r in results]
+        output_stream.append("Idle stretches per node = [ mean= {:.3f} std= {:.3f} ] Idle stretch length = [ mean= {:.3f} std= {:.3f} ] ms".format(
+            np.mean(idle_sleeps), np.nanstd(idle_sleeps), np.nanmean(idle_stretch), np.nanstd(idle_stretch)))
+    for name in sorted(resource_pools.keys()):
+        peak, size, node, failed = resource_pools[name]
+        output_stream.append("Pool {}: peak = {} / {} (node {}) Allocation failures = {}".format(
+            name, peak, size, node, failed))
 
     print(*output_stream, sep = "\n", file = sys.stdout)
     print(*output_stream, sep = "\n", file = of)
@@ -43,6 +43,8 @@
 #define TSCH_LOG_CONF_PER_SLOT                     0
 
 #define PROCESS_CONF_NUMEVENTS       32
+/* Keep RPL/MAC/IP events ahead of application traffic */
+#define PROCESS_CONF_WITH_PRIORITIES 1
 
 /* Enable printing of packet counters */
 #define LINK_STATS_CONF_PACKET_COUNTERS          0
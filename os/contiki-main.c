@@ -45,6 +45,7 @@
 #include "sys/node-id.h"
 #include "sys/platform.h"
 #include "sys/energest.h"
+#include "sys/profile.h"
 #include "sys/stack-check.h"
 #include "dev/watchdog.h"
 
@@ -55,6 +56,7 @@
 #include "services/orchestra/orchestra.h"
 #include "services/shell/serial-shell.h"
 #include "services/simple-energest/simple-energest.h"
+#include "services/resource-stats/resource-stats.h"
 #include "services/tsch-cs/tsch-cs.h"
 
 #include <stdio.h>
@@ -79,11 +81,18 @@ main(void)
   clock_init();
   rtimer_init();
   process_init();
+  process_set_priority(&etimer_process, PROCESS_PRIO_SYSTEM);
   process_start(&etimer_process, NULL);
   ctimer_init();
+#if LOG_WITH_BINARY
+  log_binary_init();
+#endif /* LOG_WITH_BINARY */
   watchdog_init();
 
   energest_init();
+#if PROFILE_CONF_ON
+  profile_init();
+#endif /* PROFILE_CONF_ON */
 
 #if STACK_CHECK_ENABLED
   stack_check_init();
@@ -122,6 +131,7 @@ main(void)
   {
     uip_ds6_addr_t *lladdr;
     memcpy(&uip_lladdr.addr, &linkaddr_node_addr, sizeof(uip_lladdr.addr));
+    process_set_priority(&tcpip_process, PROCESS_PRIO_NETWORK);
     process_start(&tcpip_process, NULL);
 
     lladdr = uip_ds6_get_link_local(-1);
@@ -162,6 +172,10 @@ main(void)
   simple_energest_init();
 #endif /* BUILD_WITH_SIMPLE_ENERGEST */
 
+#if BUILD_WITH_RESOURCE_STATS
+  resource_stats_init();
+#endif /* BUILD_WITH_RESOURCE_STATS */
+
 #if BUILD_WITH_TSCH_CS
   /* Initialize the channel selection module */
   tsch_cs_adaptations_init();
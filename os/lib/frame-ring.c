@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ *         A single-producer, single-consumer ring of received frames
+ */
+
+#include "lib/frame-ring.h"
+#include "sys/memory-barrier.h"
+
+#include <string.h>
+/*---------------------------------------------------------------------------*/
+void
+frame_ring_init(struct frame_ring *r)
+{
+  ringbufindex_init(&r->index, ringbufindex_size(&r->index));
+  r->dropped = 0;
+}
+/*---------------------------------------------------------------------------*/
+uint8_t *
+frame_ring_reserve(struct frame_ring *r)
+{
+  int put = ringbufindex_peek_put(&r->index);
+
+  if(put < 0) {
+    r->dropped++;
+    return NULL;
+  }
+  return r->frames + (unsigned)put * r->frame_size;
+}
+/*---------------------------------------------------------------------------*/
+void
+frame_ring_commit(struct frame_ring *r, uint16_t len, int8_t rssi, uint8_t lqi)
+{
+  struct frame_ring_info *info = &r->info[ringbufindex_peek_put(&r->index)];
+
+  info->len = len;
+  info->rssi = rssi;
+  info->lqi = lqi;
+  /* The frame must be in memory before the consumer sees the index */
+  memory_barrier();
+  ringbufindex_put(&r->index);
+}
+/*---------------------------------------------------------------------------*/
+int
+frame_ring_put(struct frame_ring *r, const void *frame, uint16_t len,
+               int8_t rssi, uint8_t lqi)
+{
+  uint8_t *slot;
+
+  if(len > r->frame_size) {
+    r->dropped++;
+    return 0;
+  }
+  slot = frame_ring_reserve(r);
+  if(slot == NULL) {
+    return 0;
+  }
+  memcpy(slot, frame, len);
+  frame_ring_commit(r, len, rssi, lqi);
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+const uint8_t *
+frame_ring_peek(struct frame_ring *r, struct frame_ring_info *info)
+{
+  int get = ringbufindex_peek_get(&r->index);
+
+  if(get < 0) {
+    return NULL;
+  }
+  /* Don't read the frame ahead of the index that published it */
+  memory_barrier();
+  if(info != NULL) {
+    *info = r->info[get];
+  }
+  return r->frames + (unsigned)get * r->frame_size;
+}
+/*---------------------------------------------------------------------------*/
+void
+frame_ring_release(struct frame_ring *r)
+{
+  /* Done with the frame before the producer may overwrite it */
+  memory_barrier();
+  ringbufindex_get(&r->index);
+}
+/*---------------------------------------------------------------------------*/
+int
+frame_ring_get(struct frame_ring *r, void *buf, unsigned short bufsize,
+               struct frame_ring_info *info)
+{
+  struct frame_ring_info frame_info;
+  const uint8_t *frame;
+
+  while((frame = frame_ring_peek(r, &frame_info)) != NULL) {
+    if(frame_info.len <= bufsize) {
+      memcpy(buf, frame, frame_info.len);
+      frame_ring_release(r);
+      if(info != NULL) {
+        *info = frame_info;
+      }
+      return frame_info.len;
+    }
+    frame_ring_release(r);
+  }
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ *         A single-producer, single-consumer ring of received frames
+ */
+
+/**
+ * \addtogroup lib
+ * @{
+ *
+ * \defgroup frame-ring Ring of received frames
+ * @{
+ *
+ * A frame ring hands frames over from an interrupt handler to a process
+ * without disabling interrupts. The producer (typically the radio
+ * interrupt) copies a frame into the next free slot and publishes it;
+ * the consumer (typically the radio driver process) then handles all
+ * the queued frames in one go. The slot indices are kept by a \ref
+ * ringbufindex "ringbufindex" and ordered against the frame contents
+ * with memory_barrier(), so that each side only ever writes its own
+ * index.
+ *
+ * The ring has a power of two number of slots, of which one is always
+ * kept free to tell a full ring from an empty one. Frames that don't
+ * find a free slot are dropped and counted by the producer.
+ */
+
+#ifndef FRAME_RING_H_
+#define FRAME_RING_H_
+
+#include "contiki.h"
+#include "lib/ringbufindex.h"
+
+/** Metadata stored with each frame */
+struct frame_ring_info {
+  uint16_t len;
+  int8_t rssi;
+  uint8_t lqi;
+};
+
+struct frame_ring {
+  struct ringbufindex index;
+  uint16_t frame_size;
+  uint8_t *frames;
+  struct frame_ring_info *info;
+  /* Written by the producer only */
+  volatile uint16_t dropped;
+};
+
+/**
+ * \brief Declare a frame ring
+ * \param name The name of the frame ring
+ * \param num The number of slots, a power of two of at most 128.
+ *        The ring holds up to num - 1 frames.
+ * \param size The size of the largest frame, in bytes
+ */
+#define FRAME_RING(name, num, size) \
+  static uint8_t CC_CONCAT(name, _frame_ring_frames)[(num) * (size)]; \
+  static struct frame_ring_info CC_CONCAT(name, _frame_ring_info)[num]; \
+  static struct frame_ring name = { { (num) - 1, 0, 0 }, (size), \
+                                    CC_CONCAT(name, _frame_ring_frames), \
+                                    CC_CONCAT(name, _frame_ring_info), 0 }
+
+/**
+ * \brief Empty a frame ring and clear its drop counter
+ * \param r The frame ring
+ *
+ * Neither side may use the ring meanwhile.
+ */
+void frame_ring_init(struct frame_ring *r);
+
+/**
+ * \brief Producer: get the next free slot to write a frame in
+ * \param r The frame ring
+ * \return The slot, of r->frame_size bytes, or NULL if the ring is
+ *         full. The frame is then counted as dropped.
+ *
+ * The slot is only handed to the consumer by frame_ring_commit().
+ */
+uint8_t *frame_ring_reserve(struct frame_ring *r);
+
+/**
+ * \brief Producer: publish the frame written in the reserved slot
+ * \param r The frame ring
+ * \param len The length of the frame
+ * \param rssi The RSSI the frame was received with
+ * \param lqi The LQI the frame was received with
+ */
+void frame_ring_commit(struct frame_ring *r, uint16_t len,
+                       int8_t rssi, uint8_t lqi);
+
+/**
+ * \brief Producer: copy a frame in the ring
+ * \param r The frame ring
+ * \param frame The frame
+ * \param len The length of the frame
+ * \param rssi The RSSI the frame was received with
+ * \param lqi The LQI the frame was received with
+ * \retval 1 The frame was queued
+ * \retval 0 The frame was dropped: the ring is full or the frame
+ *         larger than its slots
+ */
+int frame_ring_put(struct frame_ring *r, const void *frame, uint16_t len,
+                   int8_t rssi, uint8_t lqi);
+
+/**
+ * \brief Consumer: look at the oldest frame
+ * \param r The frame ring
+ * \param info Where to store the metadata of the frame
+ * \return The frame, or NULL if the ring is empty
+ *
+ * The frame stays in the ring, untouched by the producer, until
+ * frame_ring_release() is called.
+ */
+const uint8_t *frame_ring_peek(struct frame_ring *r,
+                               struct frame_ring_info *info);
+
+/**
+ * \brief Consumer: give the slot of the oldest frame back to the producer
+ * \param r The frame ring
+ */
+void frame_ring_release(struct frame_ring *r);
+
+/**
+ * \brief Consumer: copy the oldest frame out of the ring
+ * \param r The frame ring
+ * \param buf Where to copy the frame
+ * \param bufsize The size of buf; longer frames are skipped
+ * \param info Where to store the metadata of the frame, or NULL
+ * \return The length of the frame, 0 if the ring is empty
+ */
+int frame_ring_get(struct frame_ring *r, void *buf, unsigned short bufsize,
+                   struct frame_ring_info *info);
+
+/**
+ * \brief The number of frames in a frame ring
+ * \param r The frame ring
+ */
+#define frame_ring_count(r) ringbufindex_elements(&(r)->index)
+
+/**
+ * \brief The number of frames dropped since frame_ring_init()
+ * \param r The frame ring
+ */
+#define frame_ring_dropped(r) ((r)->dropped)
+
+#endif /* FRAME_RING_H_ */
+/** @} */
+/** @} */
@@ -81,6 +81,32 @@
 #define HEAPMEM_REALLOC 1
 #endif /* HEAPMEM_CONF_REALLOC */
 
+/*
+ * The HEAPMEM_CONF_WITH_SIZE_CLASSES parameter determines whether free
+ * chunks are kept in segregated lists of size classes (non-zero value)
+ * instead of a single free list (zero value). The size classes are
+ * indexed by two levels of bitmaps, as in TLSF: a power of two, and
+ * HEAPMEM_CONF_SIZE_CLASS_BITS bits below it. Free chunks are coalesced
+ * with both adjacent chunks when they are freed. Allocations and
+ * deallocations then take a bounded time, instead of a bounded number
+ * of chunks examined that may all be too small.
+ */
+#ifdef HEAPMEM_CONF_WITH_SIZE_CLASSES
+#define HEAPMEM_WITH_SIZE_CLASSES HEAPMEM_CONF_WITH_SIZE_CLASSES
+#else
+#define HEAPMEM_WITH_SIZE_CLASSES 0
+#endif /* HEAPMEM_CONF_WITH_SIZE_CLASSES */
+
+#ifdef HEAPMEM_CONF_SIZE_CLASS_BITS
+#define SL_BITS HEAPMEM_CONF_SIZE_CLASS_BITS
+#else
+#define SL_BITS 3
+#endif /* HEAPMEM_CONF_SIZE_CLASS_BITS */
+
+#if SL_BITS < 1 || SL_BITS > 3
+#error HEAPMEM_CONF_SIZE_CLASS_BITS must be between 1 and 3.
+#endif
+
 #if __STDC_VERSION__ >= 201112L
 #include <stdalign.h>
 #define HEAPMEM_DEFAULT_ALIGNMENT alignof(max_align_t)
@@ -116,6 +142,8 @@
 
 /* Macros for determining the status of a chunk. */
 #define CHUNK_FLAG_ALLOCATED            0x1
+/* The previous chunk in memory is free (size classes only). */
+#define CHUNK_FLAG_PREV_FREE            0x2
 
 #define CHUNK_ALLOCATED(chunk)			\
   ((chunk)->flags & CHUNK_FLAG_ALLOCATED)
@@ -135,6 +163,10 @@ struct heapmem_zone {
   const char *name;
   size_t zone_size;
   size_t allocated;
+#if HEAPMEM_WITH_STATS
+  size_t max_allocated;
+  unsigned nfailed;
+#endif /* HEAPMEM_WITH_STATS */
 };
 
 #ifdef HEAPMEM_CONF_MAX_ZONES
@@ -174,7 +206,49 @@ static char heap_base[HEAPMEM_ARENA_SIZE] CC_ALIGN(HEAPMEM_ALIGNMENT);
 static size_t heap_usage;
 
 static chunk_t *first_chunk = (chunk_t *)heap_base;
+
+#if HEAPMEM_WITH_SIZE_CLASSES
+/* Bits needed for any size in the heap, in steps. */
+#if HEAPMEM_ARENA_SIZE < 0x400
+#define ARENA_BITS 10
+#elif HEAPMEM_ARENA_SIZE < 0x1000
+#define ARENA_BITS 12
+#elif HEAPMEM_ARENA_SIZE < 0x4000
+#define ARENA_BITS 14
+#elif HEAPMEM_ARENA_SIZE < 0x10000
+#define ARENA_BITS 16
+#elif HEAPMEM_ARENA_SIZE < 0x40000
+#define ARENA_BITS 18
+#elif HEAPMEM_ARENA_SIZE < 0x100000
+#define ARENA_BITS 20
+#elif HEAPMEM_ARENA_SIZE < 0x1000000
+#define ARENA_BITS 24
+#else
+#define ARENA_BITS 32
+#endif
+
+#define SL_COUNT (1 << SL_BITS)
+#define FL_COUNT (ARENA_BITS - SL_BITS + 1)
+
+/*
+ * A free chunk stores a pointer to its header in its last bytes, so
+ * that the next chunk in memory can find it when coalescing.
+ */
+#define MIN_CHUNK_SIZE ALIGN(sizeof(chunk_t *))
+#define FOOTER(chunk)                                                   \
+  (*(chunk_t **)(GET_PTR(chunk) + (chunk)->size - sizeof(chunk_t *)))
+#define PREV_FOOTER(chunk) (((chunk_t **)(chunk))[-1])
+
+/* Free chunks of each size class, and bitmaps of the non-empty ones. */
+static chunk_t *free_lists[FL_COUNT][SL_COUNT];
+static uint32_t fl_bitmap;
+static uint8_t sl_bitmap[FL_COUNT];
+#else /* HEAPMEM_WITH_SIZE_CLASSES */
+/* A chunk split off must not be empty. */
+#define MIN_CHUNK_SIZE 1
+
 static chunk_t *free_list;
+#endif /* HEAPMEM_WITH_SIZE_CLASSES */
 
 #define IN_HEAP(ptr) ((char *)(ptr) >= (char *)heap_base) && \
                      ((char *)(ptr) < (char *)heap_base + heap_usage)
@@ -194,6 +268,140 @@ extend_space(size_t size)
   return old_usage;
 }
 
+#if HEAPMEM_WITH_SIZE_CLASSES
+#ifdef __GNUC__
+/* find_last_set: Index of the most significant bit set in a non-zero value. */
+static unsigned
+find_last_set(unsigned long value)
+{
+  return sizeof(unsigned long) * 8 - 1 - __builtin_clzl(value);
+}
+
+/* find_first_set: Index of the least significant bit set in a non-zero
+   value. */
+static unsigned
+find_first_set(unsigned long value)
+{
+  return __builtin_ctzl(value);
+}
+#else /* __GNUC__ */
+static unsigned
+find_last_set(unsigned long value)
+{
+  unsigned index = 0;
+
+  while(value >>= 1) {
+    index++;
+  }
+  return index;
+}
+
+static unsigned
+find_first_set(unsigned long value)
+{
+  unsigned index = 0;
+
+  while(!(value & 1)) {
+    value >>= 1;
+    index++;
+  }
+  return index;
+}
+#endif /* __GNUC__ */
+
+/* size_class: Map a chunk size to its size class. */
+static void
+size_class(size_t size, unsigned *fl, unsigned *sl)
+{
+  size_t units = size / HEAPMEM_ALIGNMENT;
+
+  if(units < SL_COUNT) {
+    *fl = 0;
+    *sl = units;
+  } else {
+    unsigned last = find_last_set(units);
+    *sl = (units >> (last - SL_BITS)) - SL_COUNT;
+    *fl = last - SL_BITS + 1;
+  }
+}
+
+/* insert_free_chunk: Put a free chunk on the list of its size class. */
+static void
+insert_free_chunk(chunk_t * const chunk)
+{
+  unsigned fl, sl;
+
+  size_class(chunk->size, &fl, &sl);
+  chunk->prev = NULL;
+  chunk->next = free_lists[fl][sl];
+  if(chunk->next != NULL) {
+    chunk->next->prev = chunk;
+  }
+  free_lists[fl][sl] = chunk;
+  fl_bitmap |= (uint32_t)1 << fl;
+  sl_bitmap[fl] |= 1 << sl;
+
+  /* A free chunk is never the last one, which is released instead. */
+  FOOTER(chunk) = chunk;
+  NEXT_CHUNK(chunk)->flags |= CHUNK_FLAG_PREV_FREE;
+}
+
+/* remove_chunk_from_free_list: Remove a chunk from the list of its
+   size class. */
+static void
+remove_chunk_from_free_list(chunk_t * const chunk)
+{
+  unsigned fl, sl;
+
+  size_class(chunk->size, &fl, &sl);
+  if(chunk->prev != NULL) {
+    chunk->prev->next = chunk->next;
+  } else {
+    free_lists[fl][sl] = chunk->next;
+    if(chunk->next == NULL) {
+      sl_bitmap[fl] &= ~(1 << sl);
+      if(sl_bitmap[fl] == 0) {
+        fl_bitmap &= ~((uint32_t)1 << fl);
+      }
+    }
+  }
+  if(chunk->next != NULL) {
+    chunk->next->prev = chunk->prev;
+  }
+
+  if(!IS_LAST_CHUNK(chunk)) {
+    NEXT_CHUNK(chunk)->flags &= ~CHUNK_FLAG_PREV_FREE;
+  }
+}
+
+/* free_chunk: Mark a chunk as being free, coalesce it with the
+   adjacent free chunks, and put it on the list of its size class. */
+static void
+free_chunk(chunk_t *chunk)
+{
+  chunk->flags &= ~CHUNK_FLAG_ALLOCATED;
+
+  if(chunk->flags & CHUNK_FLAG_PREV_FREE) {
+    chunk_t *prev = PREV_FOOTER(chunk);
+    remove_chunk_from_free_list(prev);
+    prev->size += sizeof(chunk_t) + chunk->size;
+    chunk = prev;
+  }
+
+  if(!IS_LAST_CHUNK(chunk) && CHUNK_FREE(NEXT_CHUNK(chunk))) {
+    chunk_t *next = NEXT_CHUNK(chunk);
+    remove_chunk_from_free_list(next);
+    chunk->size += sizeof(chunk_t) + next->size;
+  }
+
+  if(IS_LAST_CHUNK(chunk)) {
+    /* Release the chunk back into the wilderness. */
+    heap_usage -= sizeof(chunk_t) + chunk->size;
+  } else {
+    insert_free_chunk(chunk);
+  }
+}
+#else /* HEAPMEM_WITH_SIZE_CLASSES */
 /* free_chunk: Mark a chunk as being free, and put it on the free list. */
 static void
 free_chunk(chunk_t * const chunk)
@@ -232,6 +440,7 @@ remove_chunk_from_free_list(chunk_t * const chunk)
     chunk->next->prev = chunk->prev;
   }
 }
+#endif /* HEAPMEM_WITH_SIZE_CLASSES */
 
 /*
  * split_chunk: When allocating a chunk, we may have found one that is
@@ -243,7 +452,7 @@ split_chunk(chunk_t * const chunk, size_t offset)
 {
   offset = ALIGN(offset);
 
-  if(offset + sizeof(chunk_t) < chunk->size) {
+  if(offset + sizeof(chunk_t) + MIN_CHUNK_SIZE <= chunk->size) {
     chunk_t *new_chunk = (chunk_t *)(GET_PTR(chunk) + offset);
     new_chunk->size = chunk->size - sizeof(chunk_t) - offset;
     new_chunk->flags = 0;
@@ -268,6 +477,53 @@ coalesce_chunks(chunk_t *chunk)
   }
 }
 
+#if HEAPMEM_WITH_SIZE_CLASSES
+/* get_free_chunk: Take a chunk from the smallest size class whose
+   chunks all satisfy an allocation request. */
+static chunk_t *
+get_free_chunk(const size_t size)
+{
+  unsigned fl, sl;
+  size_t units = size / HEAPMEM_ALIGNMENT;
+  uint32_t fl_map;
+  uint8_t sl_map;
+
+  /* A chunk of the same class may be large enough, as for repeated
+     allocations of the same size. */
+  size_class(size, &fl, &sl);
+  chunk_t *best = free_lists[fl][sl];
+
+  if(best == NULL || best->size < size) {
+    /* Round up to the next size class. */
+    if(units >= SL_COUNT) {
+      units += ((size_t)1 << (find_last_set(units) - SL_BITS)) - 1;
+    }
+    size_class(units * HEAPMEM_ALIGNMENT, &fl, &sl);
+    if(fl >= FL_COUNT) {
+      return NULL;
+    }
+
+    sl_map = sl_bitmap[fl] & (0xff << sl);
+    if(sl_map == 0) {
+      /* Nothing in this power of two: take the next one. */
+      fl_map = fl + 1 < FL_COUNT ? fl_bitmap & ~(((uint32_t)2 << fl) - 1) : 0;
+      if(fl_map == 0) {
+        return NULL;
+      }
+      fl = find_first_set(fl_map);
+      sl_map = sl_bitmap[fl];
+    }
+    sl = find_first_set(sl_map);
+    best = free_lists[fl][sl];
+  }
+
+  /* We found a chunk for the allocation. Split it if necessary. */
+  remove_chunk_from_free_list(best);
+  split_chunk(best, size);
+
+  return best;
+}
+#else /* HEAPMEM_WITH_SIZE_CLASSES */
 /* defrag_chunks: Scan the free list for chunks that can be coalesced,
    and stop within a bounded time. */
 static void
@@ -322,6 +578,23 @@ get_free_chunk(const size_t size)
 
   return best;
 }
+#endif /* HEAPMEM_WITH_SIZE_CLASSES */
+
+#if HEAPMEM_WITH_STATS
+/* update_peak: Record the high-water mark of a zone that grew. */
+static void
+update_peak(heapmem_zone_t zone)
+{
+  if(zones[zone].allocated > zones[zone].max_allocated) {
+    zones[zone].max_allocated = zones[zone].allocated;
+  }
+}
+#define ZONE_GREW(zone) update_peak(zone)
+#define ZONE_FAILED(zone) (zones[zone].nfailed++)
+#else /* HEAPMEM_WITH_STATS */
+#define ZONE_GREW(zone)
+#define ZONE_FAILED(zone)
+#endif /* HEAPMEM_WITH_STATS */
 
 /*
  * heapmem_zone_register: Register a new zone, which is essentially a
@@ -394,10 +667,16 @@ heapmem_zone_alloc(heapmem_zone_t zone, size_t size)
   }
 
   size = ALIGN(size);
+#if HEAPMEM_WITH_SIZE_CLASSES
+  if(size < MIN_CHUNK_SIZE) {
+    size = MIN_CHUNK_SIZE;
+  }
+#endif /* HEAPMEM_WITH_SIZE_CLASSES */
 
   if(sizeof(chunk_t) + size >
      zones[zone].zone_size - zones[zone].allocated) {
     LOG_ERR("Cannot allocate %zu bytes because of the zone limit\n", size);
+    ZONE_FAILED(zone);
     return NULL;
   }
 
@@ -405,6 +684,7 @@ heapmem_zone_alloc(heapmem_zone_t zone, size_t size)
   if(chunk == NULL) {
     chunk = extend_space(sizeof(chunk_t) + size);
     if(chunk == NULL) {
+      ZONE_FAILED(zone);
       return NULL;
     }
     chunk->size = size;
@@ -421,6 +701,7 @@ heapmem_zone_alloc(heapmem_zone_t zone, size_t size)
 
   chunk->zone = zone;
   zones[zone].allocated += sizeof(chunk_t) + size;
+  ZONE_GREW(zone);
 
   return GET_PTR(chunk);
 
@@ -529,6 +810,11 @@ heapmem_realloc(void *ptr, size_t size)
 #endif
 
   size = ALIGN(size);
+#if HEAPMEM_WITH_SIZE_CLASSES
+  if(size < MIN_CHUNK_SIZE) {
+    size = MIN_CHUNK_SIZE;
+  }
+#endif /* HEAPMEM_WITH_SIZE_CLASSES */
   int size_adj = size - chunk->size;
 
   if(size_adj <= 0) {
@@ -549,6 +835,7 @@ heapmem_realloc(void *ptr, size_t size)
     if(extend_space(size_adj) != NULL) {
       chunk->size = size;
       zones[chunk->zone].allocated += size_adj;
+      ZONE_GREW(chunk->zone);
       return ptr;
     }
   } else {
@@ -563,6 +850,7 @@ heapmem_realloc(void *ptr, size_t size)
 	 its current place. */
       split_chunk(chunk, size);
       zones[chunk->zone].allocated += size_adj;
+      ZONE_GREW(chunk->zone);
       return ptr;
     }
   }
@@ -579,6 +867,7 @@ heapmem_realloc(void *ptr, size_t size)
   }
 
   memcpy(newptr, ptr, chunk->size);
+  zones[chunk->zone].allocated -= sizeof(chunk_t) + chunk->size;
   free_chunk(chunk);
 
   return newptr;
@@ -607,6 +896,24 @@ heapmem_stats(heapmem_stats_t *stats)
   stats->chunks = stats->overhead / sizeof(chunk_t);
 }
 
+#if HEAPMEM_WITH_STATS
+/* heapmem_zone_stats: Obtain the usage statistics of a zone. */
+bool
+heapmem_zone_stats(heapmem_zone_t zone, heapmem_zone_stats_t *stats)
+{
+  if(zone >= HEAPMEM_MAX_ZONES || zones[zone].name == NULL) {
+    return false;
+  }
+
+  stats->name = zones[zone].name;
+  stats->zone_size = zones[zone].zone_size;
+  stats->allocated = zones[zone].allocated;
+  stats->max_allocated = zones[zone].max_allocated;
+  stats->nfailed = zones[zone].nfailed;
+  return true;
+}
+#endif /* HEAPMEM_WITH_STATS */
+
 /* heapmem_alignment: return the minimum alignment of allocated addresses. */
 size_t
 heapmem_alignment(void)
@@ -81,6 +81,17 @@
 #ifndef HEAPMEM_DEBUG
 #define HEAPMEM_DEBUG 0
 #endif
+
+/*
+ * The HEAPMEM_CONF_WITH_STATS parameter makes each zone keep the
+ * high-water mark of its allocated bytes and count its failed
+ * allocations, for heapmem_zone_stats().
+ */
+#ifdef HEAPMEM_CONF_WITH_STATS
+#define HEAPMEM_WITH_STATS HEAPMEM_CONF_WITH_STATS
+#else
+#define HEAPMEM_WITH_STATS 0
+#endif
 /*****************************************************************************/
 typedef struct heapmem_stats {
   size_t allocated;
@@ -95,6 +106,16 @@ typedef uint8_t heapmem_zone_t;
 #define HEAPMEM_ZONE_INVALID (heapmem_zone_t)-1
 #define HEAPMEM_ZONE_GENERAL 0
 /*****************************************************************************/
+#if HEAPMEM_WITH_STATS
+typedef struct heapmem_zone_stats {
+  const char *name;
+  size_t zone_size;
+  size_t allocated;
+  size_t max_allocated;
+  unsigned nfailed;
+} heapmem_zone_stats_t;
+#endif /* HEAPMEM_WITH_STATS */
+/*****************************************************************************/
 
 /**
  * \brief      Register a zone with a reserved subdivision of the heap.
@@ -199,6 +220,23 @@ bool heapmem_free(void *ptr);
 
 void heapmem_stats(heapmem_stats_t *stats);
 
+#if HEAPMEM_WITH_STATS
+/**
+ * \brief       Obtain the usage statistics of a zone.
+ * \param zone  The zone, from HEAPMEM_ZONE_GENERAL on.
+ * \param stats A pointer to an object of type heapmem_zone_stats_t,
+ *              which will be filled when calling this function.
+ * \return      false if no zone is registered with this ID.
+ *
+ * The allocated bytes, and their high-water mark, include the chunk
+ * headers, as does the zone size. The zones are registered in
+ * sequence, so the statistics of all zones can be obtained by
+ * incrementing the ID until this function returns false.
+ */
+
+bool heapmem_zone_stats(heapmem_zone_t zone, heapmem_zone_stats_t *stats);
+#endif /* HEAPMEM_WITH_STATS */
+
 /**
  * \brief       Obtain the minimum alignment of allocated addresses.
  * \return      The alignment value, which is a power of two.
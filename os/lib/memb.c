@@ -42,24 +42,85 @@
  * Memory block allocation routines.
  * \author Adam Dunkels <adam@sics.se>
  */
+#include <limits.h>
 #include <string.h>
 
 #include "contiki.h"
 #include "lib/memb.h"
 
+#if MEMB_WITH_STATS
+/* The pools initialized or allocated from so far */
+static struct memb *pools;
+/*---------------------------------------------------------------------------*/
+static void
+list_pool(struct memb *m)
+{
+  if(!m->listed) {
+    m->listed = true;
+    m->next_pool = pools;
+    pools = m;
+  }
+}
+#endif /* MEMB_WITH_STATS */
 /*---------------------------------------------------------------------------*/
 void
 memb_init(struct memb *m)
 {
   memset(m->used, 0, m->num);
   memset(m->mem, 0, m->size * m->num);
+#if MEMB_WITH_FREE_LIST
+  m->fresh = 0;
+  m->free_head = NULL;
+#endif /* MEMB_WITH_FREE_LIST */
+#if MEMB_WITH_STATS
+  /* The high-water mark and the failures outlive a re-initialization */
+  m->nused = 0;
+  list_pool(m);
+#endif /* MEMB_WITH_STATS */
 }
 /*---------------------------------------------------------------------------*/
-void *
-memb_alloc(struct memb *m)
+/* Index of the block that starts at ptr, or -1 */
+static int
+block_index(struct memb *m, void *ptr)
+{
+  size_t offset;
+
+  if(!memb_inmemb(m, ptr)) {
+    return -1;
+  }
+  offset = (char *)ptr - (char *)m->mem;
+  if(offset % m->size != 0) {
+    return -1;
+  }
+  return offset / m->size;
+}
+/*---------------------------------------------------------------------------*/
+static void *
+alloc_block(struct memb *m)
 {
   int i;
 
+#if MEMB_WITH_FREE_LIST
+  if(m->with_free_list) {
+    void *block;
+
+    if(m->free_head != NULL) {
+      /* Reuse the last freed block */
+      block = m->free_head;
+      memcpy(&m->free_head, block, sizeof(void *));
+      i = block_index(m, block);
+    } else if(m->fresh < m->num) {
+      /* Carve a block that was never allocated */
+      i = m->fresh++;
+      block = (char *)m->mem + (i * m->size);
+    } else {
+      return NULL;
+    }
+    m->used[i] = true;
+    return block;
+  }
+#endif /* MEMB_WITH_FREE_LIST */
+
   for(i = 0; i < m->num; ++i) {
     if(m->used[i] == false) {
       /* If this block was unused, we set the used flag on
@@ -74,27 +135,51 @@ memb_alloc(struct memb *m)
   return NULL;
 }
 /*---------------------------------------------------------------------------*/
+void *
+memb_alloc(struct memb *m)
+{
+  void *block = alloc_block(m);
+
+#if MEMB_WITH_STATS
+  /* Some pools rely on zero-initialization instead of memb_init() */
+  list_pool(m);
+  if(block == NULL) {
+    if(m->nfailed < USHRT_MAX) {
+      m->nfailed++;
+    }
+  } else if(++m->nused > m->maxused) {
+    m->maxused = m->nused;
+  }
+#endif /* MEMB_WITH_STATS */
+
+  return block;
+}
+/*---------------------------------------------------------------------------*/
 int
 memb_free(struct memb *m, void *ptr)
 {
   int i;
-  char *ptr2;
 
-  /* Walk through the list of blocks and try to find the block to
-     which the pointer "ptr" points to. */
-  ptr2 = (char *)m->mem;
-  for(i = 0; i < m->num; ++i) {
-    if(ptr2 == (char *)ptr) {
-      /* We've found the block to which "ptr" points, so we check the allocation
-         status to detect the double-free error and free the block. */
-      if (m->used[i] == false)
-        return -1;
-      m->used[i] = false;
-      return 0;
-    }
-    ptr2 += m->size;
+  /* Find the block to which the pointer "ptr" points, and check the
+     allocation status to detect the double-free error. */
+  i = block_index(m, ptr);
+  if(i < 0 || m->used[i] == false) {
+    return -1;
+  }
+  m->used[i] = false;
+#if MEMB_WITH_STATS
+  m->nused--;
+#endif /* MEMB_WITH_STATS */
+
+#if MEMB_WITH_FREE_LIST
+  if(m->with_free_list) {
+    /* Pointer copied, as the block may not be aligned for a pointer */
+    memcpy(ptr, &m->free_head, sizeof(void *));
+    m->free_head = ptr;
   }
-  return -1;
+#endif /* MEMB_WITH_FREE_LIST */
+
+  return 0;
 }
 /*---------------------------------------------------------------------------*/
 int
@@ -107,6 +192,9 @@ memb_inmemb(struct memb *m, void *ptr)
 size_t
 memb_numfree(struct memb *m)
 {
+#if MEMB_WITH_STATS
+  return m->num - m->nused;
+#else /* MEMB_WITH_STATS */
   int i;
   size_t num_free = 0;
 
@@ -117,5 +205,14 @@ memb_numfree(struct memb *m)
   }
 
   return num_free;
+#endif /* MEMB_WITH_STATS */
+}
+/*---------------------------------------------------------------------------*/
+#if MEMB_WITH_STATS
+struct memb *
+memb_pools(void)
+{
+  return pools;
 }
+#endif /* MEMB_WITH_STATS */
 /** @} */
@@ -93,13 +93,92 @@ MEMB(connections, struct connection, 16);
         static structure CC_CONCAT(name,_memb_mem)[num]; \
         static struct memb name = {sizeof(structure), num, \
                                           CC_CONCAT(name,_memb_used), \
-                                          (void *)CC_CONCAT(name,_memb_mem)}
+                                          (void *)CC_CONCAT(name,_memb_mem) \
+                                          MEMB_STATS_INIT(name)}
+
+/**
+ * \brief Keep usage statistics of each memory block
+ *
+ * Each pool counts its blocks in use, their high-water mark and the
+ * allocations that failed. memb_init() or the first memb_alloc() links
+ * the pool in the list returned by memb_pools(), for the resource
+ * telemetry. Each struct memb grows by a name, a pointer, a flag and
+ * three counters.
+ */
+#ifdef MEMB_CONF_WITH_STATS
+#define MEMB_WITH_STATS MEMB_CONF_WITH_STATS
+#else
+#define MEMB_WITH_STATS 0
+#endif
+
+#if MEMB_WITH_STATS
+#define MEMB_STATS_INIT(name) , .label = #name
+#else /* MEMB_WITH_STATS */
+#define MEMB_STATS_INIT(name)
+#endif /* MEMB_WITH_STATS */
+
+/**
+ * \brief Enable memory blocks declared with MEMB_FREE_LIST()
+ *
+ * A free-list pool keeps its free blocks in a list threaded through
+ * the blocks themselves, so memb_alloc() is O(1) instead of a scan of
+ * the pool. Each struct memb grows by a flag, a counter and a pointer.
+ */
+#ifdef MEMB_CONF_WITH_FREE_LIST
+#define MEMB_WITH_FREE_LIST MEMB_CONF_WITH_FREE_LIST
+#else
+#define MEMB_WITH_FREE_LIST 0
+#endif
+
+/**
+ * Declare a memory block with an O(1) allocator.
+ *
+ * This macro is used like MEMB(). The structure must be at least as
+ * large as a pointer, which is stored in the free blocks. Without
+ * MEMB_CONF_WITH_FREE_LIST, this is MEMB().
+ *
+ * \param name The name of the memory block.
+ *
+ * \param structure The name of the struct that the memory block holds
+ *
+ * \param num The total number of memory chunks in the block.
+ *
+ */
+#if MEMB_WITH_FREE_LIST
+#define MEMB_FREE_LIST(name, structure, num) \
+        static bool CC_CONCAT(name,_memb_used)[num]; \
+        static structure CC_CONCAT(name,_memb_mem)[num]; \
+        static struct memb name = {sizeof(structure), num, \
+                                          CC_CONCAT(name,_memb_used), \
+                                          (void *)CC_CONCAT(name,_memb_mem), \
+                                          true, 0, NULL \
+                                          MEMB_STATS_INIT(name)}
+#else /* MEMB_WITH_FREE_LIST */
+#define MEMB_FREE_LIST(name, structure, num) MEMB(name, structure, num)
+#endif /* MEMB_WITH_FREE_LIST */
 
 struct memb {
   unsigned short size;
   unsigned short num;
   bool *used;
   void *mem;
+#if MEMB_WITH_FREE_LIST
+  /* Free-list pool */
+  bool with_free_list;
+  /* Blocks from this index on have never been allocated */
+  unsigned short fresh;
+  /* Freed blocks, linked through their first bytes */
+  void *free_head;
+#endif /* MEMB_WITH_FREE_LIST */
+#if MEMB_WITH_STATS
+  /* Name of the pool, and next pool in the list of memb_pools() */
+  const char *label;
+  struct memb *next_pool;
+  bool listed;
+  unsigned short nused;
+  unsigned short maxused;
+  unsigned short nfailed;
+#endif /* MEMB_WITH_STATS */
 };
 
 /**
@@ -150,6 +229,17 @@ int memb_inmemb(struct memb *m, void *ptr);
  */
 size_t memb_numfree(struct memb *m);
 
+#if MEMB_WITH_STATS
+/**
+ * The memory blocks initialized or allocated from so far
+ *
+ * \return The first pool; the others follow through its next_pool
+ * field. Each pool reports its high-water mark in maxused and its
+ * failed allocations in nfailed.
+ */
+struct memb *memb_pools(void);
+#endif /* MEMB_WITH_STATS */
+
 /** @} */
 /** @} */
 
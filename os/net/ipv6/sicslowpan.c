@@ -75,6 +75,7 @@
 #include "net/queuebuf.h"
 
 #include "net/routing/routing.h"
+#include "sys/profile.h"
 
 /* Log configuration */
 #include "sys/log.h"
@@ -195,6 +196,8 @@ static uint8_t curr_page;
 static int last_tx_status;
 /** @} */
 
+PROFILE_PROBE(iphc_probe, "compress_hdr_iphc");
+
 /* ----------------------------------------------------------------- */
 /* Support for reassembling multiple packets                         */
 /* ----------------------------------------------------------------- */
@@ -202,6 +205,10 @@ static int last_tx_status;
 #if SICSLOWPAN_CONF_FRAG
 static uint16_t my_tag;
 
+/** The packetbuf attributes shared by all fragments of the outgoing packet */
+static struct packetbuf_attr frag_attrs[PACKETBUF_NUM_ATTRS];
+static struct packetbuf_addr frag_addrs[PACKETBUF_NUM_ADDRS];
+
 /** The total length of the IPv6 packet in the sicslowpan_buf. */
 
 /* This needs to be defined in NBR / Nodes depending on available RAM   */
@@ -510,6 +517,15 @@ set_packet_attrs(void)
 #if SICSLOWPAN_CONF_MAX_ADDR_CONTEXTS > 0
 static struct sicslowpan_addr_context
 addr_contexts[SICSLOWPAN_CONF_MAX_ADDR_CONTEXTS];
+
+/* Index of the used contexts, rebuilt by index_addr_contexts() whenever
+ * addr_contexts changes: by context identifier, and sorted by prefix */
+static struct sicslowpan_addr_context *contexts_by_number[16];
+static struct sicslowpan_addr_context
+*contexts_by_prefix[SICSLOWPAN_CONF_MAX_ADDR_CONTEXTS];
+static uint8_t contexts_count;
+/* The context found by the last prefix lookup */
+static struct sicslowpan_addr_context *last_context;
 #endif
 
 /** pointer to an address context. */
@@ -551,6 +567,38 @@ static const uint8_t ttl_values[] = {0, 1, 64, 255};
 /*--------------------------------------------------------------------*/
 /** \name IPHC related functions
  * @{                                                                 */
+#if SICSLOWPAN_CONF_MAX_ADDR_CONTEXTS > 0
+/*--------------------------------------------------------------------*/
+/** \brief rebuild the indexes of the used contexts. Where contexts
+ * share a prefix or a number, the first one in addr_contexts wins */
+static void
+index_addr_contexts(void)
+{
+  struct sicslowpan_addr_context *c;
+  int i, j;
+
+  memset(contexts_by_number, 0, sizeof(contexts_by_number));
+  contexts_count = 0;
+  last_context = NULL;
+  for(i = 0; i < SICSLOWPAN_CONF_MAX_ADDR_CONTEXTS; i++) {
+    c = &addr_contexts[i];
+    if(c->used != 1) {
+      continue;
+    }
+    if(c->number < 16 && contexts_by_number[c->number] == NULL) {
+      contexts_by_number[c->number] = c;
+    }
+    /* Stable insertion sort: equal prefixes keep their order */
+    for(j = contexts_count;
+        j > 0 && memcmp(contexts_by_prefix[j - 1]->prefix, c->prefix, 8) > 0;
+        j--) {
+      contexts_by_prefix[j] = contexts_by_prefix[j - 1];
+    }
+    contexts_by_prefix[j] = c;
+    contexts_count++;
+  }
+}
+#endif /* SICSLOWPAN_CONF_MAX_ADDR_CONTEXTS > 0 */
 /*--------------------------------------------------------------------*/
 /** \brief find the context corresponding to prefix ipaddr */
 static struct sicslowpan_addr_context*
@@ -558,13 +606,31 @@ addr_context_lookup_by_prefix(uip_ipaddr_t *ipaddr)
 {
 /* Remove code to avoid warnings and save flash if no context is used */
 #if SICSLOWPAN_CONF_MAX_ADDR_CONTEXTS > 0
-  int i;
-  for(i = 0; i < SICSLOWPAN_CONF_MAX_ADDR_CONTEXTS; i++) {
-    if((addr_contexts[i].used == 1) &&
-       uip_ipaddr_prefixcmp(&addr_contexts[i].prefix, ipaddr, 64)) {
-      return &addr_contexts[i];
+  int low, high, mid, cmp;
+
+  /* Consecutive packets mostly go to and come from the same prefix */
+  if(last_context != NULL &&
+     uip_ipaddr_prefixcmp(&last_context->prefix, ipaddr, 64)) {
+    return last_context;
+  }
+
+  /* Binary search for the first context with this prefix */
+  low = 0;
+  high = contexts_count;
+  while(low < high) {
+    mid = (low + high) / 2;
+    cmp = memcmp(contexts_by_prefix[mid]->prefix, ipaddr, 8);
+    if(cmp < 0) {
+      low = mid + 1;
+    } else {
+      high = mid;
     }
   }
+  if(low < contexts_count &&
+     uip_ipaddr_prefixcmp(&contexts_by_prefix[low]->prefix, ipaddr, 64)) {
+    last_context = contexts_by_prefix[low];
+    return last_context;
+  }
 #endif /* SICSLOWPAN_CONF_MAX_ADDR_CONTEXTS > 0 */
   return NULL;
 }
@@ -575,12 +641,8 @@ addr_context_lookup_by_number(uint8_t number)
 {
 /* Remove code to avoid warnings and save flash if no context is used */
 #if SICSLOWPAN_CONF_MAX_ADDR_CONTEXTS > 0
-  int i;
-  for(i = 0; i < SICSLOWPAN_CONF_MAX_ADDR_CONTEXTS; i++) {
-    if((addr_contexts[i].used == 1) &&
-       addr_contexts[i].number == number) {
-      return &addr_contexts[i];
-    }
+  if(number < 16) {
+    return contexts_by_number[number];
   }
 #endif /* SICSLOWPAN_CONF_MAX_ADDR_CONTEXTS > 0 */
   return NULL;
@@ -1567,30 +1629,21 @@ send_packet(linkaddr_t *dest)
  * \param uip_offset the offset in the uIP buffer where to copy the payload from
  * \param dest the link layer destination address of the packet
  * \return 1 if success, 0 otherwise
+ *
+ * The fragment headers must already be in place at packetbuf_ptr. The
+ * payload is copied from uip_buf straight behind them, so that the MAC
+ * layer queues the fragment with a single copy of the data.
  */
 static int
 fragment_copy_payload_and_send(uint16_t uip_offset, linkaddr_t *dest) {
-  struct queuebuf *q;
-
   /* Now copy fragment payload from uip_buf */
   memcpy(packetbuf_ptr + packetbuf_hdr_len,
          (uint8_t *)UIP_IP_BUF + uip_offset, packetbuf_payload_len);
   packetbuf_set_datalen(packetbuf_payload_len + packetbuf_hdr_len);
 
-  /* Backup packetbuf to queuebuf. Enables preserving attributes for all framgnets */
-  q = queuebuf_new_from_packetbuf();
-  if(q == NULL) {
-    LOG_WARN("output: could not allocate queuebuf, dropping fragment\n");
-    return 0;
-  }
-
   /* Send fragment */
   send_packet(dest);
 
-  /* Restore packetbuf from queuebuf */
-  queuebuf_to_packetbuf(q);
-  queuebuf_free(q);
-
   /* Check tx result. */
   if((last_tx_status == MAC_TX_COLLISION) ||
      (last_tx_status >= MAC_TX_ERR)) {
@@ -1614,6 +1667,9 @@ static uint8_t
 output(const linkaddr_t *localdest)
 {
   int frag_needed;
+#if SICSLOWPAN_COMPRESSION >= SICSLOWPAN_COMPRESSION_IPHC
+  int compressed;
+#endif /* SICSLOWPAN_COMPRESSION >= SICSLOWPAN_COMPRESSION_IPHC */
 
   /* The MAC address of the destination of the packet */
   linkaddr_t dest;
@@ -1682,7 +1738,10 @@ output(const linkaddr_t *localdest)
   }
 #endif /* SICSLOWPAN_COMPRESSION == SICSLOWPAN_COMPRESSION_6LORH */
 #if SICSLOWPAN_COMPRESSION >= SICSLOWPAN_COMPRESSION_IPHC
-  if(compress_hdr_iphc(&dest) == 0) {
+  PROFILE_BEGIN(iphc_probe);
+  compressed = compress_hdr_iphc(&dest);
+  PROFILE_END(iphc_probe);
+  if(compressed == 0) {
     /* Warning should already be issued by function above */
     return 0;
   }
@@ -1769,6 +1828,10 @@ output(const linkaddr_t *localdest)
     /* Set frag1 payload len. Was already caulcated earlier as frag1_payload */
     packetbuf_payload_len = frag1_payload;
 
+    /* Only the attributes need to be preserved across fragments: the
+       FRAGN headers are small enough to be rewritten for every fragment */
+    packetbuf_attr_copyto(frag_attrs, frag_addrs);
+
     /* Copy payload from uIP and send fragment */
     /* Send fragment */
     LOG_INFO("output: fragment %d/%d (tag %d, payload %d)\n",
@@ -1778,20 +1841,24 @@ output(const linkaddr_t *localdest)
       return 0;
     }
 
-    /* Now prepare for subsequent fragments. */
-
-    /* FRAGN header: tag was already set at FRAG1. Now set dispatch for all FRAGN */
-    packetbuf_hdr_len = SICSLOWPAN_FRAGN_HDR_LEN;
-    SET16(PACKETBUF_FRAG_PTR, PACKETBUF_FRAG_DISPATCH_SIZE,
-          ((SICSLOWPAN_DISPATCH_FRAGN << 8) | uip_len));
-
     /* Keep track of the total length of data sent */
     processed_ip_out_len = uncomp_hdr_len + packetbuf_payload_len;
 
     /* Create and send subsequent fragments. */
     while(processed_ip_out_len < uip_len) {
       curr_frag++;
-      /* FRAGN header: set offset for this fragment */
+
+      /* The MAC layer may have framed the previous fragment in place:
+         start over from an empty packetbuf with the saved attributes */
+      packetbuf_clear();
+      packetbuf_attr_copyfrom(frag_attrs, frag_addrs);
+      packetbuf_ptr = packetbuf_dataptr();
+
+      /* FRAGN header */
+      packetbuf_hdr_len = SICSLOWPAN_FRAGN_HDR_LEN;
+      SET16(PACKETBUF_FRAG_PTR, PACKETBUF_FRAG_DISPATCH_SIZE,
+            ((SICSLOWPAN_DISPATCH_FRAGN << 8) | uip_len));
+      SET16(PACKETBUF_FRAG_PTR, PACKETBUF_FRAG_TAG, frag_tag);
       PACKETBUF_FRAG_PTR[PACKETBUF_FRAG_OFFSET] = processed_ip_out_len >> 3;
 
       /* Calculate fragment len */
@@ -2124,6 +2191,46 @@ input(void)
 }
 /** @} */
 
+/*--------------------------------------------------------------------*/
+int
+sicslowpan_set_addr_context(uint8_t number, const uip_ipaddr_t *prefix)
+{
+#if SICSLOWPAN_COMPRESSION >= SICSLOWPAN_COMPRESSION_IPHC && \
+  SICSLOWPAN_CONF_MAX_ADDR_CONTEXTS > 0
+  struct sicslowpan_addr_context *c;
+  int i;
+
+  if(number >= 16) {
+    return 0;
+  }
+  c = contexts_by_number[number];
+  if(c == NULL && prefix != NULL) {
+    /* Take a free slot */
+    for(i = 0; i < SICSLOWPAN_CONF_MAX_ADDR_CONTEXTS; i++) {
+      if(addr_contexts[i].used != 1) {
+        c = &addr_contexts[i];
+        break;
+      }
+    }
+    if(c == NULL) {
+      return 0;
+    }
+  }
+  if(c != NULL) {
+    if(prefix != NULL) {
+      c->used = 1;
+      c->number = number;
+      memcpy(c->prefix, prefix, sizeof(c->prefix));
+    } else {
+      c->used = 0;
+    }
+    index_addr_contexts();
+  }
+  return 1;
+#else /* SICSLOWPAN_COMPRESSION >= SICSLOWPAN_COMPRESSION_IPHC ... */
+  return 0;
+#endif /* SICSLOWPAN_COMPRESSION >= SICSLOWPAN_COMPRESSION_IPHC ... */
+}
 /*--------------------------------------------------------------------*/
 /* \brief 6lowpan init function (called by the MAC layer)             */
 /*--------------------------------------------------------------------*/
@@ -2173,6 +2280,9 @@ sicslowpan_init(void)
   }
 #endif /* SICSLOWPAN_CONF_MAX_ADDR_CONTEXTS > 1 */
 
+#if SICSLOWPAN_CONF_MAX_ADDR_CONTEXTS > 0
+  index_addr_contexts();
+#endif /* SICSLOWPAN_CONF_MAX_ADDR_CONTEXTS > 0 */
 #endif /* SICSLOWPAN_COMPRESSION == SICSLOWPAN_COMPRESSION_IPHC */
 }
 /*--------------------------------------------------------------------*/
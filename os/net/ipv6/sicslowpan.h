@@ -334,5 +334,14 @@ struct sicslowpan_nh_compressor {
 
 extern const struct network_driver sicslowpan_driver;
 
+/**
+ * \brief Sets or clears an IPHC address context
+ * \param number The context identifier, 0 to 15
+ * \param prefix The address whose first 64 bits are the context prefix,
+ * or NULL to clear the context
+ * \return 1 on success, 0 if no context slot is free
+ */
+int sicslowpan_set_addr_context(uint8_t number, const uip_ipaddr_t *prefix);
+
 #endif /* SICSLOWPAN_H_ */
 /** @} */
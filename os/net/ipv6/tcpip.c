@@ -45,6 +45,7 @@
 #include "net/ipv6/uip-nd6.h"
 #include "net/ipv6/uip-ds6.h"
 #include "net/ipv6/uip-ds6-nbr.h"
+#include "net/ipv6/uip-ds6-maint.h"
 #include "net/linkaddr.h"
 #include "net/routing/routing.h"
 
@@ -410,7 +411,11 @@ eventhandler(process_event_t ev, process_data_t data)
 #endif /* !UIP_CONF_ROUTER */
     if(data == &uip_ds6_timer_periodic &&
         etimer_expired(&uip_ds6_timer_periodic)) {
+#if UIP_DS6_WITH_MAINT
+      uip_ds6_maint_run();
+#else /* UIP_DS6_WITH_MAINT */
       uip_ds6_periodic();
+#endif /* UIP_DS6_WITH_MAINT */
       tcpip_ipv6_output();
     }
   }
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * \addtogroup uip
+ * @{
+ *
+ * \file
+ *         Coalesced periodic maintenance of the IPv6 and routing tables
+ */
+
+#include "net/ipv6/uip-ds6-maint.h"
+
+#if UIP_DS6_WITH_MAINT
+
+#include "net/ipv6/uip.h"
+#include "net/ipv6/uip-ds6.h"
+#include "net/ipv6/tcpip.h"
+#include "lib/list.h"
+
+/* Log configuration */
+#include "sys/log.h"
+#define LOG_MODULE "IPv6 DS"
+#define LOG_LEVEL LOG_LEVEL_IPV6
+
+/* Clock time a is before b, across wrap-around */
+#define TIME_LT(a, b) \
+  ((clock_time_t)((a) - (b)) > ((clock_time_t)~(clock_time_t)0 >> 1))
+
+LIST(maint_tasks);
+
+struct uip_ds6_maint_stats uip_ds6_maint_stats;
+/*---------------------------------------------------------------------------*/
+static void
+schedule(void)
+{
+  uip_ds6_maint_task_t *t;
+  uip_ds6_maint_task_t *first = NULL;
+  clock_time_t now;
+
+  for(t = list_head(maint_tasks); t != NULL; t = list_item_next(t)) {
+    if(first == NULL || TIME_LT(t->deadline, first->deadline)) {
+      first = t;
+    }
+  }
+  if(first == NULL) {
+    etimer_stop(&uip_ds6_timer_periodic);
+    return;
+  }
+  now = clock_time();
+  /* The timer belongs to the tcpip process whatever the caller */
+  PROCESS_CONTEXT_BEGIN(&tcpip_process);
+  etimer_set(&uip_ds6_timer_periodic,
+             TIME_LT(now, first->deadline) ? first->deadline - now : 0);
+  /*
+   * No timer slack: the tasks already run up to UIP_DS6_MAINT_SLACK
+   * early, a late wakeup on top of that would skip periods
+   */
+  PROCESS_CONTEXT_END(&tcpip_process);
+}
+/*---------------------------------------------------------------------------*/
+void
+uip_ds6_maint_add(uip_ds6_maint_task_t *task, clock_time_t period,
+                  void (* sweep)(void), int (* pending)(void))
+{
+  task->sweep = sweep;
+  task->pending = pending;
+  task->period = period;
+  task->deadline = clock_time() + period;
+  /* list_add() first removes the task if already there */
+  list_add(maint_tasks, task);
+  schedule();
+}
+/*---------------------------------------------------------------------------*/
+void
+uip_ds6_maint_remove(uip_ds6_maint_task_t *task)
+{
+  list_remove(maint_tasks, task);
+  schedule();
+}
+/*---------------------------------------------------------------------------*/
+void
+uip_ds6_maint_run(void)
+{
+  uip_ds6_maint_task_t *t;
+  uip_ds6_maint_task_t *next;
+  clock_time_t now;
+  clock_time_t horizon;
+
+  uip_ds6_maint_stats.wakeups++;
+  now = clock_time();
+  horizon = now + UIP_DS6_MAINT_SLACK;
+
+  for(t = list_head(maint_tasks); t != NULL; t = next) {
+    /* A sweep may remove its own task */
+    next = list_item_next(t);
+    if(TIME_LT(horizon, t->deadline)) {
+      continue;
+    }
+    /* Keep the cadence of the task, unless it missed a whole period */
+    t->deadline += t->period;
+    if(TIME_LT(t->deadline, now)) {
+      t->deadline = now + t->period;
+    }
+    if(t->pending != NULL && !t->pending()) {
+      uip_ds6_maint_stats.skipped++;
+      continue;
+    }
+    uip_ds6_maint_stats.sweeps++;
+    t->sweep();
+    /* Send what the sweep left in uip_buf before the next one reuses it */
+    if(uip_len > 0) {
+      tcpip_ipv6_output();
+    }
+  }
+
+  LOG_DBG("Maintenance: %"PRIu32" wakeups, %"PRIu32" sweeps, %"PRIu32" skipped\n",
+          uip_ds6_maint_stats.wakeups, uip_ds6_maint_stats.sweeps,
+          uip_ds6_maint_stats.skipped);
+
+  schedule();
+}
+/*---------------------------------------------------------------------------*/
+#endif /* UIP_DS6_WITH_MAINT */
+/** @} */
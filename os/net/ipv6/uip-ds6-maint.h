@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * \addtogroup uip
+ * @{
+ *
+ * \file
+ *         Coalesced periodic maintenance of the IPv6 and routing tables.
+ *
+ *         Modules register their periodic sweeps as tasks. All tasks run
+ *         from a single timer of the tcpip process: a wakeup runs every
+ *         task due within UIP_DS6_MAINT_SLACK, and the timer is then set
+ *         to the earliest remaining deadline. A task whose table has
+ *         nothing that can expire is skipped.
+ */
+
+#ifndef UIP_DS6_MAINT_H
+#define UIP_DS6_MAINT_H
+
+#include "contiki.h"
+
+/** \brief Set non-zero (1) to run the uip-ds6 and RPL periodic sweeps
+ * from the coalescing maintenance scheduler */
+#ifdef UIP_DS6_CONF_WITH_MAINT
+#define UIP_DS6_WITH_MAINT UIP_DS6_CONF_WITH_MAINT
+#else
+#define UIP_DS6_WITH_MAINT 0
+#endif /* UIP_DS6_CONF_WITH_MAINT */
+
+/** \brief How early a task may run to share the wakeup of another one */
+#ifdef UIP_DS6_CONF_MAINT_SLACK
+#define UIP_DS6_MAINT_SLACK UIP_DS6_CONF_MAINT_SLACK
+#else
+#define UIP_DS6_MAINT_SLACK CLOCK_SECOND
+#endif /* UIP_DS6_CONF_MAINT_SLACK */
+
+/** \brief A periodic sweep run by the maintenance scheduler */
+typedef struct uip_ds6_maint_task {
+  struct uip_ds6_maint_task *next;
+  /** Sweeps the table */
+  void (* sweep)(void);
+  /** Returns non-zero if the table has a pending deadline; NULL if
+   * the sweep must always run */
+  int (* pending)(void);
+  clock_time_t period;
+  clock_time_t deadline;
+} uip_ds6_maint_task_t;
+
+/** \brief Counters of the maintenance scheduler */
+struct uip_ds6_maint_stats {
+  /** Timer expirations */
+  uint32_t wakeups;
+  /** Sweeps run */
+  uint32_t sweeps;
+  /** Sweeps skipped, their table had no pending deadline */
+  uint32_t skipped;
+};
+
+extern struct uip_ds6_maint_stats uip_ds6_maint_stats;
+
+/**
+ * \brief Adds a task, or restarts it if already added. The first sweep
+ * is due one period from now
+ * \param task The task
+ * \param period The period of the sweep
+ * \param sweep The sweep function
+ * \param pending The pending deadline check, or NULL
+ */
+void uip_ds6_maint_add(uip_ds6_maint_task_t *task, clock_time_t period,
+                       void (* sweep)(void), int (* pending)(void));
+
+/**
+ * \brief Removes a task
+ * \param task The task
+ */
+void uip_ds6_maint_remove(uip_ds6_maint_task_t *task);
+
+/**
+ * \brief Runs the due tasks and rearms the timer. Called by the tcpip
+ * process when uip_ds6_timer_periodic expires
+ */
+void uip_ds6_maint_run(void);
+
+#endif /* UIP_DS6_MAINT_H */
+/** @} */
@@ -114,11 +114,51 @@ MEMB(uip_ds6_nbr_memb, uip_ds6_nbr_t, UIP_DS6_NBR_MAX_NEIGHBOR_CACHES);
 NBR_TABLE(uip_ds6_nbr_t, ds6_neighbors);
 #endif /* UIP_DS6_NBR_MULTI_IPV6_ADDRS */
 
+#if UIP_DS6_NBR_WITH_HASH
+#if UIP_DS6_NBR_HASH_BUCKETS & (UIP_DS6_NBR_HASH_BUCKETS - 1)
+#error "UIP_DS6_NBR_CONF_HASH_BUCKETS must be a power of two"
+#endif
+/* Neighbor cache entries, chained by the hash of their interface identifier */
+static uip_ds6_nbr_t *nbr_hash[UIP_DS6_NBR_HASH_BUCKETS];
+/*---------------------------------------------------------------------------*/
+static uint16_t
+hash_iid(const uip_ipaddr_t *ipaddr)
+{
+  /* Addresses of a link differ mostly in the last bytes of their IID
+   * (e.g. SLAAC addresses derived from the link-layer address) */
+  uint16_t h = ipaddr->u16[4] ^ ipaddr->u16[5] ^ ipaddr->u16[6] ^ ipaddr->u16[7];
+  return (h ^ (h >> 8)) & (UIP_DS6_NBR_HASH_BUCKETS - 1);
+}
+/*---------------------------------------------------------------------------*/
+static void
+hash_add(uip_ds6_nbr_t *nbr)
+{
+  uint16_t bucket = hash_iid(&nbr->ipaddr);
+  nbr->hash_next = nbr_hash[bucket];
+  nbr_hash[bucket] = nbr;
+}
+/*---------------------------------------------------------------------------*/
+static void
+hash_remove(uip_ds6_nbr_t *nbr)
+{
+  uip_ds6_nbr_t **pp;
+  for(pp = &nbr_hash[hash_iid(&nbr->ipaddr)]; *pp != NULL; pp = &(*pp)->hash_next) {
+    if(*pp == nbr) {
+      *pp = nbr->hash_next;
+      return;
+    }
+  }
+}
+#endif /* UIP_DS6_NBR_WITH_HASH */
+
 /*---------------------------------------------------------------------------*/
 void
 uip_ds6_neighbors_init(void)
 {
   link_stats_init();
+#if UIP_DS6_NBR_WITH_HASH
+  memset(nbr_hash, 0, sizeof(nbr_hash));
+#endif /* UIP_DS6_NBR_WITH_HASH */
 #if UIP_DS6_NBR_MULTI_IPV6_ADDRS
   memb_init(&uip_ds6_nbr_memb);
   nbr_table_register(uip_ds6_nbr_entries,
@@ -187,6 +227,14 @@ uip_ds6_nbr_add(const uip_ipaddr_t *ipaddr, const uip_lladdr_t *lladdr,
     add_uip_ds6_nbr_to_nbr_entry(nbr, nbr_entry);
   }
 #else
+#if UIP_DS6_NBR_WITH_HASH
+  /* The entry of a known link-layer address is reused for the new IPv6
+   * address: unlink it while its old address still gives its bucket */
+  nbr = nbr_table_get_from_lladdr(ds6_neighbors, (const linkaddr_t *)lladdr);
+  if(nbr != NULL) {
+    hash_remove(nbr);
+  }
+#endif /* UIP_DS6_NBR_WITH_HASH */
   nbr = nbr_table_add_lladdr(ds6_neighbors, (linkaddr_t*)lladdr, reason, data);
 #endif /* UIP_DS6_NBR_MULTI_IPV6_ADDRS */
 
@@ -195,6 +243,9 @@ uip_ds6_nbr_add(const uip_ipaddr_t *ipaddr, const uip_lladdr_t *lladdr,
     NETSTACK_CONF_DS6_NEIGHBOR_UPDATED_CALLBACK((const linkaddr_t *)lladdr, 1);
 #endif /* NETSTACK_CONF_DS6_NEIGHBOR_ADDED_CALLBACK */
     uip_ipaddr_copy(&nbr->ipaddr, ipaddr);
+#if UIP_DS6_NBR_WITH_HASH
+    hash_add(nbr);
+#endif /* UIP_DS6_NBR_WITH_HASH */
 #if UIP_ND6_SEND_RA || !UIP_CONF_ROUTER
     nbr->isrouter = isrouter;
 #endif /* UIP_ND6_SEND_RA || !UIP_CONF_ROUTER */
@@ -272,6 +323,9 @@ free_uip_ds6_nbr(uip_ds6_nbr_t *nbr)
 #if UIP_CONF_IPV6_QUEUE_PKT
   uip_packetqueue_free(&nbr->packethandle);
 #endif /* UIP_CONF_IPV6_QUEUE_PKT */
+#if UIP_DS6_NBR_WITH_HASH
+  hash_remove(nbr);
+#endif /* UIP_DS6_NBR_WITH_HASH */
   NETSTACK_ROUTING.neighbor_state_changed(nbr);
   assert(nbr->nbr_entry != NULL);
   if(nbr->nbr_entry == NULL) {
@@ -330,6 +384,9 @@ uip_ds6_nbr_rm(uip_ds6_nbr_t *nbr)
 #if UIP_CONF_IPV6_QUEUE_PKT
   uip_packetqueue_free(&nbr->packethandle);
 #endif /* UIP_CONF_IPV6_QUEUE_PKT */
+#if UIP_DS6_NBR_WITH_HASH
+  hash_remove(nbr);
+#endif /* UIP_DS6_NBR_WITH_HASH */
 
   NETSTACK_ROUTING.neighbor_state_changed(nbr);
   ret = nbr_table_remove(ds6_neighbors, nbr);
@@ -405,7 +462,14 @@ uip_ds6_nbr_update_ll(uip_ds6_nbr_t **nbr_pp, const uip_lladdr_t *new_ll_addr)
     LOG_ERR("%s: cannot allocate a new nbr for new_ll_addr\n", __func__);
     return -1;
   }
+#if UIP_DS6_NBR_WITH_HASH
+  /* The backup carries a stale chain pointer */
+  hash_remove(*nbr_pp);
   memcpy(*nbr_pp, &nbr_backup, sizeof(uip_ds6_nbr_t));
+  hash_add(*nbr_pp);
+#else /* UIP_DS6_NBR_WITH_HASH */
+  memcpy(*nbr_pp, &nbr_backup, sizeof(uip_ds6_nbr_t));
+#endif /* UIP_DS6_NBR_WITH_HASH */
 #endif /* UIP_DS6_NBR_MULTI_IPV6_ADDRS */
 
   return 0;
@@ -500,11 +564,19 @@ uip_ds6_nbr_lookup(const uip_ipaddr_t *ipaddr)
   if(ipaddr == NULL) {
     return NULL;
   }
+#if UIP_DS6_NBR_WITH_HASH
+  for(nbr = nbr_hash[hash_iid(ipaddr)]; nbr != NULL; nbr = nbr->hash_next) {
+    if(uip_ipaddr_cmp(&nbr->ipaddr, ipaddr)) {
+      return nbr;
+    }
+  }
+#else /* UIP_DS6_NBR_WITH_HASH */
   for(nbr = uip_ds6_nbr_head(); nbr != NULL; nbr = uip_ds6_nbr_next(nbr)) {
     if(uip_ipaddr_cmp(&nbr->ipaddr, ipaddr)) {
       return nbr;
     }
   }
+#endif /* UIP_DS6_NBR_WITH_HASH */
   return NULL;
 }
 /*---------------------------------------------------------------------------*/
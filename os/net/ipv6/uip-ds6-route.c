@@ -74,17 +74,29 @@ void NETSTACK_CONF_ROUTING_NEIGHBOR_REMOVED_CALLBACK(const linkaddr_t *addr);
    so that it will be maintained along with the rest of the neighbor
    tables in the system. */
 NBR_TABLE_GLOBAL(struct uip_ds6_route_neighbor_routes, nbr_routes);
-MEMB(neighborroutememb, struct uip_ds6_route_neighbor_route, UIP_DS6_ROUTE_NB);
+MEMB_FREE_LIST(neighborroutememb, struct uip_ds6_route_neighbor_route, UIP_DS6_ROUTE_NB);
 
 /* Each route is repressented by a uip_ds6_route_t structure and
    memory for each route is allocated from the routememb memory
    block. These routes are maintained on the routelist. */
 LIST(routelist);
-MEMB(routememb, uip_ds6_route_t, UIP_DS6_ROUTE_NB);
+MEMB_FREE_LIST(routememb, uip_ds6_route_t, UIP_DS6_ROUTE_NB);
 
 static int num_routes = 0;
 static void rm_routelist_callback(nbr_table_item_t *ptr);
 
+#if UIP_DS6_ROUTE_WITH_HASH
+#if UIP_DS6_ROUTE_HASH_BUCKETS & (UIP_DS6_ROUTE_HASH_BUCKETS - 1)
+#error "UIP_DS6_ROUTE_CONF_HASH_BUCKETS must be a power of two"
+#endif
+/* /128 routes, chained by the hash of their interface identifier */
+static uip_ds6_route_t *route_hash[UIP_DS6_ROUTE_HASH_BUCKETS];
+/* Routes shorter than /128, chained through hash_next */
+static uip_ds6_route_t *prefix_routes;
+/* Stamp of the last lookup, used in place of the list order for LRU */
+static uint32_t route_use_count;
+#endif /* UIP_DS6_ROUTE_WITH_HASH */
+
 #endif /* (UIP_MAX_ROUTES != 0) */
 
 /* Default routes are held on the defaultrouterlist and their
@@ -161,6 +173,41 @@ uip_ds6_notification_rm(struct uip_ds6_notification *n)
   list_remove(notificationlist, n);
 }
 #endif
+#if (UIP_MAX_ROUTES != 0) && UIP_DS6_ROUTE_WITH_HASH
+/*---------------------------------------------------------------------------*/
+static uip_ds6_route_t **
+hash_head(const uip_ds6_route_t *r)
+{
+  uint16_t h;
+
+  if(r->length < 128) {
+    return &prefix_routes;
+  }
+  /* Host routes under a common prefix differ in their IID only */
+  h = r->ipaddr.u16[4] ^ r->ipaddr.u16[5] ^ r->ipaddr.u16[6] ^ r->ipaddr.u16[7];
+  return &route_hash[(h ^ (h >> 8)) & (UIP_DS6_ROUTE_HASH_BUCKETS - 1)];
+}
+/*---------------------------------------------------------------------------*/
+static void
+hash_add(uip_ds6_route_t *r)
+{
+  uip_ds6_route_t **head = hash_head(r);
+  r->hash_next = *head;
+  *head = r;
+}
+/*---------------------------------------------------------------------------*/
+static void
+hash_remove(uip_ds6_route_t *r)
+{
+  uip_ds6_route_t **pp;
+  for(pp = hash_head(r); *pp != NULL; pp = &(*pp)->hash_next) {
+    if(*pp == r) {
+      *pp = r->hash_next;
+      return;
+    }
+  }
+}
+#endif /* (UIP_MAX_ROUTES != 0) && UIP_DS6_ROUTE_WITH_HASH */
 /*---------------------------------------------------------------------------*/
 void
 uip_ds6_route_init(void)
@@ -168,6 +215,11 @@ uip_ds6_route_init(void)
 #if (UIP_MAX_ROUTES != 0)
   memb_init(&routememb);
   list_init(routelist);
+#if UIP_DS6_ROUTE_WITH_HASH
+  memset(route_hash, 0, sizeof(route_hash));
+  prefix_routes = NULL;
+  route_use_count = 0;
+#endif /* UIP_DS6_ROUTE_WITH_HASH */
   nbr_table_register(nbr_routes,
                      (nbr_table_callback *)rm_routelist_callback);
 #endif /* (UIP_MAX_ROUTES != 0) */
@@ -289,6 +341,29 @@ uip_ds6_route_lookup(const uip_ipaddr_t *addr)
 
   found_route = NULL;
   longestmatch = 0;
+#if UIP_DS6_ROUTE_WITH_HASH
+  {
+    /* A matching host route is always the longest match */
+    uip_ds6_route_t key;
+    key.length = 128;
+    uip_ipaddr_copy(&key.ipaddr, addr);
+    for(r = *hash_head(&key); r != NULL; r = r->hash_next) {
+      if(uip_ipaddr_cmp(addr, &r->ipaddr)) {
+        found_route = r;
+        break;
+      }
+    }
+  }
+  if(found_route == NULL) {
+    for(r = prefix_routes; r != NULL; r = r->hash_next) {
+      if(r->length >= longestmatch &&
+         uip_ipaddr_prefixcmp(addr, &r->ipaddr, r->length)) {
+        longestmatch = r->length;
+        found_route = r;
+      }
+    }
+  }
+#else /* UIP_DS6_ROUTE_WITH_HASH */
   for(r = uip_ds6_route_head();
       r != NULL;
       r = uip_ds6_route_next(r)) {
@@ -302,6 +377,7 @@ uip_ds6_route_lookup(const uip_ipaddr_t *addr)
       }
     }
   }
+#endif /* UIP_DS6_ROUTE_WITH_HASH */
 
   if(found_route != NULL) {
     LOG_INFO("Found route: ");
@@ -313,6 +389,14 @@ uip_ds6_route_lookup(const uip_ipaddr_t *addr)
     LOG_INFO("No route found\n");
   }
 
+#if UIP_DS6_ROUTE_WITH_HASH
+  if(found_route != NULL) {
+    /* Moving the route in the list would cost a walk of the list;
+       stamp it instead, the least recently used route has the
+       oldest stamp. */
+    found_route->last_used = ++route_use_count;
+  }
+#else /* UIP_DS6_ROUTE_WITH_HASH */
   if(found_route != NULL && found_route != list_head(routelist)) {
     /* If we found a route, we put it at the start of the routeslist
        list. The list is ordered by how recently we looked them up:
@@ -322,6 +406,7 @@ uip_ds6_route_lookup(const uip_ipaddr_t *addr)
     list_remove(routelist, found_route);
     list_push(routelist, found_route);
   }
+#endif /* UIP_DS6_ROUTE_WITH_HASH */
 
   return found_route;
 #else /* (UIP_MAX_ROUTES != 0) */
@@ -383,7 +468,19 @@ uip_ds6_route_add(const uip_ipaddr_t *ipaddr, uint8_t length,
 #if UIP_DS6_ROUTE_REMOVE_LEAST_RECENTLY_USED
       /* Removing the oldest route entry from the route table. The
          least recently used route is the first route on the list. */
+#if UIP_DS6_ROUTE_WITH_HASH
+      {
+        uip_ds6_route_t *r2;
+        oldest = list_head(routelist);
+        for(r2 = oldest; r2 != NULL; r2 = list_item_next(r2)) {
+          if((int32_t)(r2->last_used - oldest->last_used) < 0) {
+            oldest = r2;
+          }
+        }
+      }
+#else /* UIP_DS6_ROUTE_WITH_HASH */
       oldest = list_tail(routelist);
+#endif /* UIP_DS6_ROUTE_WITH_HASH */
 #endif
       if(oldest == NULL) {
         return NULL;
@@ -446,6 +543,7 @@ uip_ds6_route_add(const uip_ipaddr_t *ipaddr, uint8_t length,
       /* This should not happen, as we explicitly deallocated one
          route table entry above. */
       LOG_ERR("Add: could not allocate neighbor route list entry\n");
+      list_remove(routelist, r);
       memb_free(&routememb, r);
       return NULL;
     }
@@ -464,6 +562,10 @@ uip_ds6_route_add(const uip_ipaddr_t *ipaddr, uint8_t length,
 
   uip_ipaddr_copy(&(r->ipaddr), ipaddr);
   r->length = length;
+#if UIP_DS6_ROUTE_WITH_HASH
+  r->last_used = ++route_use_count;
+  hash_add(r);
+#endif /* UIP_DS6_ROUTE_WITH_HASH */
 
 #ifdef UIP_DS6_ROUTE_STATE_TYPE
   memset(&r->state, 0, sizeof(UIP_DS6_ROUTE_STATE_TYPE));
@@ -509,6 +611,9 @@ uip_ds6_route_rm(uip_ds6_route_t *route)
 
     /* Remove the route from the route list */
     list_remove(routelist, route);
+#if UIP_DS6_ROUTE_WITH_HASH
+    hash_remove(route);
+#endif /* UIP_DS6_ROUTE_WITH_HASH */
 
     /* Find the corresponding neighbor_route and remove it. */
     for(neighbor_route = list_head(route->neighbor_routes->route_list);
@@ -537,9 +642,6 @@ uip_ds6_route_rm(uip_ds6_route_t *route)
           (const linkaddr_t *)nbr_table_get_lladdr(nbr_routes, route->neighbor_routes->route_list));
 #endif
     }
-    memb_free(&routememb, route);
-    memb_free(&neighborroutememb, neighbor_route);
-
     num_routes--;
 
     LOG_INFO("Rm: num %d\n", num_routes);
@@ -548,6 +650,10 @@ uip_ds6_route_rm(uip_ds6_route_t *route)
     call_route_callback(UIP_DS6_NOTIFICATION_ROUTE_RM,
         &route->ipaddr, uip_ds6_route_nexthop(route));
 #endif
+
+    /* Freed last, as a free-list memb reuses the blocks' first bytes */
+    memb_free(&routememb, route);
+    memb_free(&neighborroutememb, neighbor_route);
   }
 
   if(LOG_DBG_ENABLED) {
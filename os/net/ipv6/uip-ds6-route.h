@@ -111,6 +111,24 @@ void uip_ds6_notification_rm(struct uip_ds6_notification *n);
 #define UIP_DS6_ROUTE_NB 4
 #endif /* UIP_MAX_ROUTES */
 
+/** \brief Set non-zero (1) to index the routing table instead of
+ *  scanning it: /128 host routes are hashed on their interface
+ *  identifier and only the shorter prefixes are searched linearly.
+ *  Routes are then evicted by a use stamp rather than by list order */
+#ifdef UIP_DS6_ROUTE_CONF_WITH_HASH
+#define UIP_DS6_ROUTE_WITH_HASH UIP_DS6_ROUTE_CONF_WITH_HASH
+#else
+#define UIP_DS6_ROUTE_WITH_HASH 0
+#endif /* UIP_DS6_ROUTE_CONF_WITH_HASH */
+
+/** \brief Set the number of buckets of the host route index (a power
+ *  of two) */
+#ifdef UIP_DS6_ROUTE_CONF_HASH_BUCKETS
+#define UIP_DS6_ROUTE_HASH_BUCKETS UIP_DS6_ROUTE_CONF_HASH_BUCKETS
+#else
+#define UIP_DS6_ROUTE_HASH_BUCKETS 16
+#endif /* UIP_DS6_ROUTE_CONF_HASH_BUCKETS */
+
 /** \brief define some additional RPL related route state and
  *  neighbor callback for RPL - if not a DS6_ROUTE_STATE is already set */
 #ifndef UIP_DS6_ROUTE_STATE_TYPE
@@ -176,6 +194,11 @@ typedef struct uip_ds6_route {
      belong to the neighbor table entry that this routing table entry
      uses. */
   struct uip_ds6_route_neighbor_routes *neighbor_routes;
+#if UIP_DS6_ROUTE_WITH_HASH
+  /* Next host route in the same bucket, or next prefix route */
+  struct uip_ds6_route *hash_next;
+  uint32_t last_used;
+#endif /* UIP_DS6_ROUTE_WITH_HASH */
   uip_ipaddr_t ipaddr;
 #ifdef UIP_DS6_ROUTE_STATE_TYPE
   UIP_DS6_ROUTE_STATE_TYPE state;
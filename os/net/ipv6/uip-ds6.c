@@ -51,6 +51,7 @@
 #include "net/ipv6/uip-ds6.h"
 #include "net/ipv6/multicast/uip-mcast6.h"
 #include "net/ipv6/uip-packetqueue.h"
+#include "net/ipv6/uip-ds6-maint.h"
 
 /* Log configuration */
 #include "sys/log.h"
@@ -59,6 +60,14 @@
 
 struct etimer uip_ds6_timer_periodic;                           /**< Timer for maintenance of data structures */
 
+#if UIP_DS6_WITH_MAINT
+static uip_ds6_maint_task_t ds6_task;
+static uip_ds6_maint_task_t defrt_task;
+#if UIP_ND6_SEND_NS
+static uip_ds6_maint_task_t nbr_task;
+#endif /* UIP_ND6_SEND_NS */
+#endif /* UIP_DS6_WITH_MAINT */
+
 #if UIP_CONF_ROUTER
 struct stimer uip_ds6_timer_ra;                                 /**< RA timer, to schedule RA sending */
 #if UIP_ND6_SEND_RA
@@ -99,6 +108,31 @@ static const uint8_t iid_prefix[] = { 0x00, 0x00 , 0x00 , 0xff , 0xfe , 0x00 };
 static uip_ip6addr_t default_prefix = {
     .u16 = { 0, 0, 0, 0, 0, 0, 0, 0 }
 };
+
+#if UIP_DS6_SRC_CACHE_SIZE
+/* Source addresses selected for recent global destinations. An entry
+ * matches the destinations sharing its first length bits: 64 when the
+ * selection could not depend on the IID, 128 otherwise. */
+static struct {
+  uip_ipaddr_t dst;
+  uint8_t length;
+  uip_ds6_addr_t *src;
+} src_cache[UIP_DS6_SRC_CACHE_SIZE];
+static uint8_t src_cache_next;
+/*---------------------------------------------------------------------------*/
+/* Flushes the cache, on any change of the addresses or of their state */
+static void
+src_cache_flush(void)
+{
+  uint8_t i;
+  for(i = 0; i < UIP_DS6_SRC_CACHE_SIZE; i++) {
+    src_cache[i].length = 0;
+  }
+}
+#define SRC_CACHE_FLUSH() src_cache_flush()
+#else /* UIP_DS6_SRC_CACHE_SIZE */
+#define SRC_CACHE_FLUSH()
+#endif /* UIP_DS6_SRC_CACHE_SIZE */
 /*---------------------------------------------------------------------------*/
 const uip_ip6addr_t *
 uip_ds6_default_prefix()
@@ -111,6 +145,28 @@ uip_ds6_set_default_prefix(const uip_ip6addr_t *prefix)
 {
   uip_ip6addr_copy(&default_prefix, prefix);
 }
+#if UIP_DS6_WITH_MAINT
+/*---------------------------------------------------------------------------*/
+static int
+defrt_pending(void)
+{
+  uip_ds6_defrt_t *d;
+  for(d = uip_ds6_defrt_head(); d != NULL; d = list_item_next(d)) {
+    if(!d->isinfinite) {
+      return 1;
+    }
+  }
+  return 0;
+}
+#if UIP_ND6_SEND_NS
+/*---------------------------------------------------------------------------*/
+static int
+nbr_pending(void)
+{
+  return uip_ds6_nbr_head() != NULL;
+}
+#endif /* UIP_ND6_SEND_NS */
+#endif /* UIP_DS6_WITH_MAINT */
 /*---------------------------------------------------------------------------*/
 void
 uip_ds6_init(void)
@@ -166,7 +222,19 @@ uip_ds6_init(void)
              random_rand() % (UIP_ND6_MAX_RTR_SOLICITATION_DELAY *
                               CLOCK_SECOND));
 #endif /* UIP_CONF_ROUTER */
+#if UIP_DS6_WITH_MAINT
+  uip_ds6_maint_add(&ds6_task, UIP_DS6_PERIOD, uip_ds6_periodic, NULL);
+  uip_ds6_maint_add(&defrt_task, UIP_DS6_PERIOD, uip_ds6_defrt_periodic,
+                    defrt_pending);
+#if UIP_ND6_SEND_NS
+  uip_ds6_maint_add(&nbr_task, UIP_DS6_PERIOD, uip_ds6_neighbor_periodic,
+                    nbr_pending);
+#endif /* UIP_ND6_SEND_NS */
+#else /* UIP_DS6_WITH_MAINT */
   etimer_set(&uip_ds6_timer_periodic, UIP_DS6_PERIOD);
+  etimer_set_slack(&uip_ds6_timer_periodic,
+                   ETIMER_PERIODIC_SLACK(UIP_DS6_PERIOD));
+#endif /* UIP_DS6_WITH_MAINT */
 
   return;
 }
@@ -194,8 +262,10 @@ uip_ds6_periodic(void)
     }
   }
 
+#if !UIP_DS6_WITH_MAINT
   /* Periodic processing on default routers */
   uip_ds6_defrt_periodic();
+#endif /* !UIP_DS6_WITH_MAINT */
   /*  for(locdefrt = uip_ds6_defrt_list;
       locdefrt < uip_ds6_defrt_list + UIP_DS6_DEFRT_NB; locdefrt++) {
     if((locdefrt->isused) && (!locdefrt->isinfinite) &&
@@ -216,9 +286,9 @@ uip_ds6_periodic(void)
   }
 #endif /* !UIP_CONF_ROUTER */
 
-#if UIP_ND6_SEND_NS
+#if UIP_ND6_SEND_NS && !UIP_DS6_WITH_MAINT
   uip_ds6_neighbor_periodic();
-#endif /* UIP_ND6_SEND_NS */
+#endif /* UIP_ND6_SEND_NS && !UIP_DS6_WITH_MAINT */
 
 #if UIP_CONF_ROUTER && UIP_ND6_SEND_RA
   /* Periodic RA sending */
@@ -226,7 +296,9 @@ uip_ds6_periodic(void)
     uip_ds6_send_ra_periodic();
   }
 #endif /* UIP_CONF_ROUTER && UIP_ND6_SEND_RA */
+#if !UIP_DS6_WITH_MAINT
   etimer_reset(&uip_ds6_timer_periodic);
+#endif /* !UIP_DS6_WITH_MAINT */
   return;
 }
 
@@ -383,6 +455,7 @@ uip_ds6_addr_add(uip_ipaddr_t *ipaddr, unsigned long vlifetime, uint8_t type)
 #endif /* UIP_ND6_DEF_MAXDADNS > 0 */
     uip_create_solicited_node(ipaddr, &loc_fipaddr);
     uip_ds6_maddr_add(&loc_fipaddr);
+    SRC_CACHE_FLUSH();
     return locaddr;
   }
   return NULL;
@@ -398,6 +471,7 @@ uip_ds6_addr_rm(uip_ds6_addr_t *addr)
       uip_ds6_maddr_rm(locmaddr);
     }
     addr->isused = 0;
+    SRC_CACHE_FLUSH();
   }
   return;
 }
@@ -542,6 +616,16 @@ uip_ds6_select_src(uip_ipaddr_t *src, uip_ipaddr_t *dst)
   uip_ds6_addr_t *matchaddr = NULL;
 
   if(!uip_is_addr_linklocal(dst) && !uip_is_addr_mcast(dst)) {
+#if UIP_DS6_SRC_CACHE_SIZE
+    uint8_t i;
+    for(i = 0; i < UIP_DS6_SRC_CACHE_SIZE; i++) {
+      if(src_cache[i].length != 0 &&
+         uip_ipaddr_prefixcmp(dst, &src_cache[i].dst, src_cache[i].length)) {
+        matchaddr = src_cache[i].src;
+        goto selected;
+      }
+    }
+#endif /* UIP_DS6_SRC_CACHE_SIZE */
     /* find longest match */
     for(locaddr = uip_ds6_if.addr_list;
         locaddr < uip_ds6_if.addr_list + UIP_DS6_ADDR_NB; locaddr++) {
@@ -555,6 +639,13 @@ uip_ds6_select_src(uip_ipaddr_t *src, uip_ipaddr_t *dst)
         }
       }
     }
+#if UIP_DS6_SRC_CACHE_SIZE
+    /* Below 64 bits, no candidate shares more than the prefix of dst */
+    uip_ipaddr_copy(&src_cache[src_cache_next].dst, dst);
+    src_cache[src_cache_next].length = best < 64 ? 64 : 128;
+    src_cache[src_cache_next].src = matchaddr;
+    src_cache_next = (src_cache_next + 1) % UIP_DS6_SRC_CACHE_SIZE;
+#endif /* UIP_DS6_SRC_CACHE_SIZE */
 #if UIP_IPV6_MULTICAST
   } else if(uip_is_addr_mcast_routable(dst)) {
     matchaddr = uip_ds6_get_global(ADDR_PREFERRED);
@@ -563,6 +654,9 @@ uip_ds6_select_src(uip_ipaddr_t *src, uip_ipaddr_t *dst)
     matchaddr = uip_ds6_get_link_local(ADDR_PREFERRED);
   }
 
+#if UIP_DS6_SRC_CACHE_SIZE
+selected:
+#endif /* UIP_DS6_SRC_CACHE_SIZE */
   /* use the :: (unspecified address) as source if no match found */
   if(matchaddr == NULL) {
     uip_create_unspecified(src);
@@ -654,6 +748,7 @@ uip_ds6_dad(uip_ds6_addr_t *addr)
   LOG_INFO_("\n");
 
   addr->state = ADDR_PREFERRED;
+  SRC_CACHE_FLUSH();
   return;
 }
 
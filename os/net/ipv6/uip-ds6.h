@@ -171,6 +171,14 @@
 #define UIP_DS6_PERIOD UIP_DS6_CONF_PERIOD
 #endif
 
+/** Number of destinations whose selected source address is cached
+ *  (0 disables the cache) */
+#ifndef UIP_DS6_CONF_SRC_CACHE_SIZE
+#define UIP_DS6_SRC_CACHE_SIZE 4
+#else
+#define UIP_DS6_SRC_CACHE_SIZE UIP_DS6_CONF_SRC_CACHE_SIZE
+#endif
+
 #define FOUND 0
 #define FREESPACE 1
 #define NOSPACE 2
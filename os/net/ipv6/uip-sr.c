@@ -45,6 +45,7 @@
 #include "net/routing/routing.h"
 #include "lib/list.h"
 #include "lib/memb.h"
+#include "sys/profile.h"
 
 /* Log configuration */
 #include "sys/log.h"
@@ -56,7 +57,9 @@ static int num_nodes;
 
 /* Every known node in the network */
 LIST(nodelist);
-MEMB(nodememb, uip_sr_node_t, UIP_SR_LINK_NUM);
+MEMB_FREE_LIST(nodememb, uip_sr_node_t, UIP_SR_LINK_NUM);
+
+PROFILE_PROBE(get_node_probe, "uip_sr_get_node");
 
 /*---------------------------------------------------------------------------*/
 int
@@ -82,13 +85,15 @@ uip_sr_node_t *
 uip_sr_get_node(const void *graph, const uip_ipaddr_t *addr)
 {
   uip_sr_node_t *l;
+  PROFILE_BEGIN(get_node_probe);
   for(l = list_head(nodelist); l != NULL; l = list_item_next(l)) {
     /* Compare prefix and node identifier */
     if(node_matches_address(graph, l, addr)) {
-      return l;
+      break;
     }
   }
-  return NULL;
+  PROFILE_END(get_node_probe);
+  return l;
 }
 /*---------------------------------------------------------------------------*/
 int
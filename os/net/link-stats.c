@@ -81,6 +81,10 @@ NBR_TABLE(struct link_stats, link_stats);
 /* Called at a period of FRESHNESS_HALF_LIFE */
 struct ctimer periodic_timer;
 
+/* Neighborhood churn counters */
+static uint16_t new_neighbor_count;
+static uint16_t falling_link_count;
+
 /*---------------------------------------------------------------------------*/
 /* Returns the neighbor's link stats */
 const struct link_stats *
@@ -175,9 +179,11 @@ guess_etx_from_rssi(const struct link_stats *stats)
 }
 #endif /* LINK_STATS_INIT_ETX_FROM_RSSI */
 /*---------------------------------------------------------------------------*/
-/* Initialize rssi values from link_stats stats */
+/* Initialize rssi values from link_stats stats. Called for every new neighbor. */
 static void initialize_rssi_stats(struct link_stats *stats)
 {
+  new_neighbor_count++;
+
   for(uint8_t i = 0; i < LINK_STATS_RSSI_ARR_LEN; i++) {
     stats->rssi[i] = fix16_from_int(LINK_STATS_RSSI_UNKNOWN);
     stats->rx_time[i] = 0;
@@ -287,33 +293,44 @@ link_stats_packet_sent(const linkaddr_t *lladdr, int status, int numtx)
 #endif /* LINK_STATS_ETX_FROM_PACKET_COUNT */
 }
 /*---------------------------------------------------------------------------*/
-/* Packet input callback. Updates statistics for receptions on a given link */
-void
-link_stats_input_callback(const linkaddr_t *lladdr)
+/* Returns the link stats of a neighbor, adding it if needed */
+static struct link_stats *
+get_or_add(const linkaddr_t *lladdr)
 {
   struct link_stats *stats;
-  int16_t packet_rssi = packetbuf_attr(PACKETBUF_ATTR_RSSI);
 
   stats = nbr_table_get_from_lladdr(link_stats, lladdr);
   if(stats == NULL) {
     /* Add the neighbor */
     stats = nbr_table_add_lladdr(link_stats, lladdr, NBR_TABLE_REASON_LINK_STATS, NULL);
     if(stats == NULL) {
-      return; /* No space left, return */
+      return NULL; /* No space left, return */
     }
     initialize_rssi_stats(stats);
   }
-
+  return stats;
+}
+/*---------------------------------------------------------------------------*/
+/* Adds an RSSI sample observed at last_rx_time */
+static void
+update_rssi(struct link_stats *stats, const linkaddr_t *lladdr,
+            int16_t packet_rssi, clock_time_t last_rx_time)
+{
   if(stats->rssi[0] == fix16_from_int(LINK_STATS_RSSI_UNKNOWN)) {
     /* Update last Rx timestamp */
-    stats->rx_time[0] = clock_time();
+    stats->rx_time[0] = last_rx_time;
 
     /* Initialize RSSI */
     stats->rssi[0] = fix16_from_int(packet_rssi);
   } else {
 #if RPL_DAG_MC == RPL_DAG_MC_SSV
     fix16_t last_rssi;
-    clock_time_t last_rx_time = clock_time();
+    if(last_rx_time < stats->rx_time[0]) {
+      /* Reported out of order, e.g. the ACK of a TSCH transmission that is
+         processed after a later reception: PMAOF would see a negative
+         interval between the samples, so drop it */
+      return;
+    }
 #if LINK_STATS_RSSI_WITH_EMANEXT
     /* Update last RSSI sample using EMAnext. */
     fix16_t diff_s_fix16 = get_seconds_from_ticks(last_rx_time - stats->rx_time[0], CLOCK_SECOND);
@@ -324,7 +341,11 @@ link_stats_input_callback(const linkaddr_t *lladdr)
     last_rssi = fix16_div(fix16_add(stats->rssi[0] * (EWMA_SCALE - EWMA_ALPHA),
                        fix16_from_int(packet_rssi * EWMA_ALPHA)), fix16_from_int(EWMA_SCALE)); // If alpha == 100: no memory
 #endif
-    if(last_rx_time - stats->rx_time[0] >= STATIC_DET_TIME_THRESH ||
+    if(last_rx_time == stats->rx_time[0]) {
+      /* Within the same clock tick as the last sample: fold it in rather
+         than giving PMAOF a null interval */
+      stats->rssi[0] = last_rssi;
+    } else if(last_rx_time - stats->rx_time[0] >= STATIC_DET_TIME_THRESH ||
        fix_abs(fix16_sub(last_rssi, stats->rssi[0])) >= fix16_from_float(STATIC_DET_RSSI_THRESH)) {
       /* Update RSSI and Rx timestamp arrays */
       for(uint8_t i = (LINK_STATS_RSSI_ARR_LEN - 1); i > 0; i--) {
@@ -347,6 +368,25 @@ link_stats_input_callback(const linkaddr_t *lladdr)
   }
 
   stats->link_stats_metric_updated |= 0x0f;
+}
+/*---------------------------------------------------------------------------*/
+/* Packet input callback. Updates statistics for receptions on a given link */
+void
+link_stats_input_callback(const linkaddr_t *lladdr)
+{
+  struct link_stats *stats;
+  clock_time_t rx_time = clock_time();
+
+  stats = get_or_add(lladdr);
+  if(stats == NULL) {
+    return;
+  }
+
+#if MAC_CONF_WITH_TSCH
+  /* The packet was received in an earlier slot */
+  rx_time -= MIN(packetbuf_attr(PACKETBUF_ATTR_RX_AGE), rx_time);
+#endif /* MAC_CONF_WITH_TSCH */
+  update_rssi(stats, lladdr, packetbuf_attr(PACKETBUF_ATTR_RSSI), rx_time);
 
   stats->failed_probes = 0;
 
@@ -364,6 +404,16 @@ link_stats_input_callback(const linkaddr_t *lladdr)
 #endif
 }
 /*---------------------------------------------------------------------------*/
+/* RSSI sample callback. Updates the RSSI of a given link */
+void
+link_stats_rssi_callback(const linkaddr_t *lladdr, int16_t rssi, clock_time_t rx_time)
+{
+  struct link_stats *stats = get_or_add(lladdr);
+  if(stats != NULL) {
+    update_rssi(stats, lladdr, rssi, rx_time);
+  }
+}
+/*---------------------------------------------------------------------------*/
 #if LINK_STATS_PACKET_COUNTERS
 /*---------------------------------------------------------------------------*/
 static void
@@ -426,6 +476,7 @@ link_stats_init(void)
 {
   nbr_table_register(link_stats, NULL);
   ctimer_set(&periodic_timer, FRESHNESS_HALF_LIFE, periodic, NULL);
+  ctimer_set_slack(&periodic_timer, ETIMER_PERIODIC_SLACK(FRESHNESS_HALF_LIFE));
 }
 /*---------------------------------------------------------------------------*/
 /* Update OF link metric */
@@ -439,9 +490,24 @@ link_stats_metric_update_callback(const linkaddr_t *lladdr, fix16_t ssv, fix16_t
     stats->last_ssr = ssr;
     stats->last_rx_time = rx_time;
     stats->link_stats_metric_updated = 0;
+    if(ssv != fix16_minimum && fix16_to_int(ssv) < LINK_STATS_FALLING_SSV) {
+      falling_link_count++;
+    }
   }
 }
 /*---------------------------------------------------------------------------*/
+uint16_t
+link_stats_new_neighbor_count(void)
+{
+  return new_neighbor_count;
+}
+/*---------------------------------------------------------------------------*/
+uint16_t
+link_stats_falling_link_count(void)
+{
+  return falling_link_count;
+}
+/*---------------------------------------------------------------------------*/
 /* Update probe time */
 void
 link_stats_probe_callback(const linkaddr_t *lladdr, clock_time_t probe_time)
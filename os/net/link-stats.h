@@ -126,6 +126,14 @@
 #define LINK_STATS_ETX_WITH_EMANEXT                0
 #endif /* LINK_STATS_ETX_WITH_EMANEXT */
 
+/* SSV below which a metric update counts as a falling link, see
+ * link_stats_falling_link_count() */
+#ifdef LINK_STATS_CONF_FALLING_SSV
+#define LINK_STATS_FALLING_SSV LINK_STATS_CONF_FALLING_SSV
+#else /* LINK_STATS_CONF_FALLING_SSV */
+#define LINK_STATS_FALLING_SSV                -100
+#endif /* LINK_STATS_FALLING_SSV */
+
 /* Special value that signal the RSSI is not initialized */
 #define LINK_STATS_RSSI_UNKNOWN 0x7fff
 
@@ -200,11 +208,20 @@ void link_stats_init(void);
 void link_stats_packet_sent(const linkaddr_t *lladdr, int status, int numtx);
 /* Packet input callback. Updates statistics for receptions on a given link */
 void link_stats_input_callback(const linkaddr_t *lladdr);
+/* RSSI sample callback. Updates the RSSI of a given link with a sample
+ * observed at rx_time (clock ticks), e.g. on an ACK or in a past TSCH slot.
+ * A sample older than the last one of the link is dropped */
+void link_stats_rssi_callback(const linkaddr_t *lladdr, int16_t rssi, clock_time_t rx_time);
 /* Updates Objective Function result for a given link */
 void link_stats_metric_update_callback(const linkaddr_t *lladdr, fix16_t ssv, fix16_t ssr, clock_time_t rx_time);
 /* Updates last probing time for a given link */
 void link_stats_probe_callback(const linkaddr_t *lladdr, clock_time_t probe_time);
 /* Updates neighbor RSSI for a given link */
 void link_stats_nbr_rssi_callback(const linkaddr_t *lladdr, fix16_t nbr_rssi, clock_time_t time_since);
+/* Returns the number of neighbors added since boot (wraps around) */
+uint16_t link_stats_new_neighbor_count(void);
+/* Returns the number of metric updates with an SSV below
+ * LINK_STATS_FALLING_SSV since boot (wraps around) */
+uint16_t link_stats_falling_link_count(void);
 
 #endif /* LINK_STATS_H_ */
@@ -49,6 +49,8 @@
 #include "sys/clock.h"
 #include "lib/random.h"
 #include "net/netstack.h"
+#include "net/link-stats.h"
+#include "net/nbr-table.h"
 #include "lib/list.h"
 #include "lib/memb.h"
 #include "lib/assert.h"
@@ -88,11 +90,57 @@
 #define CSMA_MAX_FRAME_RETRIES 7
 #endif
 
+#if CSMA_LINK_AWARE_RETRIES
+/* Maximum number of re-transmissions towards a neighbor whose link is
+   predicted to be collapsing */
+#ifdef CSMA_CONF_COLLAPSING_LINK_MAX_FRAME_RETRIES
+#define CSMA_COLLAPSING_LINK_MAX_FRAME_RETRIES CSMA_CONF_COLLAPSING_LINK_MAX_FRAME_RETRIES
+#else
+#define CSMA_COLLAPSING_LINK_MAX_FRAME_RETRIES 1
+#endif
+
+/* A link is collapsing if its SSV (RSSI slope, scaled as in PMAOF) is below
+   this value... */
+#ifdef CSMA_CONF_COLLAPSING_LINK_SSV
+#define CSMA_COLLAPSING_LINK_SSV CSMA_CONF_COLLAPSING_LINK_SSV
+#else
+#define CSMA_COLLAPSING_LINK_SSV -100
+#endif
+
+/* ...and its SSR (remaining RSSI margin, in dB) is below this value */
+#ifdef CSMA_CONF_COLLAPSING_LINK_SSR
+#define CSMA_COLLAPSING_LINK_SSR CSMA_CONF_COLLAPSING_LINK_SSR
+#else
+#define CSMA_COLLAPSING_LINK_SSR 10
+#endif
+
+/* Links with an ETX above this value get half of the retransmission budget */
+#ifdef CSMA_CONF_POOR_LINK_ETX
+#define CSMA_POOR_LINK_ETX CSMA_CONF_POOR_LINK_ETX
+#else
+#define CSMA_POOR_LINK_ETX (4 * LINK_STATS_ETX_DIVISOR)
+#endif
+#endif /* CSMA_LINK_AWARE_RETRIES */
+
+/* The early drop callback only makes sense with link-aware retries */
+#if CSMA_LINK_AWARE_RETRIES && defined(CSMA_CALLBACK_LINK_EARLY_DROP)
+#define CSMA_WITH_EARLY_DROP_CALLBACK 1
+#else
+#define CSMA_WITH_EARLY_DROP_CALLBACK 0
+#endif
+
 /* Packet metadata */
 struct qbuf_metadata {
   mac_callback_t sent;
   void *cptr;
   uint8_t max_transmissions;
+#if CSMA_LINK_AWARE_RETRIES
+  uint8_t link_aware; /* Set if the budget follows the link quality */
+  uint8_t early_drop; /* Set if the budget was cut due to a collapsing link */
+#endif /* CSMA_LINK_AWARE_RETRIES */
+#if CSMA_ZERO_COPY_TX
+  uint8_t framed; /* Set once the queuebuf holds the MAC frame */
+#endif /* CSMA_ZERO_COPY_TX */
 };
 
 /* Every neighbor has its own packet queue */
@@ -102,6 +150,10 @@ struct neighbor_queue {
   struct ctimer transmit_timer;
   uint8_t transmissions;
   uint8_t collisions;
+#if CSMA_BURST_MAX_LEN > 0
+  uint8_t burst_count; /* Number of frames sent so far in the current burst */
+  uint8_t burst_requested; /* Set if the last frame had the pending bit set */
+#endif /* CSMA_BURST_MAX_LEN > 0 */
   LIST_STRUCT(packet_queue);
 };
 
@@ -131,7 +183,19 @@ struct packet_queue {
 MEMB(neighbor_memb, struct neighbor_queue, CSMA_MAX_NEIGHBOR_QUEUES);
 MEMB(packet_memb, struct packet_queue, MAX_QUEUED_PACKETS);
 MEMB(metadata_memb, struct qbuf_metadata, MAX_QUEUED_PACKETS);
+#if CSMA_WITH_NBR_TABLE_QUEUES
+/* Per-neighbor pointer to the packet queue, so that looking up a queue uses
+   the same neighbor index as the other neighbor tables (link-stats, etc.) */
+NBR_TABLE(struct neighbor_queue *, neighbor_queues);
+/* The broadcast queue is kept out of the neighbor tables */
+static struct neighbor_queue *broadcast_queue;
+/* Queues of the neighbors removed from the neighbor tables, whose packets
+   are yet to be dropped */
+LIST(removed_queues);
+static struct ctimer removed_timer;
+#else /* CSMA_WITH_NBR_TABLE_QUEUES */
 LIST(neighbor_list);
+#endif /* CSMA_WITH_NBR_TABLE_QUEUES */
 
 static void packet_sent(struct neighbor_queue *n,
     struct packet_queue *q,
@@ -139,6 +203,81 @@ static void packet_sent(struct neighbor_queue *n,
     int num_transmissions);
 static void transmit_from_queue(void *ptr);
 /*---------------------------------------------------------------------------*/
+#if CSMA_WITH_NBR_TABLE_QUEUES
+static struct neighbor_queue *
+neighbor_queue_from_addr(const linkaddr_t *addr)
+{
+  struct neighbor_queue **nq;
+  if(linkaddr_cmp(addr, &linkaddr_null)) {
+    return broadcast_queue;
+  }
+  nq = nbr_table_get_from_lladdr(neighbor_queues, addr);
+  return nq != NULL ? *nq : NULL;
+}
+/*---------------------------------------------------------------------------*/
+static int
+neighbor_queue_add(struct neighbor_queue *n)
+{
+  struct neighbor_queue **nq;
+  if(linkaddr_cmp(&n->addr, &linkaddr_null)) {
+    broadcast_queue = n;
+    return 1;
+  }
+  nq = nbr_table_add_lladdr(neighbor_queues, &n->addr, NBR_TABLE_REASON_MAC, NULL);
+  if(nq == NULL) {
+    /* No free or evictable entry in the neighbor table */
+    return 0;
+  }
+  *nq = n;
+  /* Do not let the neighbor be evicted while it has packets queued */
+  nbr_table_lock(neighbor_queues, nq);
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static void
+neighbor_queue_remove(struct neighbor_queue *n)
+{
+  if(n == broadcast_queue) {
+    broadcast_queue = NULL;
+  } else {
+    /* Also releases the lock */
+    nbr_table_remove(neighbor_queues, nbr_table_get_from_lladdr(neighbor_queues, &n->addr));
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* Drops the packets of the queues removed from the neighbor tables. The sent
+   callbacks may queue packets again, so they are not called from within the
+   neighbor table */
+static void
+drop_removed_queues(void *ptr)
+{
+  struct neighbor_queue *n;
+  struct packet_queue *q;
+
+  while((n = list_pop(removed_queues)) != NULL) {
+    while((q = list_pop(n->packet_queue)) != NULL) {
+      struct qbuf_metadata *metadata = (struct qbuf_metadata *)q->ptr;
+      queuebuf_free(q->buf);
+      mac_call_sent_callback(metadata->sent, metadata->cptr, MAC_TX_ERR, n->transmissions);
+      memb_free(&metadata_memb, metadata);
+      memb_free(&packet_memb, q);
+    }
+    memb_free(&neighbor_memb, n);
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* Called when a neighbor is removed from all neighbor tables at once
+   (nbr_table_clear) */
+static void
+neighbor_queue_removed(nbr_table_item_t *item)
+{
+  struct neighbor_queue *n = *(struct neighbor_queue **)item;
+
+  ctimer_stop(&n->transmit_timer);
+  list_add(removed_queues, n);
+  ctimer_set(&removed_timer, 0, drop_removed_queues, NULL);
+}
+#else /* CSMA_WITH_NBR_TABLE_QUEUES */
 static struct neighbor_queue *
 neighbor_queue_from_addr(const linkaddr_t *addr)
 {
@@ -152,6 +291,85 @@ neighbor_queue_from_addr(const linkaddr_t *addr)
   return NULL;
 }
 /*---------------------------------------------------------------------------*/
+static int
+neighbor_queue_add(struct neighbor_queue *n)
+{
+  list_add(neighbor_list, n);
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static void
+neighbor_queue_remove(struct neighbor_queue *n)
+{
+  list_remove(neighbor_list, n);
+}
+#endif /* CSMA_WITH_NBR_TABLE_QUEUES */
+/*---------------------------------------------------------------------------*/
+#if CSMA_LINK_AWARE_RETRIES
+static int
+link_is_collapsing(const struct link_stats *stats)
+{
+  /* No SSV computed yet for this link */
+  if(stats->last_ssv == fix16_minimum) {
+    return 0;
+  }
+  return fix16_to_int(stats->last_ssv) < CSMA_COLLAPSING_LINK_SSV
+      && fix16_to_int(stats->last_ssr) < CSMA_COLLAPSING_LINK_SSR;
+}
+/*---------------------------------------------------------------------------*/
+/* Initial backoff exponent towards a neighbor, from its current link
+   statistics */
+static int
+link_aware_min_be(const struct neighbor_queue *n)
+{
+  const struct link_stats *stats = link_stats_from_lladdr(&n->addr);
+
+  if(stats != NULL
+     && (link_is_collapsing(stats) || stats->etx >= CSMA_POOR_LINK_ETX)) {
+    return MIN(CSMA_MIN_BE + 1, CSMA_MAX_BE);
+  }
+  return CSMA_MIN_BE;
+}
+/*---------------------------------------------------------------------------*/
+/* Sets the retransmission budget of a packet from the current link
+   statistics of its receiver, right before it is (re)transmitted */
+static void
+link_aware_budget(struct neighbor_queue *n, struct qbuf_metadata *metadata)
+{
+  const struct link_stats *stats;
+
+  if(!metadata->link_aware) {
+    /* Set by the application */
+    return;
+  }
+
+  stats = link_stats_from_lladdr(&n->addr);
+  metadata->early_drop = 0;
+  metadata->max_transmissions = CSMA_MAX_FRAME_RETRIES + 1;
+
+  if(stats == NULL) {
+    return;
+  }
+
+  if(link_is_collapsing(stats)) {
+    /* Retries are unlikely to succeed: try little, and let the routing
+       layer know early */
+    metadata->early_drop = 1;
+    metadata->max_transmissions = MIN(CSMA_COLLAPSING_LINK_MAX_FRAME_RETRIES,
+                                      CSMA_MAX_FRAME_RETRIES) + 1;
+  } else if(stats->etx >= CSMA_POOR_LINK_ETX) {
+    metadata->max_transmissions = CSMA_MAX_FRAME_RETRIES / 2 + 1;
+  }
+
+  LOG_DBG("link-aware budget for ");
+  LOG_DBG_LLADDR(&n->addr);
+  LOG_DBG_(": etx %u, ssv %d, ssr %d -> max tx %u\n",
+           stats->etx, (int)fix16_to_int(stats->last_ssv),
+           (int)fix16_to_int(stats->last_ssr),
+           metadata->max_transmissions);
+}
+#endif /* CSMA_LINK_AWARE_RETRIES */
+/*---------------------------------------------------------------------------*/
 static clock_time_t
 backoff_period(void)
 {
@@ -166,12 +384,10 @@ backoff_period(void)
 #endif /* CONTIKI_TARGET_COOJA */
 }
 /*---------------------------------------------------------------------------*/
+/* Builds the MAC frame of the packet in packetbuf */
 static int
-send_one_packet(struct neighbor_queue *n, struct packet_queue *q)
+create_frame(void)
 {
-  int ret;
-  int last_sent_ok = 0;
-
   packetbuf_set_addr(PACKETBUF_ADDR_SENDER, &linkaddr_node_addr);
   packetbuf_set_attr(PACKETBUF_ATTR_MAC_ACK, 1);
 
@@ -185,15 +401,68 @@ send_one_packet(struct neighbor_queue *n, struct packet_queue *q)
   if(csma_security_create_frame() < 0) {
     /* Failed to allocate space for headers */
     LOG_ERR("failed to create packet, seqno: %d\n", packetbuf_attr(PACKETBUF_ATTR_MAC_SEQNO));
+    return 0;
+  }
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+/* Returns the MAC frame of the packet at the head of the queue, or NULL if
+   it could not be created */
+static uint8_t *
+get_frame(struct neighbor_queue *n, struct packet_queue *q, int *frame_len)
+{
+  uint8_t *frame;
+#if CSMA_ZERO_COPY_TX
+  struct qbuf_metadata *metadata = (struct qbuf_metadata *)q->ptr;
+
+  if(metadata->framed) {
+    /* Retransmission: the frame was created on the first attempt, along
+       with its frame pending bit */
+#if CSMA_BURST_MAX_LEN > 0
+    n->burst_requested = queuebuf_attr(q->buf, PACKETBUF_ATTR_PENDING);
+#endif /* CSMA_BURST_MAX_LEN > 0 */
+    *frame_len = queuebuf_datalen(q->buf);
+    return queuebuf_dataptr(q->buf);
+  }
+#endif /* CSMA_ZERO_COPY_TX */
+
+#if CSMA_BURST_MAX_LEN > 0
+  /* Unicast. More packets in queue for the neighbor? The frame pending
+     bit is in the FCF, which LLSEC authenticates: it must be decided
+     before the frame is created */
+  n->burst_requested = !linkaddr_cmp(&n->addr, &linkaddr_null)
+    && n->burst_count + 1 < CSMA_BURST_MAX_LEN
+    && list_item_next(q) != NULL;
+  packetbuf_set_attr(PACKETBUF_ATTR_PENDING, n->burst_requested);
+#endif /* CSMA_BURST_MAX_LEN > 0 */
+  if(!create_frame()) {
+    *frame_len = 0;
+    return NULL;
+  }
+  frame = packetbuf_hdrptr();
+  *frame_len = packetbuf_totlen();
+  return frame;
+}
+/*---------------------------------------------------------------------------*/
+static int
+send_one_packet(struct neighbor_queue *n, struct packet_queue *q)
+{
+  int ret;
+  int last_sent_ok = 0;
+  int is_broadcast;
+  uint8_t *frame;
+  int frame_len;
+
+  is_broadcast = linkaddr_cmp(&n->addr, &linkaddr_null);
+  frame = get_frame(n, q, &frame_len);
+
+  if(frame == NULL) {
     ret = MAC_TX_ERR_FATAL;
   } else {
-    int is_broadcast;
     uint8_t dsn;
-    dsn = ((uint8_t *)packetbuf_hdrptr())[2] & 0xff;
+    dsn = frame[2] & 0xff;
 
-    NETSTACK_RADIO.prepare(packetbuf_hdrptr(), packetbuf_totlen());
-
-    is_broadcast = packetbuf_holds_broadcast();
+    NETSTACK_RADIO.prepare(frame, frame_len);
 
     if(NETSTACK_RADIO.receiving_packet() ||
        (!is_broadcast && NETSTACK_RADIO.pending_packet())) {
@@ -204,7 +473,7 @@ send_one_packet(struct neighbor_queue *n, struct packet_queue *q)
       ret = MAC_TX_COLLISION;
     } else {
 
-      radio_result_t foo = NETSTACK_RADIO.transmit(packetbuf_totlen());
+      radio_result_t foo = NETSTACK_RADIO.transmit(frame_len);
       //RTIMER_BUSYWAIT(RTIMER_SECOND / 200);
       switch(foo) {
       case RADIO_TX_OK:
@@ -268,8 +537,19 @@ transmit_from_queue(void *ptr)
       LOG_INFO_(", seqno %u, tx %u, queue %d\n",
         queuebuf_attr(q->buf, PACKETBUF_ATTR_MAC_SEQNO),
         n->transmissions, list_length(n->packet_queue));
+#if CSMA_LINK_AWARE_RETRIES
+      link_aware_budget(n, (struct qbuf_metadata *)q->ptr);
+#endif /* CSMA_LINK_AWARE_RETRIES */
       /* Send first packet in the neighbor queue */
+#if CSMA_ZERO_COPY_TX
+      /* A retransmitted frame is handed to the radio from the queuebuf,
+         and its attributes are read there */
+      if(!((struct qbuf_metadata *)q->ptr)->framed) {
+        queuebuf_to_packetbuf(q->buf);
+      }
+#else /* CSMA_ZERO_COPY_TX */
       queuebuf_to_packetbuf(q->buf);
+#endif /* CSMA_ZERO_COPY_TX */
       send_one_packet(n, q);
     }
   }
@@ -281,7 +561,11 @@ schedule_transmission(struct neighbor_queue *n)
   clock_time_t delay;
   int backoff_exponent; /* BE in IEEE 802.15.4 */
 
+#if CSMA_LINK_AWARE_RETRIES
+  backoff_exponent = MIN(n->collisions + link_aware_min_be(n), CSMA_MAX_BE);
+#else /* CSMA_LINK_AWARE_RETRIES */
   backoff_exponent = MIN(n->collisions + CSMA_MIN_BE, CSMA_MAX_BE);
+#endif /* CSMA_LINK_AWARE_RETRIES */
 
   /* Compute max delay as per IEEE 802.15.4: 2^BE-1 backoff periods  */
   delay = ((1 << backoff_exponent) - 1) * backoff_period();
@@ -311,12 +595,24 @@ free_packet(struct neighbor_queue *n, struct packet_queue *p, int status)
       /* There is a next packet. We reset current tx information */
       n->transmissions = 0;
       n->collisions = 0;
+#if CSMA_BURST_MAX_LEN > 0
+      if(status == MAC_TX_OK && n->burst_requested) {
+        /* The receiver was told more is coming: send the next packet
+           right away, without a backoff */
+        n->burst_count++;
+        n->burst_requested = 0;
+        LOG_DBG("continuing burst, count %u\n", n->burst_count);
+        ctimer_set(&n->transmit_timer, 0, transmit_from_queue, n);
+        return;
+      }
+      n->burst_count = 0;
+#endif /* CSMA_BURST_MAX_LEN > 0 */
       /* Schedule next transmissions */
       schedule_transmission(n);
     } else {
       /* This was the last packet in the queue, we free the neighbor */
       ctimer_stop(&n->transmit_timer);
-      list_remove(neighbor_list, n);
+      neighbor_queue_remove(n);
       memb_free(&neighbor_memb, n);
     }
   }
@@ -329,29 +625,68 @@ tx_done(int status, struct packet_queue *q, struct neighbor_queue *n)
   struct qbuf_metadata *metadata;
   void *cptr;
   uint8_t ntx;
+#if CSMA_WITH_EARLY_DROP_CALLBACK
+  linkaddr_t addr;
+  uint8_t early_drop;
+#endif /* CSMA_WITH_EARLY_DROP_CALLBACK */
 
   metadata = (struct qbuf_metadata *)q->ptr;
   sent = metadata->sent;
   cptr = metadata->cptr;
   ntx = n->transmissions;
+#if CSMA_WITH_EARLY_DROP_CALLBACK
+  /* The neighbor queue may be freed along with the packet */
+  linkaddr_copy(&addr, &n->addr);
+  early_drop = metadata->early_drop && status == MAC_TX_NOACK;
+#endif /* CSMA_WITH_EARLY_DROP_CALLBACK */
 
   LOG_INFO("packet sent to ");
   LOG_INFO_LLADDR(&n->addr);
   LOG_INFO_(", seqno %u, status %u, tx %u, coll %u\n",
-              packetbuf_attr(PACKETBUF_ATTR_MAC_SEQNO),
+              queuebuf_attr(q->buf, PACKETBUF_ATTR_MAC_SEQNO),
               status, n->transmissions, n->collisions);
 
+#if CSMA_ZERO_COPY_TX
+  /* The sent callback reads the packet attributes from the packetbuf,
+     which no longer holds a packet that was retransmitted */
+  if(metadata->framed) {
+    queuebuf_attr_to_packetbuf(q->buf);
+  }
+#endif /* CSMA_ZERO_COPY_TX */
+
   free_packet(n, q, status);
   mac_call_sent_callback(sent, cptr, status, ntx);
+
+#if CSMA_WITH_EARLY_DROP_CALLBACK
+  if(early_drop) {
+    LOG_INFO("early drop on collapsing link to ");
+    LOG_INFO_LLADDR(&addr);
+    LOG_INFO_("\n");
+    CSMA_CALLBACK_LINK_EARLY_DROP(&addr);
+  }
+#endif /* CSMA_WITH_EARLY_DROP_CALLBACK */
 }
 /*---------------------------------------------------------------------------*/
 static void
 rexmit(struct packet_queue *q, struct neighbor_queue *n)
 {
+#if CSMA_ZERO_COPY_TX
+  struct qbuf_metadata *metadata = (struct qbuf_metadata *)q->ptr;
+#endif /* CSMA_ZERO_COPY_TX */
+
   schedule_transmission(n);
+#if CSMA_ZERO_COPY_TX
+  if(!metadata->framed) {
+    /* The packetbuf still holds the frame of the first attempt: keep it,
+       along with the attributes, for the retransmissions */
+    queuebuf_update_from_packetbuf(q->buf);
+    metadata->framed = 1;
+  }
+#else /* CSMA_ZERO_COPY_TX */
   /* This is needed to correctly attribute energy that we spent
      transmitting this packet. */
   queuebuf_update_attr_from_packetbuf(q->buf);
+#endif /* CSMA_ZERO_COPY_TX */
 }
 /*---------------------------------------------------------------------------*/
 static void
@@ -419,7 +754,7 @@ packet_sent(struct neighbor_queue *n,
   LOG_INFO("tx to ");
   LOG_INFO_LLADDR(&n->addr);
   LOG_INFO_(", seqno %u, status %u, tx %u, coll %u\n",
-            packetbuf_attr(PACKETBUF_ATTR_MAC_SEQNO),
+            queuebuf_attr(q->buf, PACKETBUF_ATTR_MAC_SEQNO),
             status, n->transmissions, n->collisions);
 
   switch(status) {
@@ -460,10 +795,17 @@ csma_output_packet(mac_callback_t sent, void *ptr)
       linkaddr_copy(&n->addr, addr);
       n->transmissions = 0;
       n->collisions = 0;
+#if CSMA_BURST_MAX_LEN > 0
+      n->burst_count = 0;
+      n->burst_requested = 0;
+#endif /* CSMA_BURST_MAX_LEN > 0 */
       /* Init packet queue for this neighbor */
       LIST_STRUCT_INIT(n, packet_queue);
-      /* Add neighbor to the neighbor list */
-      list_add(neighbor_list, n);
+      /* Add neighbor to the neighbor queue table */
+      if(!neighbor_queue_add(n)) {
+        memb_free(&neighbor_memb, n);
+        n = NULL;
+      }
     }
   }
 
@@ -479,12 +821,25 @@ csma_output_packet(mac_callback_t sent, void *ptr)
             struct qbuf_metadata *metadata = (struct qbuf_metadata *)q->ptr;
             /* Neighbor and packet successfully allocated */
             metadata->max_transmissions = packetbuf_attr(PACKETBUF_ATTR_MAX_MAC_TRANSMISSIONS);
+#if CSMA_LINK_AWARE_RETRIES
+            /* If not set by the application, derive it from the link
+               quality at every transmission */
+            metadata->link_aware = metadata->max_transmissions == 0;
+            metadata->early_drop = 0;
+            if(metadata->link_aware) {
+              metadata->max_transmissions = CSMA_MAX_FRAME_RETRIES + 1;
+            }
+#else /* CSMA_LINK_AWARE_RETRIES */
             if(metadata->max_transmissions == 0) {
               /* If not set by the application, use the default CSMA value */
               metadata->max_transmissions = CSMA_MAX_FRAME_RETRIES + 1;
             }
+#endif /* CSMA_LINK_AWARE_RETRIES */
             metadata->sent = sent;
             metadata->cptr = ptr;
+#if CSMA_ZERO_COPY_TX
+            metadata->framed = 0;
+#endif /* CSMA_ZERO_COPY_TX */
             list_add(n->packet_queue, q);
 
             LOG_INFO("sending to ");
@@ -507,7 +862,7 @@ csma_output_packet(mac_callback_t sent, void *ptr)
       }
       /* The packet allocation failed. Remove and free neighbor entry if empty. */
       if(list_length(n->packet_queue) == 0) {
-        list_remove(neighbor_list, n);
+        neighbor_queue_remove(n);
         memb_free(&neighbor_memb, n);
       }
     } else {
@@ -526,4 +881,7 @@ csma_output_init(void)
   memb_init(&packet_memb);
   memb_init(&metadata_memb);
   memb_init(&neighbor_memb);
+#if CSMA_WITH_NBR_TABLE_QUEUES
+  nbr_table_register(neighbor_queues, neighbor_queue_removed);
+#endif /* CSMA_WITH_NBR_TABLE_QUEUES */
 }
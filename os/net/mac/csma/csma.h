@@ -78,6 +78,63 @@
 #define CSMA_ACK_LEN 3
 #endif /* CSMA_CONF_ACK_LEN */
 
+/* Set an upper bound on the number of frames sent back-to-back to the same
+ * neighbor, without a backoff in between. Every frame but the last of a
+ * burst has the frame pending bit set. Set to 0 to never trigger a burst. */
+#ifdef CSMA_CONF_BURST_MAX_LEN
+#define CSMA_BURST_MAX_LEN CSMA_CONF_BURST_MAX_LEN
+#else /* CSMA_CONF_BURST_MAX_LEN */
+#define CSMA_BURST_MAX_LEN 0
+#endif /* CSMA_CONF_BURST_MAX_LEN */
+
+/* Look up the neighbor queues through a neighbor table instead of walking a
+ * list. Unicast neighbors are locked in the table while they have packets
+ * queued. When the neighbor table has no free or evictable entry left, a new
+ * neighbor gets no queue and its packets fail with MAC_TX_QUEUE_FULL. If the
+ * neighbor tables are cleared, the queued packets fail with MAC_TX_ERR, from
+ * a callback timer rather than from within the neighbor table */
+#ifdef CSMA_CONF_WITH_NBR_TABLE_QUEUES
+#define CSMA_WITH_NBR_TABLE_QUEUES CSMA_CONF_WITH_NBR_TABLE_QUEUES
+#else /* CSMA_CONF_WITH_NBR_TABLE_QUEUES */
+#define CSMA_WITH_NBR_TABLE_QUEUES 0
+#endif /* CSMA_CONF_WITH_NBR_TABLE_QUEUES */
+
+/* Create the MAC frame once, on the first transmission attempt, and hand it
+ * to the radio straight from the queuebuf on every retransmission, instead of
+ * copying it back into the packetbuf and framing it again each time. The
+ * frame is stored back into the queuebuf only when a first attempt fails */
+#ifdef CSMA_CONF_ZERO_COPY_TX
+#define CSMA_ZERO_COPY_TX CSMA_CONF_ZERO_COPY_TX
+#else /* CSMA_CONF_ZERO_COPY_TX */
+#define CSMA_ZERO_COPY_TX 0
+#endif /* CSMA_CONF_ZERO_COPY_TX */
+
+/* Derive the retransmission budget and initial backoff exponent of every
+ * packet from the link statistics of its receiver (ETX, and the SSV/SSR
+ * computed by PMAOF), instead of using the same defaults for all neighbors */
+#ifdef CSMA_CONF_LINK_AWARE_RETRIES
+#define CSMA_LINK_AWARE_RETRIES CSMA_CONF_LINK_AWARE_RETRIES
+#else /* CSMA_CONF_LINK_AWARE_RETRIES */
+#define CSMA_LINK_AWARE_RETRIES 0
+#endif /* CSMA_CONF_LINK_AWARE_RETRIES */
+
+/*********** Callbacks *********/
+
+/* Link callbacks to RPL in case RPL is enabled */
+#if CSMA_LINK_AWARE_RETRIES && UIP_CONF_IPV6_RPL && ROUTING_CONF_RPL_CLASSIC
+
+#ifndef CSMA_CALLBACK_LINK_EARLY_DROP
+#define CSMA_CALLBACK_LINK_EARLY_DROP rpl_link_early_drop_callback
+#endif /* CSMA_CALLBACK_LINK_EARLY_DROP */
+
+#endif /* CSMA_LINK_AWARE_RETRIES && UIP_CONF_IPV6_RPL && ROUTING_CONF_RPL_CLASSIC */
+
+/* Called by CSMA when a packet was dropped after a reduced retransmission
+ * budget, because the link to its receiver was predicted to be collapsing */
+#ifdef CSMA_CALLBACK_LINK_EARLY_DROP
+void CSMA_CALLBACK_LINK_EARLY_DROP(const linkaddr_t *addr);
+#endif
+
 /* just a default - with LLSEC, etc */
 #define CSMA_MAC_MAX_HEADER 21
 
@@ -91,6 +91,24 @@
 #define TSCH_MAX_EB_PERIOD (16 * CLOCK_SECOND)
 #endif
 
+/* Adapt the EB period to the mobility of the neighborhood. When link-stats
+ * reports new neighbors or links with a strongly negative SSV, the period
+ * drops to TSCH_ADAPTIVE_EB_MIN_PERIOD so that newcomers join quickly. It
+ * then doubles after every EB sent in a stable neighborhood, up to
+ * TSCH_MAX_EB_PERIOD. Has no effect when TSCH_EB_PERIOD is zero. */
+#ifdef TSCH_CONF_ADAPTIVE_EB_PERIOD
+#define TSCH_ADAPTIVE_EB_PERIOD TSCH_CONF_ADAPTIVE_EB_PERIOD
+#else
+#define TSCH_ADAPTIVE_EB_PERIOD 0
+#endif
+
+/* Shortest EB period used when TSCH_ADAPTIVE_EB_PERIOD is enabled */
+#ifdef TSCH_CONF_ADAPTIVE_EB_MIN_PERIOD
+#define TSCH_ADAPTIVE_EB_MIN_PERIOD TSCH_CONF_ADAPTIVE_EB_MIN_PERIOD
+#else
+#define TSCH_ADAPTIVE_EB_MIN_PERIOD (TSCH_EB_PERIOD / 4)
+#endif
+
 /* Use SFD timestamp for synchronization? By default we merely rely on rtimer and busy wait
  * until SFD is high, which we found to provide greater accuracy on JN516x and CC2420.
  * Note: for association, however, we always use SFD timestamp to know the time of arrival
@@ -314,6 +332,23 @@
 #define TSCH_QUEUE_MAX_NEIGHBOR_QUEUES ((NBR_TABLE_CONF_MAX_NEIGHBORS) + 2)
 #endif
 
+/* Keep a bitmap of the unicast neighbors that may send in a shared link
+ * (queued packets, no dedicated Tx link, backoff expired), so that
+ * shared links do not walk the whole neighbor table */
+#ifdef TSCH_QUEUE_CONF_WITH_READY_BITMAP
+#define TSCH_QUEUE_WITH_READY_BITMAP TSCH_QUEUE_CONF_WITH_READY_BITMAP
+#else
+#define TSCH_QUEUE_WITH_READY_BITMAP 1
+#endif
+
+/* Feed the RSSI of received ACKs to link-stats, as extra samples for the
+ * link metrics. Rx and ACK samples are time-stamped with their ASN. */
+#ifdef TSCH_CONF_LINK_STATS_ACK_RSSI
+#define TSCH_LINK_STATS_ACK_RSSI TSCH_CONF_LINK_STATS_ACK_RSSI
+#else
+#define TSCH_LINK_STATS_ACK_RSSI 1
+#endif
+
 /******** Configuration: scheduling  *******/
 
 /* Initializes TSCH with a 6TiSCH minimal schedule */
@@ -353,6 +388,15 @@
 #define TSCH_SCHEDULE_MAX_LINKS 32
 #endif
 
+/* Keep an index of all links sorted by slotframe and timeslot, so that the
+ * next active link is found with a binary search in every slotframe rather
+ * than by walking all links from the slot operation */
+#ifdef TSCH_SCHEDULE_CONF_WITH_INDEX
+#define TSCH_SCHEDULE_WITH_INDEX TSCH_SCHEDULE_CONF_WITH_INDEX
+#else
+#define TSCH_SCHEDULE_WITH_INDEX 1
+#endif
+
 /* To include Sixtop Implementation */
 #ifdef TSCH_CONF_WITH_SIXTOP
 #define TSCH_WITH_SIXTOP TSCH_CONF_WITH_SIXTOP
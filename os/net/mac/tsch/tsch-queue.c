@@ -55,6 +55,8 @@
 #include "net/queuebuf.h"
 #include "net/mac/tsch/tsch.h"
 #include "net/nbr-table.h"
+#include "net/link-stats.h"
+#include "sys/critical.h"
 #include <string.h>
 
 /* Log configuration */
@@ -75,6 +77,12 @@ NBR_TABLE(struct tsch_neighbor, tsch_neighbors);
 struct tsch_neighbor *n_broadcast;
 struct tsch_neighbor *n_eb;
 
+#if TSCH_QUEUE_WITH_READY_BITMAP
+/* Neighbors that may send in a shared link, by neighbor table index */
+#define READY_BITMAP_WORDS ((NBR_TABLE_MAX_NEIGHBORS + 31) / 32)
+static uint32_t ready_bitmap[READY_BITMAP_WORDS];
+#endif /* TSCH_QUEUE_WITH_READY_BITMAP */
+
 /*---------------------------------------------------------------------------*/
 /* Add a TSCH neighbor */
 struct tsch_neighbor *
@@ -206,6 +214,27 @@ tsch_queue_flush_nbr_queue(struct tsch_neighbor *n)
   }
 }
 /*---------------------------------------------------------------------------*/
+/* Updates the ready state of a neighbor after a change of its queue,
+ * backoff or Tx links. Called from both the slot operation and processes. */
+void
+tsch_queue_update_ready(const struct tsch_neighbor *n)
+{
+#if TSCH_QUEUE_WITH_READY_BITMAP
+  int index = nbr_table_get_index(tsch_neighbors, n);
+  if(index >= 0) {
+    uint32_t mask = (uint32_t)1 << (index % 32);
+    int_master_status_t status = critical_enter();
+    if(!n->is_broadcast && n->tx_links_count == 0
+       && n->backoff_window == 0 && !ringbufindex_empty(&n->tx_ringbuf)) {
+      ready_bitmap[index / 32] |= mask;
+    } else {
+      ready_bitmap[index / 32] &= ~mask;
+    }
+    critical_exit(status);
+  }
+#endif /* TSCH_QUEUE_WITH_READY_BITMAP */
+}
+/*---------------------------------------------------------------------------*/
 /* Remove TSCH neighbor queue */
 static void
 tsch_queue_remove_nbr(struct tsch_neighbor *n)
@@ -257,9 +286,13 @@ tsch_queue_add_packet(const linkaddr_t *addr, uint8_t max_transmissions,
             p->ret = MAC_TX_DEFERRED;
             p->transmissions = 0;
             p->max_transmissions = max_transmissions;
+#if TSCH_LINK_STATS_ACK_RSSI
+            p->ack_rssi = LINK_STATS_RSSI_UNKNOWN;
+#endif /* TSCH_LINK_STATS_ACK_RSSI */
             /* Add to ringbuf (actual add committed through atomic operation) */
             n->tx_array[put_index] = p;
             ringbufindex_put(&n->tx_ringbuf);
+            tsch_queue_update_ready(n);
             LOG_DBG("packet is added put_index %u, packet %p\n",
                    put_index, p);
             return p;
@@ -300,6 +333,7 @@ tsch_queue_remove_packet_from_queue(struct tsch_neighbor *n)
       /* Get and remove packet from ringbuf (remove committed through an atomic operation */
       int16_t get_index = ringbufindex_get(&n->tx_ringbuf);
       if(get_index != -1) {
+        tsch_queue_update_ready(n);
         return n->tx_array[get_index];
       } else {
         return NULL;
@@ -464,6 +498,29 @@ struct tsch_packet *
 tsch_queue_get_unicast_packet_for_any(struct tsch_neighbor **n, struct tsch_link *link)
 {
   if(!tsch_is_locked()) {
+#if TSCH_QUEUE_WITH_READY_BITMAP
+    int i;
+    for(i = 0; i < READY_BITMAP_WORDS; i++) {
+      uint32_t word = ready_bitmap[i];
+      int index = i * 32;
+      /* Only visit the neighbors that are ready */
+      for(; word != 0; word >>= 1, index++) {
+        if(word & 1) {
+          struct tsch_neighbor *curr_nbr =
+            (struct tsch_neighbor *)nbr_table_get_from_index(tsch_neighbors, index);
+          if(curr_nbr != NULL && !curr_nbr->is_broadcast && curr_nbr->tx_links_count == 0) {
+            struct tsch_packet *p = tsch_queue_get_packet_for_nbr(curr_nbr, link);
+            if(p != NULL) {
+              if(n != NULL) {
+                *n = curr_nbr;
+              }
+              return p;
+            }
+          }
+        }
+      }
+    }
+#else /* TSCH_QUEUE_WITH_READY_BITMAP */
     struct tsch_neighbor *curr_nbr = (struct tsch_neighbor *)nbr_table_head(tsch_neighbors);
     struct tsch_packet *p = NULL;
     while(curr_nbr != NULL) {
@@ -479,6 +536,7 @@ tsch_queue_get_unicast_packet_for_any(struct tsch_neighbor **n, struct tsch_link
       }
       curr_nbr = (struct tsch_neighbor *)nbr_table_next(tsch_neighbors, curr_nbr);
     }
+#endif /* TSCH_QUEUE_WITH_READY_BITMAP */
   }
   return NULL;
 }
@@ -496,6 +554,7 @@ tsch_queue_backoff_reset(struct tsch_neighbor *n)
 {
   n->backoff_window = 0;
   n->backoff_exponent = TSCH_MAC_MIN_BE;
+  tsch_queue_update_ready(n);
 }
 /*---------------------------------------------------------------------------*/
 /* Increment backoff exponent, pick a new window */
@@ -513,6 +572,7 @@ tsch_queue_backoff_inc(struct tsch_neighbor *n)
   if(n->backoff_window < UINT16_MAX) {
     n->backoff_window++;
   }
+  tsch_queue_update_ready(n);
 }
 /*---------------------------------------------------------------------------*/
 /* Decrement backoff window for all queues directed at dest_addr */
@@ -527,6 +587,9 @@ tsch_queue_update_all_backoff_windows(const linkaddr_t *dest_addr)
          && ((n->tx_links_count == 0 && is_broadcast)
              || (n->tx_links_count > 0 && linkaddr_cmp(dest_addr, tsch_queue_get_nbr_address(n))))) {
         n->backoff_window--;
+        if(n->backoff_window == 0) {
+          tsch_queue_update_ready(n);
+        }
       }
       n = (struct tsch_neighbor *)nbr_table_next(tsch_neighbors, n);
     }
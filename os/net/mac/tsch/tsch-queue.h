@@ -163,6 +163,13 @@ struct tsch_packet *tsch_queue_get_packet_for_dest_addr(const linkaddr_t *addr,
  * \return The packet if any, else NULL
  */
 struct tsch_packet *tsch_queue_get_unicast_packet_for_any(struct tsch_neighbor **n, struct tsch_link *link);
+/**
+ * \brief Updates the ready state of a neighbor, used to find the neighbors
+ * that may send in a shared link. To be called whenever the queue, backoff
+ * window or Tx link count of the neighbor changes.
+ * \param n The neighbor queue
+ */
+void tsch_queue_update_ready(const struct tsch_neighbor *n);
 /**
  * \brief Is the neighbor backoff timer expired?
  * \param n The neighbor queue
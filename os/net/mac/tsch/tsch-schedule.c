@@ -67,6 +67,38 @@ MEMB(link_memb, struct tsch_link, TSCH_SCHEDULE_MAX_LINKS);
 MEMB(slotframe_memb, struct tsch_slotframe, TSCH_SCHEDULE_MAX_SLOTFRAMES);
 /* List of slotframes (each slotframe holds its own list of links) */
 LIST(slotframe_list);
+#if TSCH_SCHEDULE_WITH_INDEX
+/* All links, grouped by slotframe and sorted by timeslot within each
+ * slotframe (see index_start and index_len in struct tsch_slotframe) */
+static struct tsch_link *link_index[TSCH_SCHEDULE_MAX_LINKS];
+/* Timeslot of every link of the index, searched without dereferencing
+ * the links */
+static uint16_t link_index_timeslot[TSCH_SCHEDULE_MAX_LINKS];
+#endif /* TSCH_SCHEDULE_WITH_INDEX */
+
+/*---------------------------------------------------------------------------*/
+/* Rebuilds the link index after a change of the schedule.
+ * Must be called with the TSCH lock held. */
+static void
+index_rebuild(void)
+{
+#if TSCH_SCHEDULE_WITH_INDEX
+  uint16_t pos = 0;
+  struct tsch_slotframe *sf;
+  struct tsch_link *l;
+
+  for(sf = list_head(slotframe_list); sf != NULL; sf = list_item_next(sf)) {
+    sf->index_start = pos;
+    for(l = list_head(sf->links_list); l != NULL; l = list_item_next(l)) {
+      link_index[pos] = l;
+      link_index_timeslot[pos] = l->timeslot;
+      pos++;
+    }
+    sf->index_len = pos - sf->index_start;
+  }
+#endif /* TSCH_SCHEDULE_WITH_INDEX */
+}
+/*---------------------------------------------------------------------------*/
 
 /* Adds and returns a slotframe (NULL if failure) */
 struct tsch_slotframe *
@@ -90,6 +122,7 @@ tsch_schedule_add_slotframe(uint16_t handle, uint16_t size)
       LIST_STRUCT_INIT(sf, links_list);
       /* Add the slotframe to the global list */
       list_add(slotframe_list, sf);
+      index_rebuild();
     }
     LOG_INFO("add_slotframe %u %u\n",
            handle, size);
@@ -128,6 +161,7 @@ tsch_schedule_remove_slotframe(struct tsch_slotframe *slotframe)
       LOG_INFO("remove slotframe %u %u\n", slotframe->handle, slotframe->size.val);
       memb_free(&slotframe_memb, slotframe);
       list_remove(slotframe_list, slotframe);
+      index_rebuild();
       tsch_release_lock();
       return 1;
     }
@@ -242,8 +276,8 @@ tsch_schedule_add_link(struct tsch_slotframe *slotframe,
       } else {
         static int current_link_handle = 0;
         struct tsch_neighbor *n;
-        /* Add the link to the slotframe */
-        list_add(slotframe->links_list, l);
+        struct tsch_link *prev;
+        struct tsch_link *curr;
         /* Initialize link */
         l->handle = current_link_handle++;
         l->link_options = link_options;
@@ -257,6 +291,17 @@ tsch_schedule_add_link(struct tsch_slotframe *slotframe,
         }
         linkaddr_copy(&l->addr, address);
 
+        /* Add the link to the slotframe, keeping the list sorted by timeslot.
+         * Links sharing a timeslot stay in the order they were added. */
+        prev = NULL;
+        curr = list_head(slotframe->links_list);
+        while(curr != NULL && curr->timeslot <= timeslot) {
+          prev = curr;
+          curr = list_item_next(curr);
+        }
+        list_insert(slotframe->links_list, prev, l);
+        index_rebuild();
+
         LOG_INFO("add_link sf=%u opt=%s type=%s ts=%u ch=%u addr=",
                  slotframe->handle,
                  print_link_options(link_options),
@@ -274,6 +319,7 @@ tsch_schedule_add_link(struct tsch_slotframe *slotframe,
             if(!(l->link_options & LINK_OPTION_SHARED)) {
               n->dedicated_tx_links_count++;
             }
+            tsch_queue_update_ready(n);
           }
         }
       }
@@ -310,6 +356,7 @@ tsch_schedule_remove_link(struct tsch_slotframe *slotframe, struct tsch_link *l)
 
       list_remove(slotframe->links_list, l);
       memb_free(&link_memb, l);
+      index_rebuild();
 
       /* Release the lock before we update the neighbor (will take the lock) */
       tsch_release_lock();
@@ -322,6 +369,7 @@ tsch_schedule_remove_link(struct tsch_slotframe *slotframe, struct tsch_link *l)
           if(!(link_options & LINK_OPTION_SHARED)) {
             n->dedicated_tx_links_count--;
           }
+          tsch_queue_update_ready(n);
         }
       }
 
@@ -400,6 +448,84 @@ default_tsch_link_comparator(struct tsch_link *a, struct tsch_link *b)
   return a;
 }
 
+/*---------------------------------------------------------------------------*/
+/* Considers link l, occurring time_to_timeslot slots from now, as the next
+ * active link. Updates the current best and backup links accordingly. */
+static void
+select_link(struct tsch_link *l, uint16_t time_to_timeslot,
+            struct tsch_link **curr_best, uint16_t *time_to_curr_best,
+            struct tsch_link **curr_backup)
+{
+  if(*curr_best == NULL || time_to_timeslot < *time_to_curr_best) {
+    *time_to_curr_best = time_to_timeslot;
+    *curr_best = l;
+    *curr_backup = NULL;
+  } else if(time_to_timeslot == *time_to_curr_best) {
+    struct tsch_link *new_best = NULL;
+    /* Two links are overlapping, we need to select one of them.
+     * By standard: prioritize Tx links first, second by lowest handle */
+    if(((*curr_best)->link_options & LINK_OPTION_TX) == (l->link_options & LINK_OPTION_TX)) {
+      /* Both or neither links have Tx, select the one with lowest handle */
+      if(l->slotframe_handle != (*curr_best)->slotframe_handle) {
+        if(l->slotframe_handle < (*curr_best)->slotframe_handle) {
+          new_best = l;
+        }
+      } else {
+        /* compare the link against the current best link and return the newly selected one */
+        new_best = TSCH_LINK_COMPARATOR(*curr_best, l);
+      }
+    } else {
+      /* Select the link that has the Tx option */
+      if(l->link_options & LINK_OPTION_TX) {
+        new_best = l;
+      }
+    }
+
+    /* Maintain backup_link */
+    /* Check if 'l' best can be used as backup */
+    if(new_best != l && (l->link_options & LINK_OPTION_RX)) { /* Does 'l' have Rx flag? */
+      if(*curr_backup == NULL || l->slotframe_handle < (*curr_backup)->slotframe_handle) {
+        *curr_backup = l;
+      }
+    }
+    /* Check if curr_best can be used as backup */
+    if(new_best != *curr_best && ((*curr_best)->link_options & LINK_OPTION_RX)) { /* Does curr_best have Rx flag? */
+      if(*curr_backup == NULL || (*curr_best)->slotframe_handle < (*curr_backup)->slotframe_handle) {
+        *curr_backup = *curr_best;
+      }
+    }
+
+    /* Maintain curr_best */
+    if(new_best != NULL) {
+      *curr_best = new_best;
+    }
+  }
+}
+#if TSCH_SCHEDULE_WITH_INDEX
+/*---------------------------------------------------------------------------*/
+/* Returns the index position of the first link of a (non-empty) slotframe
+ * that occurs after a given timeslot, wrapping around to the first link
+ * of the slotframe */
+static uint16_t
+index_next(const struct tsch_slotframe *sf, uint16_t timeslot)
+{
+  uint16_t low = sf->index_start;
+  uint16_t high = sf->index_start + sf->index_len;
+
+  while(low < high) {
+    uint16_t mid = low + (high - low) / 2;
+    if(link_index_timeslot[mid] <= timeslot) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  if(low == sf->index_start + sf->index_len) {
+    low = sf->index_start;
+  }
+  return low;
+}
+#endif /* TSCH_SCHEDULE_WITH_INDEX */
 /*---------------------------------------------------------------------------*/
 /* Returns the next active link after a given ASN, and a backup link (for the same ASN, with Rx flag) */
 struct tsch_link *
@@ -418,59 +544,34 @@ tsch_schedule_get_next_active_link(struct tsch_asn_t *asn, uint16_t *time_offset
     while(sf != NULL) {
       /* Get timeslot from ASN, given the slotframe length */
       uint16_t timeslot = TSCH_ASN_MOD(*asn, sf->size);
+#if TSCH_SCHEDULE_WITH_INDEX
+      if(sf->index_len > 0) {
+        uint16_t end = sf->index_start + sf->index_len;
+        uint16_t i = index_next(sf, timeslot);
+        uint16_t link_timeslot = link_index_timeslot[i];
+        uint16_t time_to_timeslot =
+          link_timeslot > timeslot ?
+          link_timeslot - timeslot :
+          sf->size.val + link_timeslot - timeslot;
+        /* Only the links at the earliest timeslot of the slotframe compete */
+        while(i < end && link_index_timeslot[i] == link_timeslot) {
+          select_link(link_index[i], time_to_timeslot,
+                      &curr_best, &time_to_curr_best, &curr_backup);
+          i++;
+        }
+      }
+#else /* TSCH_SCHEDULE_WITH_INDEX */
       struct tsch_link *l = list_head(sf->links_list);
       while(l != NULL) {
         uint16_t time_to_timeslot =
           l->timeslot > timeslot ?
           l->timeslot - timeslot :
           sf->size.val + l->timeslot - timeslot;
-        if(curr_best == NULL || time_to_timeslot < time_to_curr_best) {
-          time_to_curr_best = time_to_timeslot;
-          curr_best = l;
-          curr_backup = NULL;
-        } else if(time_to_timeslot == time_to_curr_best) {
-          struct tsch_link *new_best = NULL;
-          /* Two links are overlapping, we need to select one of them.
-           * By standard: prioritize Tx links first, second by lowest handle */
-          if((curr_best->link_options & LINK_OPTION_TX) == (l->link_options & LINK_OPTION_TX)) {
-            /* Both or neither links have Tx, select the one with lowest handle */
-            if(l->slotframe_handle != curr_best->slotframe_handle) {
-              if(l->slotframe_handle < curr_best->slotframe_handle) {
-                new_best = l;
-              }
-            } else {
-              /* compare the link against the current best link and return the newly selected one */
-              new_best = TSCH_LINK_COMPARATOR(curr_best, l);
-            }
-          } else {
-            /* Select the link that has the Tx option */
-            if(l->link_options & LINK_OPTION_TX) {
-              new_best = l;
-            }
-          }
-
-          /* Maintain backup_link */
-          /* Check if 'l' best can be used as backup */
-          if(new_best != l && (l->link_options & LINK_OPTION_RX)) { /* Does 'l' have Rx flag? */
-            if(curr_backup == NULL || l->slotframe_handle < curr_backup->slotframe_handle) {
-              curr_backup = l;
-            }
-          }
-          /* Check if curr_best can be used as backup */
-          if(new_best != curr_best && (curr_best->link_options & LINK_OPTION_RX)) { /* Does curr_best have Rx flag? */
-            if(curr_backup == NULL || curr_best->slotframe_handle < curr_backup->slotframe_handle) {
-              curr_backup = curr_best;
-            }
-          }
-
-          /* Maintain curr_best */
-          if(new_best != NULL) {
-            curr_best = new_best;
-          }
-        }
-
+        select_link(l, time_to_timeslot,
+                    &curr_best, &time_to_curr_best, &curr_backup);
         l = list_item_next(l);
       }
+#endif /* TSCH_SCHEDULE_WITH_INDEX */
       sf = list_item_next(sf);
     }
     if(time_offset != NULL) {
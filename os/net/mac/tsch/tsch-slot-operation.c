@@ -694,6 +694,12 @@ PT_THREAD(tsch_tx_slot(struct pt *pt, struct rtimer *t))
               }
 
               if(ack_len != 0) {
+#if TSCH_LINK_STATS_ACK_RSSI
+                radio_value_t radio_last_rssi;
+                NETSTACK_RADIO.get_value(RADIO_PARAM_LAST_RSSI, &radio_last_rssi);
+                current_packet->ack_rssi = (signed)radio_last_rssi;
+                current_packet->ack_asn = tsch_current_asn;
+#endif /* TSCH_LINK_STATS_ACK_RSSI */
                 if(is_time_source) {
                   int32_t eack_time_correction = US_TO_RTIMERTICKS(ack_ies.ie_time_correction);
                   int32_t since_last_timesync = TSCH_ASN_DIFF(tsch_current_asn, last_sync_asn);
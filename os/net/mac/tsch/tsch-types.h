@@ -89,8 +89,12 @@ struct tsch_slotframe {
   /* Number of timeslots in the slotframe.
    * Stored as struct asn_divisor_t because we often need ASN%size */
   struct tsch_asn_divisor_t size;
-  /* List of links belonging to this slotframe */
+  /* List of links belonging to this slotframe, sorted by timeslot */
   LIST_STRUCT(links_list);
+  /* Position and number of the links of this slotframe in the
+   * schedule index (see TSCH_SCHEDULE_WITH_INDEX) */
+  uint16_t index_start;
+  uint16_t index_len;
 };
 
 /** \brief TSCH packet information */
@@ -103,6 +107,10 @@ struct tsch_packet {
   uint8_t ret; /* status -- MAC return code */
   uint8_t header_len; /* length of header and header IEs (needed for link-layer security) */
   uint8_t tsch_sync_ie_offset; /* Offset within the frame used for quick update of EB ASN and join priority */
+#if TSCH_LINK_STATS_ACK_RSSI
+  int16_t ack_rssi; /* RSSI of the last ACK received, LINK_STATS_RSSI_UNKNOWN if none */
+  struct tsch_asn_t ack_asn; /* ASN when the ACK was received */
+#endif /* TSCH_LINK_STATS_ACK_RSSI */
 };
 
 /** \brief TSCH neighbor information */
@@ -151,6 +151,17 @@ unsigned long sync_count;
 int32_t min_drift_seen;
 int32_t max_drift_seen;
 
+/* Number of EBs transmitted since boot */
+unsigned long tsch_eb_sent_count;
+/* Start of the current scan, and sum of the join times since boot */
+static clock_time_t join_start_time;
+static clock_time_t join_time_total;
+#if TSCH_ADAPTIVE_EB_PERIOD
+/* link-stats churn counters at the time of the last EB */
+static uint16_t last_new_neighbor_count;
+static uint16_t last_falling_link_count;
+#endif /* TSCH_ADAPTIVE_EB_PERIOD */
+
 /* TSCH processes and protothreads */
 PT_THREAD(tsch_scan(struct pt *pt));
 PROCESS(tsch_process, "main process");
@@ -199,6 +210,12 @@ tsch_set_eb_period(uint32_t period)
   tsch_current_eb_period = MIN(period, TSCH_MAX_EB_PERIOD);
 }
 /*---------------------------------------------------------------------------*/
+clock_time_t
+tsch_get_mean_join_time(void)
+{
+  return tsch_association_count > 0 ? join_time_total / tsch_association_count : 0;
+}
+/*---------------------------------------------------------------------------*/
 static void
 tsch_reset(void)
 {
@@ -489,6 +506,17 @@ eb_input(struct input_packet *current_input)
   }
 }
 /*---------------------------------------------------------------------------*/
+/* Returns the time elapsed since a given ASN, in clock ticks. link-stats
+ * keeps its RSSI timestamps in clock ticks for all MACs, as RPL and PMAOF
+ * compare them with clock_time(): the ASN only dates the samples back to
+ * their slot */
+static clock_time_t
+asn_age(const struct tsch_asn_t *asn)
+{
+  uint64_t slots = TSCH_ASN_DIFF(tsch_current_asn, *asn);
+  return slots * tsch_timing_us[tsch_ts_timeslot_length] * CLOCK_SECOND / 1000000;
+}
+/*---------------------------------------------------------------------------*/
 /* Process pending input packet(s) */
 static void
 tsch_rx_process_pending()
@@ -508,6 +536,7 @@ tsch_rx_process_pending()
       /* Copy payload to packetbuf for processing */
       packetbuf_copyfrom(current_input->payload, current_input->len);
       packetbuf_set_attr(PACKETBUF_ATTR_RSSI, current_input->rssi);
+      packetbuf_set_attr(PACKETBUF_ATTR_RX_AGE, MIN(asn_age(&current_input->rx_asn), 0xffff));
       packetbuf_set_attr(PACKETBUF_ATTR_CHANNEL, current_input->channel);
 
       /* Pass to upper layers */
@@ -516,6 +545,7 @@ tsch_rx_process_pending()
     } else if(is_eb) {
       /* Don't pass to upper layers, but still count it in link stats */
       packetbuf_set_attr(PACKETBUF_ATTR_RSSI, current_input->rssi);
+      packetbuf_set_attr(PACKETBUF_ATTR_RX_AGE, MIN(asn_age(&current_input->rx_asn), 0xffff));
       packetbuf_set_attr(PACKETBUF_ATTR_CHANNEL, current_input->channel);
       link_stats_input_callback((const linkaddr_t *)frame.src_addr);
 
@@ -543,6 +573,13 @@ tsch_tx_process_pending(void)
     LOG_INFO_LLADDR(packetbuf_addr(PACKETBUF_ADDR_RECEIVER));
     LOG_INFO_(", seqno %u, status %d, tx %d\n",
       packetbuf_attr(PACKETBUF_ATTR_MAC_SEQNO), p->ret, p->transmissions);
+#if TSCH_LINK_STATS_ACK_RSSI
+    if(p->ack_rssi != LINK_STATS_RSSI_UNKNOWN) {
+      /* The ACK is one more RSSI sample of the link */
+      link_stats_rssi_callback(packetbuf_addr(PACKETBUF_ADDR_RECEIVER), p->ack_rssi,
+                               clock_time() - MIN(asn_age(&p->ack_asn), clock_time()));
+    }
+#endif /* TSCH_LINK_STATS_ACK_RSSI */
     /* Call packet_sent callback */
     mac_call_sent_callback(p->sent, p->ptr, p->ret, p->transmissions);
     /* Free packet queuebuf */
@@ -752,6 +789,10 @@ tsch_associate(const struct input_packet *input_eb, rtimer_clock_t timestamp)
 #endif
 
       tsch_association_count++;
+      join_time_total += clock_time() - join_start_time;
+      LOG_INFO("join time %lu ms, mean %lu ms\n",
+               (unsigned long)((clock_time() - join_start_time) * 1000 / CLOCK_SECOND),
+               (unsigned long)(tsch_get_mean_join_time() * 1000 / CLOCK_SECOND));
       LOG_INFO("association done (%u), sec %u, PAN ID %x, asn-%x.%"PRIx32", jp %u, timeslot id %u, hopping id %u, slotframe len %u with %u links, from ",
              tsch_association_count,
              tsch_is_pan_secured,
@@ -787,6 +828,7 @@ PT_THREAD(tsch_scan(struct pt *pt))
   static clock_time_t current_channel_since;
 
   TSCH_ASN_INIT(tsch_current_asn, 0, 0);
+  join_start_time = clock_time();
 
   etimer_set(&scan_timer, MAX(1, CLOCK_SECOND / TSCH_ASSOCIATION_POLL_FREQUENCY));
   current_channel_since = clock_time();
@@ -898,6 +940,40 @@ PROCESS_THREAD(tsch_process, ev, data)
   PROCESS_END();
 }
 
+/*---------------------------------------------------------------------------*/
+/* Called by the slot operation when an EB is sent */
+static void
+eb_sent(void *ptr, int status, int transmissions)
+{
+  if(transmissions > 0) {
+    tsch_eb_sent_count++;
+  }
+}
+#if TSCH_ADAPTIVE_EB_PERIOD
+/*---------------------------------------------------------------------------*/
+/* Adapts the EB period to the churn of the neighborhood since the last EB */
+static void
+adapt_eb_period(void)
+{
+  uint16_t new_neighbor_count = link_stats_new_neighbor_count();
+  uint16_t falling_link_count = link_stats_falling_link_count();
+
+  if(new_neighbor_count != last_new_neighbor_count
+     || falling_link_count != last_falling_link_count) {
+    /* Neighbors are coming or going: beacon fast */
+    tsch_current_eb_period = MIN(TSCH_ADAPTIVE_EB_MIN_PERIOD, TSCH_MAX_EB_PERIOD);
+  } else {
+    /* Stable neighborhood: slow down */
+    tsch_current_eb_period = MIN(2 * tsch_current_eb_period, TSCH_MAX_EB_PERIOD);
+  }
+  last_new_neighbor_count = new_neighbor_count;
+  last_falling_link_count = falling_link_count;
+
+  LOG_DBG("EB period %lu (new neighbors %u, falling links %u)\n",
+          (unsigned long)tsch_current_eb_period,
+          new_neighbor_count, falling_link_count);
+}
+#endif /* TSCH_ADAPTIVE_EB_PERIOD */
 /*---------------------------------------------------------------------------*/
 /* A periodic process to send TSCH Enhanced Beacons (EB) */
 PROCESS_THREAD(tsch_send_eb_process, ev, data)
@@ -944,7 +1020,7 @@ PROCESS_THREAD(tsch_send_eb_process, ev, data)
       if(tsch_packet_create_eb(&hdr_len, &tsch_sync_ie_offset) > 0) {
         struct tsch_packet *p;
         /* Enqueue EB packet, for a single transmission only */
-        if(!(p = tsch_queue_add_packet(&tsch_eb_address, 1, NULL, NULL))) {
+        if(!(p = tsch_queue_add_packet(&tsch_eb_address, 1, eb_sent, NULL))) {
           LOG_ERR("! could not enqueue EB packet\n");
         } else {
           LOG_INFO("TSCH: enqueue EB packet %u %u\n",
@@ -954,6 +1030,11 @@ PROCESS_THREAD(tsch_send_eb_process, ev, data)
         }
       }
     }
+#if TSCH_ADAPTIVE_EB_PERIOD
+    if(tsch_is_associated && tsch_current_eb_period > 0) {
+      adapt_eb_period();
+    }
+#endif /* TSCH_ADAPTIVE_EB_PERIOD */
     if(tsch_current_eb_period > 0) {
       /* Next EB transmission with a random delay
        * within [tsch_current_eb_period*0.75, tsch_current_eb_period[ */
@@ -1204,6 +1285,9 @@ turn_on(void)
 {
   if(tsch_is_initialized == 1 && tsch_is_started == 0) {
     tsch_is_started = 1;
+    process_set_priority(&tsch_pending_events_process, PROCESS_PRIO_NETWORK);
+    process_set_priority(&tsch_send_eb_process, PROCESS_PRIO_NETWORK);
+    process_set_priority(&tsch_process, PROCESS_PRIO_NETWORK);
     /* Process tx/rx callback and log messages whenever polled */
     process_start(&tsch_pending_events_process, NULL);
     if(TSCH_EB_PERIOD > 0) {
@@ -188,6 +188,8 @@ extern unsigned long rx_count;
 extern unsigned long sync_count;
 extern int32_t min_drift_seen;
 extern int32_t max_drift_seen;
+/* Number of EBs transmitted since boot */
+extern unsigned long tsch_eb_sent_count;
 /* The TSCH standard 10ms timeslot timing */
 extern const tsch_timeslot_timing_usec tsch_timeslot_timing_us_10000;
 
@@ -219,6 +221,13 @@ void tsch_set_join_priority(uint8_t jp);
  * \param period The period in Clock ticks.
  */
 void tsch_set_eb_period(uint32_t period);
+/**
+ * Get the mean time it took to join a TSCH network, from the start of a
+ * scan to the association, over all associations since boot.
+ *
+ * \return The mean join time, in clock ticks (0 if never associated)
+ */
+clock_time_t tsch_get_mean_join_time(void);
 /**
  * Set the desynchronization timeout after which a node sends a unicasst
  * keep-alive (KA) to its time source. Set to 0 to stop sending KAs. The
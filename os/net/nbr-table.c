@@ -70,6 +70,19 @@ static unsigned num_tables;
 MEMB(neighbor_addr_mem, nbr_table_key_t, NBR_TABLE_MAX_NEIGHBORS);
 LIST(nbr_table_keys);
 
+#if NBR_TABLE_WITH_LOOKUP_INDEX
+/* Neighbor indexes are stored plus one, so that zero means "none" */
+#if NBR_TABLE_MAX_NEIGHBORS < 0xff
+typedef uint8_t lookup_index_t;
+#else
+typedef uint16_t lookup_index_t;
+#endif
+/* For each bucket, the first neighbor whose address hashes to it */
+static lookup_index_t lookup_head[NBR_TABLE_LOOKUP_INDEX_SIZE];
+/* For each neighbor, the next neighbor in the same bucket */
+static lookup_index_t lookup_next[NBR_TABLE_MAX_NEIGHBORS];
+#endif /* NBR_TABLE_WITH_LOOKUP_INDEX */
+
 /*---------------------------------------------------------------------------*/
 static void remove_key(nbr_table_key_t *key, bool do_free);
 /*---------------------------------------------------------------------------*/
@@ -115,16 +128,65 @@ key_from_item(const nbr_table_t *table, const nbr_table_item_t *item)
   return key_from_index(index_from_item(table, item));
 }
 /*---------------------------------------------------------------------------*/
+#if NBR_TABLE_WITH_LOOKUP_INDEX
+/* Get the lookup index bucket of a link-layer address */
+static unsigned
+lookup_bucket(const linkaddr_t *lladdr)
+{
+  unsigned hash = 0;
+  int i;
+  for(i = 0; i < LINKADDR_SIZE; i++) {
+    hash = hash * 31 + lladdr->u8[i];
+  }
+  return hash % NBR_TABLE_LOOKUP_INDEX_SIZE;
+}
+/*---------------------------------------------------------------------------*/
+/* Add a key, whose address is already set, to the lookup index */
+static void
+lookup_index_add(const nbr_table_key_t *key)
+{
+  int index = index_from_key(key);
+  unsigned bucket = lookup_bucket(&key->lladdr);
+  lookup_next[index] = lookup_head[bucket];
+  lookup_head[bucket] = index + 1;
+}
+/*---------------------------------------------------------------------------*/
+/* Remove a key from the lookup index */
+static void
+lookup_index_remove(const nbr_table_key_t *key)
+{
+  lookup_index_t target = index_from_key(key) + 1;
+  lookup_index_t *link = &lookup_head[lookup_bucket(&key->lladdr)];
+  while(*link != 0) {
+    if(*link == target) {
+      *link = lookup_next[target - 1];
+      lookup_next[target - 1] = 0;
+      return;
+    }
+    link = &lookup_next[*link - 1];
+  }
+}
+#endif /* NBR_TABLE_WITH_LOOKUP_INDEX */
+/*---------------------------------------------------------------------------*/
 /* Get the index of a neighbor from its link-layer address */
 static int
 index_from_lladdr(const linkaddr_t *lladdr)
 {
-  nbr_table_key_t *key;
   /* Allow lladdr-free insertion, useful e.g. for IPv6 ND.
    * Only one such entry is possible at a time, indexed by linkaddr_null. */
   if(lladdr == NULL) {
     lladdr = &linkaddr_null;
   }
+#if NBR_TABLE_WITH_LOOKUP_INDEX
+  lookup_index_t i = lookup_head[lookup_bucket(lladdr)];
+  while(i != 0) {
+    if(linkaddr_cmp(lladdr, &key_from_index(i - 1)->lladdr)) {
+      return i - 1;
+    }
+    i = lookup_next[i - 1];
+  }
+#else /* NBR_TABLE_WITH_LOOKUP_INDEX */
+  nbr_table_key_t *key;
   key = list_head(nbr_table_keys);
   while(key != NULL) {
     if(lladdr && linkaddr_cmp(lladdr, &key->lladdr)) {
@@ -132,6 +194,7 @@ index_from_lladdr(const linkaddr_t *lladdr)
     }
     key = list_item_next(key);
   }
+#endif /* NBR_TABLE_WITH_LOOKUP_INDEX */
   return -1;
 }
 /*---------------------------------------------------------------------------*/
@@ -186,6 +249,9 @@ remove_key(nbr_table_key_t *key, bool do_free)
   used_map[index_from_key(key)] = 0;
   locked_map[index_from_key(key)] = 0;
   /* Remove neighbor from list */
+#if NBR_TABLE_WITH_LOOKUP_INDEX
+  lookup_index_remove(key);
+#endif /* NBR_TABLE_WITH_LOOKUP_INDEX */
   list_remove(nbr_table_keys, key);
   if(do_free) {
     /* Release the memory */
@@ -434,6 +500,9 @@ nbr_table_add_lladdr(const nbr_table_t *table, const linkaddr_t *lladdr,
 
     /* Set link-layer address */
     linkaddr_copy(&key->lladdr, lladdr);
+#if NBR_TABLE_WITH_LOOKUP_INDEX
+    lookup_index_add(key);
+#endif /* NBR_TABLE_WITH_LOOKUP_INDEX */
   }
 
   /* Get item in the current table */
@@ -496,6 +565,26 @@ nbr_table_get_lladdr(const nbr_table_t *table, const void *item)
   return key != NULL ? &key->lladdr : NULL;
 }
 /*---------------------------------------------------------------------------*/
+/* Get the index of an item, shared by all tables */
+int
+nbr_table_get_index(const nbr_table_t *table, const nbr_table_item_t *item)
+{
+  return index_from_item(table, item);
+}
+/*---------------------------------------------------------------------------*/
+/* Get the item at a given index, if it is in use in the table */
+nbr_table_item_t *
+nbr_table_get_from_index(const nbr_table_t *table, int index)
+{
+  nbr_table_item_t *item;
+
+  if(index < 0 || index >= NBR_TABLE_MAX_NEIGHBORS) {
+    return NULL;
+  }
+  item = item_from_index(table, index);
+  return nbr_get_bit(used_map, table, item) ? item : NULL;
+}
+/*---------------------------------------------------------------------------*/
 void
 nbr_table_clear(void)
 {
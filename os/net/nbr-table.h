@@ -55,6 +55,21 @@ typedef enum {
 
 #define NBR_TABLE_MAX_NEIGHBORS NBR_TABLE_CONF_MAX_NEIGHBORS
 
+/* Keep a hash index of the link-layer addresses, so that looking up a
+ * neighbor does not require walking the whole list of keys */
+#ifdef NBR_TABLE_CONF_WITH_LOOKUP_INDEX
+#define NBR_TABLE_WITH_LOOKUP_INDEX NBR_TABLE_CONF_WITH_LOOKUP_INDEX
+#else /* NBR_TABLE_CONF_WITH_LOOKUP_INDEX */
+#define NBR_TABLE_WITH_LOOKUP_INDEX 0
+#endif /* NBR_TABLE_CONF_WITH_LOOKUP_INDEX */
+
+/* Number of buckets of the lookup index */
+#ifdef NBR_TABLE_CONF_LOOKUP_INDEX_SIZE
+#define NBR_TABLE_LOOKUP_INDEX_SIZE NBR_TABLE_CONF_LOOKUP_INDEX_SIZE
+#else /* NBR_TABLE_CONF_LOOKUP_INDEX_SIZE */
+#define NBR_TABLE_LOOKUP_INDEX_SIZE NBR_TABLE_MAX_NEIGHBORS
+#endif /* NBR_TABLE_CONF_LOOKUP_INDEX_SIZE */
+
 #ifdef NBR_TABLE_CONF_GC_GET_WORST
 #define NBR_TABLE_GC_GET_WORST NBR_TABLE_CONF_GC_GET_WORST
 #else /* NBR_TABLE_CONF_GC_GET_WORST */
@@ -125,6 +140,10 @@ nbr_table_item_t *nbr_table_add_lladdr(const nbr_table_t *table,
                                        const void *data);
 nbr_table_item_t *nbr_table_get_from_lladdr(const nbr_table_t *table,
                                             const linkaddr_t *lladdr);
+int nbr_table_get_index(const nbr_table_t *table,
+                        const nbr_table_item_t *item);
+nbr_table_item_t *nbr_table_get_from_index(const nbr_table_t *table,
+                                           int index);
 /** @} */
 
 /** \name Neighbor tables: set flags (unused, locked, unlocked) */
@@ -217,6 +217,9 @@ enum {
   PACKETBUF_ATTR_NETWORK_ID,
   PACKETBUF_ATTR_LINK_QUALITY,
   PACKETBUF_ATTR_RSSI,
+#if MAC_CONF_WITH_TSCH
+  PACKETBUF_ATTR_RX_AGE, /* clock ticks elapsed since the reception */
+#endif /* MAC_CONF_WITH_TSCH */
   PACKETBUF_ATTR_MAX_MAC_TRANSMISSIONS,
   PACKETBUF_ATTR_MAC_SEQNO,
   PACKETBUF_ATTR_MAC_ACK,
@@ -231,6 +234,7 @@ enum {
 
   /* Scope 1 attributes: used between two neighbors only. */
   PACKETBUF_ATTR_FRAME_TYPE,
+  PACKETBUF_ATTR_PENDING, /* 802.15.4 frame pending bit */
 #if LLSEC802154_USES_AUX_HEADER
   PACKETBUF_ATTR_SECURITY_LEVEL,
 #endif /* LLSEC802154_USES_AUX_HEADER */
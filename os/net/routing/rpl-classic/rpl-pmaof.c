@@ -50,6 +50,7 @@
 #include "net/routing/rpl-classic/rpl-private.h"
 #include "net/nbr-table.h"
 #include "net/link-stats.h"
+#include "sys/profile.h"
 
 #include "sys/log.h"
 
@@ -178,6 +179,8 @@
 #endif /* !RPL_MRHOF_SQUARED_ETX */
 #endif /* RPL_DAG_MC == RPL_DAG_MC_SSV */
 
+PROFILE_PROBE(link_metric_probe, "parent_link_metric");
+
 /*---------------------------------------------------------------------------*/
 #if RPL_WITH_PMAOF
 static uint16_t
@@ -248,7 +251,7 @@ dao_ack_callback(rpl_parent_t *p, int status)
 #endif /* RPL_WITH_DAO_ACK */
 /*---------------------------------------------------------------------------*/
 static uint16_t
-parent_link_metric(rpl_parent_t *p)
+compute_link_metric(rpl_parent_t *p)
 {
   const struct link_stats *stats = rpl_get_parent_link_stats(p);
   if(stats != NULL) {
@@ -371,6 +374,17 @@ parent_link_metric(rpl_parent_t *p)
   return 0xffff;
 }
 /*---------------------------------------------------------------------------*/
+static uint16_t
+parent_link_metric(rpl_parent_t *p)
+{
+  uint16_t metric;
+
+  PROFILE_BEGIN(link_metric_probe);
+  metric = compute_link_metric(p);
+  PROFILE_END(link_metric_probe);
+  return metric;
+}
+/*---------------------------------------------------------------------------*/
 #if RPL_WITH_MC
 static uint8_t
 parent_hop_count(rpl_parent_t *p)
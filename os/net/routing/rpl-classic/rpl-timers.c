@@ -44,6 +44,7 @@
 #include "net/link-stats.h"
 #include "net/ipv6/multicast/uip-mcast6.h"
 #include "net/ipv6/uip-sr.h"
+#include "net/ipv6/uip-ds6-maint.h"
 #include "lib/random.h"
 #include "sys/ctimer.h"
 #include "sys/log.h"
@@ -65,7 +66,12 @@ clock_time_t RPL_PROBING_DELAY_FUNC(rpl_dag_t *dag);
 #endif /* RPL_PROBING_DELAY_FUNC */
 
 /*---------------------------------------------------------------------------*/
+#if UIP_DS6_WITH_MAINT
+/* Run by the uip-ds6 maintenance scheduler, together with its sweeps */
+static uip_ds6_maint_task_t periodic_task;
+#else /* UIP_DS6_WITH_MAINT */
 static struct ctimer periodic_timer;
+#endif /* UIP_DS6_WITH_MAINT */
 
 static void handle_periodic_timer(void *ptr);
 static void new_dio_interval(rpl_instance_t *instance);
@@ -102,8 +108,18 @@ handle_periodic_timer(void *ptr)
     dis_output(NULL);
   }
 #endif
+#if !UIP_DS6_WITH_MAINT
   ctimer_reset(&periodic_timer);
+#endif /* !UIP_DS6_WITH_MAINT */
 }
+#if UIP_DS6_WITH_MAINT
+/*---------------------------------------------------------------------------*/
+static void
+periodic_sweep(void)
+{
+  handle_periodic_timer(NULL);
+}
+#endif /* UIP_DS6_WITH_MAINT */
 /*---------------------------------------------------------------------------*/
 static void
 new_dio_interval(rpl_instance_t *instance)
@@ -207,7 +223,12 @@ rpl_reset_periodic_timer(void)
   next_dis = RPL_DIS_INTERVAL / 2 +
     ((uint32_t)RPL_DIS_INTERVAL * (uint32_t)random_rand()) / RANDOM_RAND_MAX -
     RPL_DIS_START_DELAY;
+#if UIP_DS6_WITH_MAINT
+  uip_ds6_maint_add(&periodic_task, CLOCK_SECOND, periodic_sweep, NULL);
+#else /* UIP_DS6_WITH_MAINT */
   ctimer_set(&periodic_timer, CLOCK_SECOND, handle_periodic_timer, NULL);
+  ctimer_set_slack(&periodic_timer, ETIMER_PERIODIC_SLACK(CLOCK_SECOND));
+#endif /* UIP_DS6_WITH_MAINT */
 }
 /*---------------------------------------------------------------------------*/
 /* Resets the DIO timer in the instance to its minimal interval. */
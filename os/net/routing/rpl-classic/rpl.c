@@ -292,6 +292,38 @@ rpl_link_callback(const linkaddr_t *addr, int status, int numtx)
 }
 /*---------------------------------------------------------------------------*/
 void
+rpl_link_early_drop_callback(const linkaddr_t *addr)
+{
+  uip_ipaddr_t ipaddr;
+  rpl_parent_t *parent;
+  rpl_instance_t *instance;
+  rpl_instance_t *end;
+  int reselect = 0;
+
+  uip_ip6addr(&ipaddr, 0xfe80, 0, 0, 0, 0, 0, 0, 0);
+  uip_ds6_set_addr_iid(&ipaddr, (uip_lladdr_t *)addr);
+
+  for(instance = &instance_table[0], end = instance + RPL_MAX_INSTANCES; instance < end; ++instance) {
+    if(instance->used == 1) {
+      parent = rpl_find_parent_any_dag(instance, &ipaddr);
+      if(parent != NULL && parent == parent->dag->preferred_parent) {
+        /* The MAC layer gave up early on the link to our preferred parent:
+           reconsider it now rather than at the next periodic check. */
+        LOG_INFO("early drop on link to preferred parent ");
+        LOG_INFO_6ADDR(&ipaddr);
+        LOG_INFO_(", reselecting\n");
+        parent->flags |= RPL_PARENT_FLAG_UPDATED;
+        reselect = 1;
+      }
+    }
+  }
+
+  if(reselect) {
+    rpl_recalculate_ranks();
+  }
+}
+/*---------------------------------------------------------------------------*/
+void
 rpl_ipv6_neighbor_callback(uip_ds6_nbr_t *nbr)
 {
   rpl_parent_t *p;
@@ -314,6 +314,7 @@ void rpl_print_neighbor_list(void);
 int rpl_ext_header_srh_update(void);
 int rpl_ext_header_srh_get_next_hop(uip_ipaddr_t *ipaddr);
 void rpl_link_callback(const linkaddr_t *addr, int status, int numtx);
+void rpl_link_early_drop_callback(const linkaddr_t *addr);
 /* Per-parent RPL information */
 NBR_TABLE_DECLARE(rpl_parents);
 
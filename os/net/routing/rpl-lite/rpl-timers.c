@@ -505,6 +505,7 @@ void
 rpl_timers_init(void)
 {
   ctimer_set(&periodic_timer, PERIODIC_DELAY, handle_periodic_timer, NULL);
+  ctimer_set_slack(&periodic_timer, ETIMER_PERIODIC_SLACK(PERIODIC_DELAY));
   rpl_timers_schedule_periodic_dis();
 }
 /*---------------------------------------------------------------------------*/
@@ -163,4 +163,44 @@
 #define ORCHESTRA_EB_MAX_CHANNEL_OFFSET 1
 #endif
 
+/* Use the PMAOF link prediction (SSV/SSR in link-stats) of the time source
+ * link to pre-install cells toward the likely next RPL parent, and to
+ * switch the time source to it before the current link is lost.
+ * Requires RPL classic. Default: 0 */
+#ifdef ORCHESTRA_CONF_HANDOVER_PREDICTION
+#define ORCHESTRA_HANDOVER_PREDICTION ORCHESTRA_CONF_HANDOVER_PREDICTION
+#else
+#define ORCHESTRA_HANDOVER_PREDICTION 0
+#endif
+
+/* Period of the time source link check */
+#ifdef ORCHESTRA_CONF_HANDOVER_CHECK_PERIOD
+#define ORCHESTRA_HANDOVER_CHECK_PERIOD ORCHESTRA_CONF_HANDOVER_CHECK_PERIOD
+#else
+#define ORCHESTRA_HANDOVER_CHECK_PERIOD CLOCK_SECOND
+#endif
+
+/* A handover is predicted when the SSV of the time source link (RSSI
+ * slope, scaled as in PMAOF) is below this value... */
+#ifdef ORCHESTRA_CONF_HANDOVER_SSV
+#define ORCHESTRA_HANDOVER_SSV ORCHESTRA_CONF_HANDOVER_SSV
+#else
+#define ORCHESTRA_HANDOVER_SSV -100
+#endif
+
+/* ...and its SSR (remaining RSSI margin, in dB) is below this value */
+#ifdef ORCHESTRA_CONF_HANDOVER_SSR
+#define ORCHESTRA_HANDOVER_SSR ORCHESTRA_CONF_HANDOVER_SSR
+#else
+#define ORCHESTRA_HANDOVER_SSR 20
+#endif
+
+/* The time source is switched to the predicted neighbor when the SSR of
+ * the time source link falls below this value */
+#ifdef ORCHESTRA_CONF_HANDOVER_SWITCH_SSR
+#define ORCHESTRA_HANDOVER_SWITCH_SSR ORCHESTRA_CONF_HANDOVER_SWITCH_SSR
+#else
+#define ORCHESTRA_HANDOVER_SWITCH_SSR 10
+#endif
+
 #endif /* ORCHESTRA_CONF_H_ */
@@ -44,6 +44,9 @@ static uint16_t slotframe_handle = 0;
 static uint16_t channel_offset = 0;
 static struct tsch_slotframe *sf_eb;
 static struct tsch_link *timesource_link;
+#if ORCHESTRA_HANDOVER_PREDICTION
+static struct tsch_link *handover_link;
+#endif /* ORCHESTRA_HANDOVER_PREDICTION */
 
 /*---------------------------------------------------------------------------*/
 static uint16_t
@@ -108,6 +111,16 @@ new_time_source(const struct tsch_neighbor *old, const struct tsch_neighbor *new
     const linkaddr_t *addr = tsch_queue_get_nbr_address(new);
     new_ts = get_node_timeslot(addr);
     new_channel_offset = get_node_channel_offset(addr);
+#if ORCHESTRA_HANDOVER_PREDICTION
+    if(new != old && linkaddr_cmp(addr, &orchestra_handover_linkaddr)) {
+      /* We already listen to the new time source's EBs: keep listening
+       * to the old one's until the prediction is withdrawn */
+      struct tsch_link *l = timesource_link;
+      timesource_link = handover_link;
+      handover_link = l;
+      return;
+    }
+#endif /* ORCHESTRA_HANDOVER_PREDICTION */
   }
 
   if(new_ts == old_ts && old_channel_offset == new_channel_offset) {
@@ -125,6 +138,22 @@ new_time_source(const struct tsch_neighbor *old, const struct tsch_neighbor *new
         &tsch_broadcast_address, new_ts, new_channel_offset, 0);
   }
 }
+#if ORCHESTRA_HANDOVER_PREDICTION
+/*---------------------------------------------------------------------------*/
+static void
+handover_predicted(const linkaddr_t *addr)
+{
+  if(handover_link != NULL) {
+    tsch_schedule_remove_link(sf_eb, handover_link);
+    handover_link = NULL;
+  }
+  if(addr != NULL && get_node_timeslot(addr) != 0xffff) {
+    /* Listen to the likely next time source's EBs too */
+    handover_link = tsch_schedule_add_link(sf_eb, LINK_OPTION_RX, LINK_TYPE_ADVERTISING_ONLY,
+        &tsch_broadcast_address, get_node_timeslot(addr), get_node_channel_offset(addr), 0);
+  }
+}
+#endif /* ORCHESTRA_HANDOVER_PREDICTION */
 /*---------------------------------------------------------------------------*/
 static void
 init(uint16_t sf_handle)
@@ -149,6 +178,11 @@ struct orchestra_rule eb_per_time_source = {
   NULL,
   NULL,
   NULL,
+#if ORCHESTRA_HANDOVER_PREDICTION
+  handover_predicted,
+#else /* ORCHESTRA_HANDOVER_PREDICTION */
+  NULL,
+#endif /* ORCHESTRA_HANDOVER_PREDICTION */
   "EB per time source",
   ORCHESTRA_EBSF_PERIOD,
 };
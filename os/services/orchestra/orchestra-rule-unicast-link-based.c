@@ -218,6 +218,7 @@ struct orchestra_rule unicast_per_neighbor_link_based = {
   child_removed,
   NULL,
   NULL,
+  NULL,
   "unicast per neighbor link based",
   ORCHESTRA_UNICAST_PERIOD,
 };
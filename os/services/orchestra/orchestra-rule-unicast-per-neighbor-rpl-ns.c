@@ -135,10 +135,42 @@ new_time_source(const struct tsch_neighbor *old, const struct tsch_neighbor *new
   if(new != old) {
     const linkaddr_t *old_addr = tsch_queue_get_nbr_address(old);
     const linkaddr_t *new_addr = tsch_queue_get_nbr_address(new);
+#if ORCHESTRA_HANDOVER_PREDICTION
+    if(new_addr != NULL && linkaddr_cmp(new_addr, &orchestra_handover_linkaddr)) {
+      /* The new time source's cell is already installed: keep the old
+       * one's, and its packets, until the prediction is withdrawn */
+      return;
+    }
+#endif /* ORCHESTRA_HANDOVER_PREDICTION */
     remove_uc_link(old_addr);
     add_uc_link(new_addr);
   }
 }
+#if ORCHESTRA_HANDOVER_PREDICTION
+/*---------------------------------------------------------------------------*/
+/* Returns nonzero if the node still uses the cell toward a neighbor: the
+ * neighbor is the time source, or a neighbor in the DS6 neighbor table */
+static int
+uc_link_in_use(const linkaddr_t *linkaddr)
+{
+  const struct tsch_neighbor *ts = tsch_queue_get_time_source();
+  return (ts != NULL && linkaddr_cmp(linkaddr, tsch_queue_get_nbr_address(ts)))
+      || uip_ds6_nbr_ll_lookup((const uip_lladdr_t *)linkaddr) != NULL;
+}
+/*---------------------------------------------------------------------------*/
+static void
+handover_predicted(const linkaddr_t *addr)
+{
+  /* Replace the cell toward the previously predicted neighbor. If the node
+   * still uses that cell, keep it: neighbor_updated() removes it when the
+   * neighbor goes away */
+  if(!linkaddr_cmp(&orchestra_handover_linkaddr, &linkaddr_null)
+     && !uc_link_in_use(&orchestra_handover_linkaddr)) {
+    remove_uc_link(&orchestra_handover_linkaddr);
+  }
+  add_uc_link(addr);
+}
+#endif /* ORCHESTRA_HANDOVER_PREDICTION */
 /*---------------------------------------------------------------------------*/
 static void
 init(uint16_t sf_handle)
@@ -165,6 +197,11 @@ struct orchestra_rule unicast_per_neighbor_rpl_ns = {
   NULL,
   neighbor_updated,
   NULL,
+#if ORCHESTRA_HANDOVER_PREDICTION
+  handover_predicted,
+#else /* ORCHESTRA_HANDOVER_PREDICTION */
+  NULL,
+#endif /* ORCHESTRA_HANDOVER_PREDICTION */
   "unicast per neighbor non-storing",
   ORCHESTRA_UNICAST_PERIOD,
 };
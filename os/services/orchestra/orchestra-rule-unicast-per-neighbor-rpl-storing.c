@@ -260,6 +260,7 @@ struct orchestra_rule unicast_per_neighbor_rpl_storing = {
   child_removed,
   NULL,
   NULL,
+  NULL,
   "unicast per neighbor storing",
   ORCHESTRA_UNICAST_PERIOD,
 };
@@ -40,6 +40,7 @@
 #include "orchestra.h"
 #include "net/packetbuf.h"
 #include "net/ipv6/uip-icmp6.h"
+#include "net/link-stats.h"
 #include "net/routing/routing.h"
 #if ROUTING_CONF_RPL_LITE
 #include "net/routing/rpl-lite/rpl.h"
@@ -62,6 +63,16 @@ linkaddr_t orchestra_parent_linkaddr;
 /* Set to one only after getting an ACK for a DAO sent to our preferred parent */
 int orchestra_parent_knows_us = 0;
 
+#if ORCHESTRA_HANDOVER_PREDICTION
+#if !ROUTING_CONF_RPL_CLASSIC
+#error "ORCHESTRA_CONF_HANDOVER_PREDICTION requires RPL classic"
+#endif /* !ROUTING_CONF_RPL_CLASSIC */
+/* The neighbor toward which the rules hold pre-installed cells */
+linkaddr_t orchestra_handover_linkaddr;
+/* Periodic check of the time source link */
+static struct ctimer handover_timer;
+#endif /* ORCHESTRA_HANDOVER_PREDICTION */
+
 /* The set of Orchestra rules in use */
 const struct orchestra_rule *all_rules[] = ORCHESTRA_RULES;
 #define NUM_RULES (sizeof(all_rules) / sizeof(struct orchestra_rule *))
@@ -164,6 +175,12 @@ orchestra_callback_new_time_source(const struct tsch_neighbor *old, const struct
    * */
 
   int i;
+#if ORCHESTRA_HANDOVER_PREDICTION
+  /* Switching to the neighbor with pre-installed cells? */
+  int to_handover = new != old && new != NULL
+      && linkaddr_cmp(tsch_queue_get_nbr_address(new), &orchestra_handover_linkaddr);
+#endif /* ORCHESTRA_HANDOVER_PREDICTION */
+
   if(new != old) {
     orchestra_parent_knows_us = 0;
   }
@@ -172,7 +189,115 @@ orchestra_callback_new_time_source(const struct tsch_neighbor *old, const struct
       all_rules[i]->new_time_source(old, new);
     }
   }
+
+#if ORCHESTRA_HANDOVER_PREDICTION
+  if(to_handover) {
+    /* The rules kept the pre-installed cells for the new time source; the
+     * old time source now holds the extra cells */
+    linkaddr_copy(&orchestra_handover_linkaddr,
+                  old != NULL ? tsch_queue_get_nbr_address(old) : &linkaddr_null);
+  }
+#endif /* ORCHESTRA_HANDOVER_PREDICTION */
+}
+#if ORCHESTRA_HANDOVER_PREDICTION
+/*---------------------------------------------------------------------------*/
+static void
+set_handover(const linkaddr_t *addr)
+{
+  int i;
+
+  if(addr == NULL) {
+    addr = &linkaddr_null;
+  }
+  if(linkaddr_cmp(addr, &orchestra_handover_linkaddr)) {
+    return;
+  }
+
+  LOG_INFO("handover cells toward ");
+  LOG_INFO_LLADDR(addr);
+  LOG_INFO_("\n");
+
+  /* The rules find the neighbor they are replacing in orchestra_handover_linkaddr */
+  for(i = 0; i < NUM_RULES; i++) {
+    if(all_rules[i]->handover_predicted != NULL) {
+      all_rules[i]->handover_predicted(linkaddr_cmp(addr, &linkaddr_null) ? NULL : addr);
+    }
+  }
+  linkaddr_copy(&orchestra_handover_linkaddr, addr);
+}
+/*---------------------------------------------------------------------------*/
+/* Returns nonzero if PMAOF predicts the loss of the link: its RSSI is
+ * falling fast and little margin is left */
+static int
+link_is_falling(const struct link_stats *stats, int ssr)
+{
+  return stats != NULL
+      && stats->last_ssv != fix16_minimum
+      && fix16_to_int(stats->last_ssv) < ORCHESTRA_HANDOVER_SSV
+      && fix16_to_int(stats->last_ssr) < ssr;
+}
+/*---------------------------------------------------------------------------*/
+/* The parent RPL would pick if the preferred parent was gone */
+static rpl_parent_t *
+predict_next_parent(rpl_dag_t *dag)
+{
+  rpl_parent_t *p;
+  rpl_parent_t *best = NULL;
+
+  for(p = nbr_table_head(rpl_parents); p != NULL; p = nbr_table_next(rpl_parents, p)) {
+    if(p == dag->preferred_parent || p->dag != dag || p->rank == RPL_INFINITE_RANK
+       || link_is_falling(rpl_get_parent_link_stats(p), ORCHESTRA_HANDOVER_SSR)) {
+      continue;
+    }
+    best = dag->instance->of->best_parent(best, p);
+  }
+  return best;
+}
+/*---------------------------------------------------------------------------*/
+static void
+handover_check(void *ptr)
+{
+  struct tsch_neighbor *ts = tsch_queue_get_time_source();
+  rpl_dag_t *dag = rpl_get_any_dag();
+  const struct link_stats *stats;
+  const linkaddr_t *ts_addr;
+  const linkaddr_t *parent_addr;
+  const linkaddr_t *next = NULL;
+
+  ctimer_reset(&handover_timer);
+
+  if(ts == NULL || dag == NULL || dag->preferred_parent == NULL) {
+    set_handover(NULL);
+    return;
+  }
+
+  ts_addr = tsch_queue_get_nbr_address(ts);
+  parent_addr = rpl_get_parent_lladdr(dag->preferred_parent);
+  if(parent_addr != NULL && !linkaddr_cmp(parent_addr, ts_addr)) {
+    /* The time source was switched ahead of RPL: keep cells toward the
+     * preferred parent until RPL follows */
+    set_handover(parent_addr);
+    return;
+  }
+
+  stats = link_stats_from_lladdr(ts_addr);
+  if(link_is_falling(stats, ORCHESTRA_HANDOVER_SSR)) {
+    rpl_parent_t *p = predict_next_parent(dag);
+    if(p != NULL) {
+      next = rpl_get_parent_lladdr(p);
+    }
+  }
+  set_handover(next);
+
+  if(next != NULL && link_is_falling(stats, ORCHESTRA_HANDOVER_SWITCH_SSR)) {
+    /* Re-synchronize on the next parent before losing the current one */
+    LOG_INFO("early time source switch to ");
+    LOG_INFO_LLADDR(next);
+    LOG_INFO_("\n");
+    tsch_queue_update_time_source(next);
+  }
 }
+#endif /* ORCHESTRA_HANDOVER_PREDICTION */
 /*---------------------------------------------------------------------------*/
 void
 orchestra_callback_root_node_updated(const linkaddr_t *root, uint8_t is_added)
@@ -201,5 +326,9 @@ orchestra_init(void)
       all_rules[i]->init(i);
     }
   }
+#if ORCHESTRA_HANDOVER_PREDICTION
+  linkaddr_copy(&orchestra_handover_linkaddr, &linkaddr_null);
+  ctimer_set(&handover_timer, ORCHESTRA_HANDOVER_CHECK_PERIOD, handover_check, NULL);
+#endif /* ORCHESTRA_HANDOVER_PREDICTION */
   LOG_INFO("Initialization done\n");
 }
@@ -50,6 +50,10 @@ struct orchestra_rule {
   void (* child_removed)(const linkaddr_t *addr);
   void (* neighbor_updated)(const linkaddr_t *addr, uint8_t is_added);
   void (* root_node_updated)(const linkaddr_t *addr, uint8_t is_added);
+  /* Pre-install cells toward the likely next time source (NULL: withdraw
+   * them). When the time source later switches to that neighbor, the cells
+   * are kept and the old time source takes its place until withdrawn. */
+  void (* handover_predicted)(const linkaddr_t *addr);
   const char *const name;
   const int16_t slotframe_size;
 };
@@ -63,6 +67,10 @@ extern struct orchestra_rule default_common;
 
 extern linkaddr_t orchestra_parent_linkaddr;
 extern int orchestra_parent_knows_us;
+#if ORCHESTRA_HANDOVER_PREDICTION
+/* The neighbor with pre-installed cells, or linkaddr_null */
+extern linkaddr_t orchestra_handover_linkaddr;
+#endif /* ORCHESTRA_HANDOVER_PREDICTION */
 
 /* Call from application to start Orchestra */
 void orchestra_init(void);
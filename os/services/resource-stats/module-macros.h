@@ -0,0 +1,4 @@
+#define BUILD_WITH_RESOURCE_STATS 1
+#define MEMB_CONF_WITH_STATS 1
+#define HEAPMEM_CONF_WITH_STATS 1
+#define PROCESS_CONF_STATS 1
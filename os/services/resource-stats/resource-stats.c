@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * \addtogroup resource-stats
+ * @{
+ */
+
+/**
+ * \file
+ *         Resource high-water marks and allocation failures
+ */
+
+#include "contiki.h"
+#include "lib/memb.h"
+#include "lib/heapmem.h"
+#include "sys/stack-check.h"
+#include "resource-stats.h"
+
+#include <stdio.h>
+
+/* Log configuration */
+#include "sys/log.h"
+#define LOG_MODULE "Resources"
+#define LOG_LEVEL LOG_LEVEL_INFO
+
+#if PROCESS_WITH_PRIORITIES
+#define EVENTS_SIZE (PROCESS_NUMEVENTS_APPLICATION + PROCESS_NUMEVENTS_NETWORK + \
+                     PROCESS_NUMEVENTS_SYSTEM)
+#else /* PROCESS_WITH_PRIORITIES */
+#define EVENTS_SIZE PROCESS_CONF_NUMEVENTS
+#endif /* PROCESS_WITH_PRIORITIES */
+
+PROCESS(resource_stats_process, "Resource stats");
+/*---------------------------------------------------------------------------*/
+static void
+report_line(void (*output)(const char *str), const char *prefix,
+            const char *name, unsigned long max, unsigned long size,
+            unsigned long failed)
+{
+  char buf[80];
+
+  snprintf(buf, sizeof(buf), "pool %s%s: max=%lu size=%lu failed=%lu\n",
+           prefix, name, max, size, failed);
+  output(buf);
+}
+/*---------------------------------------------------------------------------*/
+void
+resource_stats_report(void (*output)(const char *str))
+{
+#if MEMB_WITH_STATS
+  struct memb *m;
+#endif /* MEMB_WITH_STATS */
+#if HEAPMEM_WITH_STATS && defined(HEAPMEM_CONF_ARENA_SIZE)
+  heapmem_zone_stats_t zone_stats;
+  heapmem_zone_t zone;
+#endif /* HEAPMEM_WITH_STATS && defined(HEAPMEM_CONF_ARENA_SIZE) */
+#if STACK_CHECK_ENABLED
+  int32_t stack_usage, stack_size;
+#endif /* STACK_CHECK_ENABLED */
+
+#if MEMB_WITH_STATS
+  for(m = memb_pools(); m != NULL; m = m->next_pool) {
+    report_line(output, "", m->label, m->maxused, m->num, m->nfailed);
+  }
+#endif /* MEMB_WITH_STATS */
+
+#if HEAPMEM_WITH_STATS && defined(HEAPMEM_CONF_ARENA_SIZE)
+  for(zone = HEAPMEM_ZONE_GENERAL; heapmem_zone_stats(zone, &zone_stats);
+      zone++) {
+    report_line(output, "heap-", zone_stats.name, zone_stats.max_allocated,
+                zone_stats.zone_size, zone_stats.nfailed);
+  }
+#endif /* HEAPMEM_WITH_STATS && defined(HEAPMEM_CONF_ARENA_SIZE) */
+
+#if PROCESS_CONF_STATS
+  report_line(output, "", "events", process_maxevents, EVENTS_SIZE,
+              process_ndropped);
+#endif /* PROCESS_CONF_STATS */
+
+#if STACK_CHECK_ENABLED
+  /* A stack used up to its end counts as a failure */
+  stack_usage = stack_check_get_usage();
+  stack_size = stack_check_get_reserved_size();
+  report_line(output, "", "stack", stack_usage < 0 ? stack_size : stack_usage,
+              stack_size, stack_usage < 0);
+#endif /* STACK_CHECK_ENABLED */
+}
+/*---------------------------------------------------------------------------*/
+static void
+log_line(const char *str)
+{
+  LOG_INFO("%s", str);
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(resource_stats_process, ev, data)
+{
+  static struct etimer periodic_timer;
+  PROCESS_BEGIN();
+
+  etimer_set(&periodic_timer, RESOURCE_STATS_PERIOD);
+  while(1) {
+    PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&periodic_timer));
+    etimer_reset(&periodic_timer);
+    resource_stats_report(log_line);
+  }
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
+void
+resource_stats_init(void)
+{
+  if(RESOURCE_STATS_PERIOD > 0) {
+    process_start(&resource_stats_process, NULL);
+  }
+}
+
+/** @} */
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * \addtogroup lib
+ * @{
+ *
+ * \defgroup resource-stats The resource statistics module
+ *
+ * Reports the high-water mark and the failed allocations of each
+ * memory resource: the memb pools (which hold the queuebufs, the
+ * neighbor table entries and the routes, among others), the heapmem
+ * zones, the event queue and, where supported, the stack.
+ *
+ * Each resource is reported on a line of the form
+ * "pool <name>: max=<peak> size=<capacity> failed=<count>", in blocks
+ * for the memb pools, in bytes for the heapmem zones and the stack,
+ * and in events for the event queue. The lines are logged
+ * periodically, and printed by the "resources" shell command.
+ * @{
+ */
+
+/**
+ * \file
+ *         Resource high-water marks and allocation failures
+ */
+
+#ifndef RESOURCE_STATS_H_
+#define RESOURCE_STATS_H_
+
+/** \brief The period at which the resource statistics are logged */
+#ifdef RESOURCE_STATS_CONF_PERIOD
+#define RESOURCE_STATS_PERIOD RESOURCE_STATS_CONF_PERIOD
+#else /* RESOURCE_STATS_CONF_PERIOD */
+#define RESOURCE_STATS_PERIOD (CLOCK_SECOND * 60)
+#endif /* RESOURCE_STATS_CONF_PERIOD */
+
+/**
+ * \brief Print one line per resource
+ * \param output Called with each line, which ends with a newline
+ */
+void resource_stats_report(void (*output)(const char *str));
+
+/**
+ * Initialize the resource statistics module
+ */
+void resource_stats_init(void);
+
+#endif /* RESOURCE_STATS_H_ */
+/**
+ * @}
+ * @}
+ */
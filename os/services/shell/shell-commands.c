@@ -66,6 +66,10 @@
 #endif
 #include "net/routing/routing.h"
 #include "net/mac/llsec802154.h"
+#include "sys/profile.h"
+#if BUILD_WITH_RESOURCE_STATS
+#include "services/resource-stats/resource-stats.h"
+#endif /* BUILD_WITH_RESOURCE_STATS */
 
 /* For RPL-specific commands */
 #if ROUTING_CONF_RPL_LITE
@@ -75,6 +79,7 @@
 #endif
 
 #include <stdlib.h>
+#include <inttypes.h>
 
 #define PING_TIMEOUT (5 * CLOCK_SECOND)
 
@@ -929,6 +934,52 @@ PT_THREAD(cmd_llsec_setkey(struct pt *pt, shell_output_func output, char *args))
   PT_END(pt);
 }
 #endif /* LLSEC802154_ENABLED */
+#if PROFILE_CONF_ON
+/*---------------------------------------------------------------------------*/
+static
+PT_THREAD(cmd_profile(struct pt *pt, shell_output_func output, char *args))
+{
+  struct profile_probe *p;
+  char *next_args;
+
+  PT_BEGIN(pt);
+
+  SHELL_ARGS_INIT(args, next_args);
+  SHELL_ARGS_NEXT(args, next_args);
+
+  if(args != NULL && !strcmp(args, "reset")) {
+    profile_reset();
+    SHELL_OUTPUT(output, "Profile counters cleared\n");
+    PT_EXIT(pt);
+  } else if(args != NULL) {
+    SHELL_OUTPUT(output, "Invalid argument: %s\n", args);
+    PT_EXIT(pt);
+  }
+
+  SHELL_OUTPUT(output, "Profile (%lu ticks per second):\n",
+               (unsigned long)PROFILE_SECOND);
+  for(p = profile_probe_head(); p != NULL; p = p->next) {
+    SHELL_OUTPUT(output, "-- %-20s: %lu runs, total %"PRIu64", max %lu, avg %lu\n",
+                 p->name, (unsigned long)p->count, p->total,
+                 (unsigned long)p->max,
+                 p->count ? (unsigned long)(p->total / p->count) : 0);
+  }
+
+  PT_END(pt);
+}
+#endif /* PROFILE_CONF_ON */
+#if BUILD_WITH_RESOURCE_STATS
+/*---------------------------------------------------------------------------*/
+static
+PT_THREAD(cmd_resources(struct pt *pt, shell_output_func output, char *args))
+{
+  PT_BEGIN(pt);
+
+  resource_stats_report(output);
+
+  PT_END(pt);
+}
+#endif /* BUILD_WITH_RESOURCE_STATS */
 /*---------------------------------------------------------------------------*/
 void
 shell_commands_init(void)
@@ -1015,6 +1066,12 @@ const struct shell_command_t builtin_shell_commands[] = {
   { "llsec-set-level", cmd_llsec_setlv, "'> llsec-set-level <lv>': Set the level of link layer security (show if no lv argument)"},
   { "llsec-set-key", cmd_llsec_setkey, "'> llsec-set-key <id> <key>': Set the key of link layer security"},
 #endif /* LLSEC802154_ENABLED */
+#if PROFILE_CONF_ON
+  { "profile",              cmd_profile,              "'> profile [reset]': Shows the profiler probes, or clears their counters" },
+#endif /* PROFILE_CONF_ON */
+#if BUILD_WITH_RESOURCE_STATS
+  { "resources",            cmd_resources,            "'> resources': Shows the high-water mark and failed allocations of each memory pool" },
+#endif /* BUILD_WITH_RESOURCE_STATS */
   { NULL, NULL, NULL },
 };
 
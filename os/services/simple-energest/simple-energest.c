@@ -43,17 +43,31 @@
 
 #include "contiki.h"
 #include "sys/energest.h"
+#include "sys/idle.h"
 #include "simple-energest.h"
 #include <stdio.h>
 #include <limits.h>
 #include <inttypes.h>
 
+#if NETSTACK_CONF_WITH_IPV6
+#include "net/ipv6/uip-ds6-maint.h"
+#define SIMPLE_ENERGEST_WITH_MAINT UIP_DS6_WITH_MAINT
+#else /* NETSTACK_CONF_WITH_IPV6 */
+#define SIMPLE_ENERGEST_WITH_MAINT 0
+#endif /* NETSTACK_CONF_WITH_IPV6 */
+
 /* Log configuration */
 #include "sys/log.h"
 #define LOG_MODULE "Energest"
 #define LOG_LEVEL LOG_LEVEL_INFO
 
 static uint64_t last_tx, last_rx, last_time, last_cpu, last_lpm, last_deep_lpm;
+#if SIMPLE_ENERGEST_WITH_MAINT
+static struct uip_ds6_maint_stats last_maint;
+#endif /* SIMPLE_ENERGEST_WITH_MAINT */
+#if IDLE_WITH_STATS
+static struct idle_stats last_idle;
+#endif /* IDLE_WITH_STATS */
 
 PROCESS(simple_energest_process, "Simple Energest");
 /*---------------------------------------------------------------------------*/
@@ -76,6 +90,9 @@ simple_energest_step(void)
   static unsigned count = 0;
   uint64_t curr_tx, curr_rx, curr_time, curr_cpu, curr_lpm, curr_deep_lpm;
   uint64_t delta_time;
+#if IDLE_WITH_STATS
+  uint32_t sleeps;
+#endif /* IDLE_WITH_STATS */
 
   energest_flush();
 
@@ -98,6 +115,23 @@ simple_energest_step(void)
   log_energest("Radio Rx", curr_rx - last_rx, delta_time);
   log_energest("Radio total", curr_tx - last_tx + curr_rx - last_rx,
                delta_time);
+#if SIMPLE_ENERGEST_WITH_MAINT
+  /* Wakeups of the table maintenance, and the sweeps they coalesce */
+  LOG_INFO("Maintenance : %10"PRIu32" wakeups, %"PRIu32" sweeps, %"PRIu32" skipped\n",
+           uip_ds6_maint_stats.wakeups - last_maint.wakeups,
+           uip_ds6_maint_stats.sweeps - last_maint.sweeps,
+           uip_ds6_maint_stats.skipped - last_maint.skipped);
+  last_maint = uip_ds6_maint_stats;
+#endif /* SIMPLE_ENERGEST_WITH_MAINT */
+#if IDLE_WITH_STATS
+  /* Idle stretches: fewer and longer when the timers share wakeups */
+  sleeps = idle_stats.sleeps - last_idle.sleeps;
+  LOG_INFO("Idle        : %10"PRIu32" sleeps, %"PRIu32" ms on average\n",
+           sleeps, sleeps == 0 ? 0 :
+           (uint32_t)((uint64_t)(idle_stats.ticks - last_idle.ticks) *
+                      1000 / CLOCK_SECOND / sleeps));
+  last_idle = idle_stats;
+#endif /* IDLE_WITH_STATS */
 
   last_time = curr_time;
   last_cpu = curr_cpu;
@@ -131,6 +165,12 @@ simple_energest_init(void)
   last_deep_lpm = energest_type_time(ENERGEST_TYPE_DEEP_LPM);
   last_tx = energest_type_time(ENERGEST_TYPE_TRANSMIT);
   last_rx = energest_type_time(ENERGEST_TYPE_LISTEN);
+#if SIMPLE_ENERGEST_WITH_MAINT
+  last_maint = uip_ds6_maint_stats;
+#endif /* SIMPLE_ENERGEST_WITH_MAINT */
+#if IDLE_WITH_STATS
+  last_idle = idle_stats;
+#endif /* IDLE_WITH_STATS */
   process_start(&simple_energest_process, NULL);
 }
 
@@ -46,10 +46,6 @@
 #include "contiki.h"
 #include "lib/list.h"
 
-LIST(ctimer_list);
-
-static char initialized;
-
 #define DEBUG 0
 #if DEBUG
 #include <stdio.h>
@@ -60,13 +56,385 @@ static char initialized;
 
 /*---------------------------------------------------------------------------*/
 PROCESS(ctimer_process, "Ctimer process");
+/*---------------------------------------------------------------------------*/
+#if CTIMER_WITH_WHEEL
+
+#define SLOT_MASK (CTIMER_WHEEL_SLOTS - 1)
+#define SLOT_BITS 5
+
+/* Clock time a is before b, across wrap-around */
+#define TIME_LT(a, b) \
+  ((clock_time_t)((a) - (b)) > ((clock_time_t)~(clock_time_t)0 >> 1))
+
+/*
+ * Timers expiring within CTIMER_WHEEL_SLOTS ticks of wheel_now are in
+ * the fine wheel, in the slot of their expiration tick. Later timers
+ * are in the coarse wheel, in the slot of their expiration tick divided
+ * by CTIMER_WHEEL_SLOTS, possibly several revolutions ahead. A coarse
+ * slot is cascaded to the fine wheel when wheel_now reaches its first
+ * tick. Timers that are due wait in due_list, in expiration order, for
+ * the ctimer process.
+ */
+static struct ctimer *fine_wheel[CTIMER_WHEEL_SLOTS];
+static struct ctimer *coarse_wheel[CTIMER_WHEEL_SLOTS];
+static uint32_t fine_map;
+static uint32_t coarse_map;
+static struct ctimer *due_list;
+static struct ctimer **due_tail = &due_list;
+/* Due timers whose callbacks are being called */
+static struct ctimer *firing_list;
+/* Last clock tick processed by the wheel */
+static clock_time_t wheel_now;
+/* Single event timer of the ctimer process, and its expiration time */
+static struct etimer wheel_timer;
+static clock_time_t wheel_next;
+static uint8_t wheel_armed;
+
+/*---------------------------------------------------------------------------*/
+/* Expiration tick of a timer in the wheel, in coarse ticks for long timers */
+static clock_time_t
+wheel_expiration(struct ctimer *c)
+{
+  clock_time_t expiration;
+
+  expiration = c->etimer.timer.start + c->etimer.timer.interval;
+  if(CTIMER_WHEEL_COARSE_TICK > 1 &&
+     c->etimer.timer.interval > CTIMER_WHEEL_SLOTS) {
+    expiration += (CTIMER_WHEEL_COARSE_TICK -
+                   expiration % CTIMER_WHEEL_COARSE_TICK) %
+      CTIMER_WHEEL_COARSE_TICK;
+  }
+  return expiration;
+}
+/*---------------------------------------------------------------------------*/
+/* Distance, from 1 to CTIMER_WHEEL_SLOTS, to the next slot set in map */
+static unsigned
+next_slot(uint32_t map, unsigned slot)
+{
+  unsigned distance;
+
+  for(distance = 1; distance < CTIMER_WHEEL_SLOTS; distance++) {
+    if(map & ((uint32_t)1 << ((slot + distance) & SLOT_MASK))) {
+      break;
+    }
+  }
+  return distance;
+}
+/*---------------------------------------------------------------------------*/
+/* Next tick at which the wheel has work to do, if any */
+static int
+next_event(clock_time_t *next)
+{
+  clock_time_t boundary;
+  clock_time_t t;
+  int found = 0;
+
+  if(fine_map != 0) {
+    *next = wheel_now + next_slot(fine_map, wheel_now & SLOT_MASK);
+    found = 1;
+  }
+  if(coarse_map != 0) {
+    /* First tick of the next coarse slot to cascade */
+    boundary = (wheel_now | SLOT_MASK) + 1;
+    t = boundary + ((clock_time_t)(next_slot(coarse_map,
+                                             (boundary >> SLOT_BITS) - 1) - 1)
+                    << SLOT_BITS);
+    if(!found || TIME_LT(t, *next)) {
+      *next = t;
+      found = 1;
+    }
+  }
+  return found;
+}
+/*---------------------------------------------------------------------------*/
+static void
+wheel_arm(clock_time_t next)
+{
+  clock_time_t now = clock_time();
+
+  wheel_next = next;
+  wheel_armed = 1;
+  if(TIME_LT(now, next)) {
+    PROCESS_CONTEXT_BEGIN(&ctimer_process);
+    etimer_set(&wheel_timer, next - now);
+    PROCESS_CONTEXT_END(&ctimer_process);
+  } else {
+    process_poll(&ctimer_process);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+slot_add(struct ctimer **wheel, uint32_t *map, unsigned slot,
+         struct ctimer *c)
+{
+  c->next = wheel[slot];
+  if(c->next != NULL) {
+    c->next->pprev = &c->next;
+  }
+  c->pprev = &wheel[slot];
+  wheel[slot] = c;
+  *map |= (uint32_t)1 << slot;
+}
+/*---------------------------------------------------------------------------*/
+static void
+due_add(struct ctimer *c)
+{
+  c->next = NULL;
+  c->pprev = due_tail;
+  *due_tail = c;
+  due_tail = &c->next;
+}
+/*---------------------------------------------------------------------------*/
+/* Removes a timer from its slot or list, in O(1) */
+static void
+unlink_timer(struct ctimer *c)
+{
+  clock_time_t expiration;
+  unsigned slot;
+
+  *c->pprev = c->next;
+  if(c->next != NULL) {
+    c->next->pprev = c->pprev;
+  } else if(due_tail == &c->next) {
+    due_tail = c->pprev;
+  }
+  c->next = NULL;
+
+  /* Clears the slots of the timer if it left them empty */
+  expiration = wheel_expiration(c);
+  slot = expiration & SLOT_MASK;
+  if(fine_wheel[slot] == NULL) {
+    fine_map &= ~((uint32_t)1 << slot);
+  }
+  slot = (expiration >> SLOT_BITS) & SLOT_MASK;
+  if(coarse_wheel[slot] == NULL) {
+    coarse_map &= ~((uint32_t)1 << slot);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+wheel_insert(struct ctimer *c)
+{
+  clock_time_t expiration = wheel_expiration(c);
+  clock_time_t wakeup;
+
+  if(!wheel_armed && due_list == NULL && fine_map == 0 && coarse_map == 0) {
+    /* The wheel stops turning when it is empty: catch up */
+    wheel_now = clock_time();
+  }
+
+  /* Marks the timer as pending, for etimer_expired() and ctimer_expired() */
+  c->etimer.p = &ctimer_process;
+
+  if(!TIME_LT(wheel_now, expiration)) {
+    due_add(c);
+    wakeup = wheel_now;
+  } else if((clock_time_t)(expiration - wheel_now) <= CTIMER_WHEEL_SLOTS) {
+    slot_add(fine_wheel, &fine_map, expiration & SLOT_MASK, c);
+    wakeup = expiration;
+  } else {
+    slot_add(coarse_wheel, &coarse_map,
+             (expiration >> SLOT_BITS) & SLOT_MASK, c);
+    wakeup = expiration & ~(clock_time_t)SLOT_MASK;
+  }
+
+  if(!wheel_armed || TIME_LT(wakeup, wheel_next)) {
+    wheel_arm(wakeup);
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* Returns nonzero if the timer is pending in the wheel, in O(1). Only
+   a timer marked pending has links, and they must point back to it: a
+   copy of a pending timer is not in the wheel */
+static int
+wheel_contains(struct ctimer *c)
+{
+  return c->etimer.p == &ctimer_process && *c->pprev == c;
+}
+/*---------------------------------------------------------------------------*/
+static void
+wheel_remove(struct ctimer *c)
+{
+  if(wheel_contains(c)) {
+    /* A stale wakeup of the ctimer process is harmless */
+    unlink_timer(c);
+  }
+  c->etimer.p = PROCESS_NONE;
+}
+/*---------------------------------------------------------------------------*/
+/* Moves the timers of a coarse slot that expire within a fine revolution */
+static void
+wheel_cascade(clock_time_t boundary)
+{
+  struct ctimer *c;
+  struct ctimer *next;
+  clock_time_t expiration;
+
+  for(c = coarse_wheel[(boundary >> SLOT_BITS) & SLOT_MASK];
+      c != NULL; c = next) {
+    next = c->next;
+    expiration = wheel_expiration(c);
+    /* Others expire in a later revolution of the coarse wheel */
+    if(TIME_LT(expiration, boundary + CTIMER_WHEEL_SLOTS)) {
+      unlink_timer(c);
+      slot_add(fine_wheel, &fine_map, expiration & SLOT_MASK, c);
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* Moves the timers expired by now to the due list */
+static void
+wheel_advance(clock_time_t now)
+{
+  struct ctimer *c;
+  clock_time_t t;
+
+  while(TIME_LT(wheel_now, now)) {
+    if(!next_event(&t) || TIME_LT(now, t)) {
+      /* Nothing to do until now */
+      wheel_now = now;
+      break;
+    }
+    if((t & SLOT_MASK) == 0) {
+      wheel_cascade(t);
+    }
+    /* All the timers of the fine slot expire at t */
+    while((c = fine_wheel[t & SLOT_MASK]) != NULL) {
+      unlink_timer(c);
+      due_add(c);
+    }
+    wheel_now = t;
+  }
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(ctimer_process, ev, data)
+{
+  struct ctimer *c;
+  clock_time_t next;
+
+  PROCESS_BEGIN();
+
+  while(1) {
+    PROCESS_YIELD_UNTIL(ev == PROCESS_EVENT_TIMER ||
+                        ev == PROCESS_EVENT_POLL);
+    wheel_armed = 0;
+    wheel_advance(clock_time());
+
+    /* Timers set to expire right away by the callbacks wait for the
+       next round */
+    firing_list = due_list;
+    if(firing_list != NULL) {
+      firing_list->pprev = &firing_list;
+    }
+    due_list = NULL;
+    due_tail = &due_list;
+    while(firing_list != NULL) {
+      c = firing_list;
+      c->etimer.p = PROCESS_NONE;
+      unlink_timer(c);
+      PROCESS_CONTEXT_BEGIN(c->p);
+      if(c->f != NULL) {
+        c->f(c->ptr);
+      }
+      PROCESS_CONTEXT_END(c->p);
+    }
+
+    if(due_list != NULL) {
+      wheel_arm(wheel_now);
+    } else if(next_event(&next)) {
+      if(!wheel_armed || TIME_LT(next, wheel_next)) {
+        wheel_arm(next);
+      }
+    } else if(!wheel_armed) {
+      etimer_stop(&wheel_timer);
+    }
+  }
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
+void
+ctimer_init(void)
+{
+  /* Timers set before the initialization stay in the wheel, and are
+     handled as soon as the ctimer process runs */
+  if(due_list == NULL && fine_map == 0 && coarse_map == 0) {
+    wheel_now = clock_time();
+  }
+  wheel_armed = 0;
+  process_set_priority(&ctimer_process, PROCESS_PRIO_SYSTEM);
+  process_start(&ctimer_process, NULL);
+  process_poll(&ctimer_process);
+}
+/*---------------------------------------------------------------------------*/
+void
+ctimer_set(struct ctimer *c, clock_time_t t,
+           void (*f)(void *), void *ptr)
+{
+  ctimer_set_with_process(c, t, f, ptr, PROCESS_CURRENT());
+}
+/*---------------------------------------------------------------------------*/
+void
+ctimer_set_with_process(struct ctimer *c, clock_time_t t,
+                        void (*f)(void *), void *ptr, struct process *p)
+{
+  PRINTF("ctimer_set %p %lu\n", c, (unsigned long)t);
+  wheel_remove(c);
+  c->p = p;
+  c->f = f;
+  c->ptr = ptr;
+  timer_set(&c->etimer.timer, t);
+  wheel_insert(c);
+}
+/*---------------------------------------------------------------------------*/
+void
+ctimer_reset(struct ctimer *c)
+{
+  wheel_remove(c);
+  timer_reset(&c->etimer.timer);
+  wheel_insert(c);
+}
+/*---------------------------------------------------------------------------*/
+void
+ctimer_restart(struct ctimer *c)
+{
+  wheel_remove(c);
+  timer_restart(&c->etimer.timer);
+  wheel_insert(c);
+}
+/*---------------------------------------------------------------------------*/
+void
+ctimer_stop(struct ctimer *c)
+{
+  wheel_remove(c);
+  c->next = NULL;
+}
+/*---------------------------------------------------------------------------*/
+int
+ctimer_expired(struct ctimer *c)
+{
+  return c->etimer.p == PROCESS_NONE;
+}
+/*---------------------------------------------------------------------------*/
+#else /* CTIMER_WITH_WHEEL */
+
+LIST(ctimer_list);
+
+static char initialized;
+
 PROCESS_THREAD(ctimer_process, ev, data)
 {
   struct ctimer *c;
   PROCESS_BEGIN();
 
   for(c = list_head(ctimer_list); c != NULL; c = c->next) {
+#if ETIMER_WITH_SLACK
+    /* etimer_set() clears the slack given before the initialization */
+    clock_time_t slack = c->etimer.slack;
+    etimer_set(&c->etimer, c->etimer.timer.interval);
+    etimer_set_slack(&c->etimer, slack);
+#else /* ETIMER_WITH_SLACK */
     etimer_set(&c->etimer, c->etimer.timer.interval);
+#endif /* ETIMER_WITH_SLACK */
   }
   initialized = 1;
 
@@ -92,6 +460,7 @@ ctimer_init(void)
 {
   initialized = 0;
   list_init(ctimer_list);
+  process_set_priority(&ctimer_process, PROCESS_PRIO_SYSTEM);
   process_start(&ctimer_process, NULL);
 }
 /*---------------------------------------------------------------------------*/
@@ -116,11 +485,27 @@ ctimer_set_with_process(struct ctimer *c, clock_time_t t,
     PROCESS_CONTEXT_END(&ctimer_process);
   } else {
     c->etimer.timer.interval = t;
+#if ETIMER_WITH_SLACK
+    c->etimer.slack = 0;
+#endif /* ETIMER_WITH_SLACK */
   }
 
   list_add(ctimer_list, c);
 }
 /*---------------------------------------------------------------------------*/
+#if ETIMER_WITH_SLACK
+void
+ctimer_set_slack(struct ctimer *c, clock_time_t slack)
+{
+  if(initialized) {
+    etimer_set_slack(&c->etimer, slack);
+  } else {
+    /* Applied when the ctimer process sets the event timer */
+    c->etimer.slack = slack;
+  }
+}
+#endif /* ETIMER_WITH_SLACK */
+/*---------------------------------------------------------------------------*/
 void
 ctimer_reset(struct ctimer *c)
 {
@@ -172,4 +557,5 @@ ctimer_expired(struct ctimer *c)
   return 1;
 }
 /*---------------------------------------------------------------------------*/
+#endif /* CTIMER_WITH_WHEEL */
 /** @} */
@@ -58,8 +58,46 @@
 #include "contiki.h"
 #include "sys/etimer.h"
 
+/**
+ * \brief Keep the callback timers in a hierarchical timing wheel
+ *
+ * By default, every callback timer is an event timer of the ctimer
+ * process. With the timing wheel, the callback timers are hashed in two
+ * wheels of CTIMER_WHEEL_SLOTS slots, of one clock tick and of
+ * CTIMER_WHEEL_SLOTS ticks. A single event timer wakes the ctimer
+ * process up at the next occupied slot. Setting and stopping a callback
+ * timer are then O(1), and expiring it O(1) amortized, whatever the
+ * number of armed timers, at the cost of a pointer per callback timer.
+ */
+#ifdef CTIMER_CONF_WITH_WHEEL
+#define CTIMER_WITH_WHEEL CTIMER_CONF_WITH_WHEEL
+#else
+#define CTIMER_WITH_WHEEL 0
+#endif
+
+/** Number of slots of each wheel: fixed, one bit per slot in a uint32_t */
+#define CTIMER_WHEEL_SLOTS 32
+
+/**
+ * \brief Coarse tick of the timing wheel, in clock ticks
+ *
+ * Timers longer than CTIMER_WHEEL_SLOTS ticks are rounded up to the
+ * next multiple of the coarse tick, so that the timers that don't need
+ * precision share their wakeups. Shorter timers keep the precision of
+ * a clock tick. Use a power of two; 1 disables the rounding.
+ */
+#ifdef CTIMER_CONF_WHEEL_COARSE_TICK
+#define CTIMER_WHEEL_COARSE_TICK CTIMER_CONF_WHEEL_COARSE_TICK
+#else
+#define CTIMER_WHEEL_COARSE_TICK 1
+#endif
+
 struct ctimer {
   struct ctimer *next;
+#if CTIMER_WITH_WHEEL
+  /* Pointer that points to this timer, for O(1) removal from the wheel */
+  struct ctimer **pprev;
+#endif /* CTIMER_WITH_WHEEL */
   struct etimer etimer;
   struct process *p;
   void (*f)(void *);
@@ -134,6 +172,22 @@ void ctimer_set(struct ctimer *c, clock_time_t t,
 void ctimer_set_with_process(struct ctimer *c, clock_time_t t,
                              void (*f)(void *), void *ptr, struct process *p);
 
+#if ETIMER_WITH_SLACK && !CTIMER_WITH_WHEEL
+/**
+ * \brief      Let a callback timer expire late.
+ * \param c    A pointer to the callback timer.
+ * \param slack How many clock ticks late the timer may expire.
+ *
+ *             See etimer_set_slack(): ctimer_set() clears the slack,
+ *             while ctimer_reset() and ctimer_restart() keep it. With
+ *             the timing wheel, CTIMER_WHEEL_COARSE_TICK plays this
+ *             role and the hint is ignored.
+ */
+void ctimer_set_slack(struct ctimer *c, clock_time_t slack);
+#else /* ETIMER_WITH_SLACK && !CTIMER_WITH_WHEEL */
+#define ctimer_set_slack(c, slack)
+#endif /* ETIMER_WITH_SLACK && !CTIMER_WITH_WHEEL */
+
 /**
  * \brief      Stop a pending callback timer.
  * \param c    A pointer to the pending callback timer.
@@ -48,38 +48,86 @@
 
 #include "sys/etimer.h"
 #include "sys/process.h"
+#include "sys/profile.h"
 
+/* Pending timers, sorted by expiration time: the head expires first */
 static struct etimer *timerlist;
 static clock_time_t next_expiration;
 
+PROFILE_PROBE(expiry_probe, "etimer_process");
+
+/* Clock time a is before b, across wrap-around */
+#define TIME_LT(a, b) \
+  ((clock_time_t)((a) - (b)) > ((clock_time_t)~(clock_time_t)0 >> 1))
+
 PROCESS(etimer_process, "Event timer");
 /*---------------------------------------------------------------------------*/
 static void
 update_time(void)
 {
-  clock_time_t tdist;
-  clock_time_t now;
+#if ETIMER_WITH_SLACK
   struct etimer *t;
+  clock_time_t expiration;
+#endif /* ETIMER_WITH_SLACK */
 
   if(timerlist == NULL) {
     next_expiration = 0;
-  } else {
-    now = clock_time();
-    t = timerlist;
-    /* Must calculate distance to next time into account due to wraps */
-    tdist = t->timer.start + t->timer.interval - now;
-    for(t = t->next; t != NULL; t = t->next) {
-      if(t->timer.start + t->timer.interval - now < tdist) {
-        tdist = t->timer.start + t->timer.interval - now;
-      }
+    return;
+  }
+
+  next_expiration = timerlist->timer.start + timerlist->timer.interval;
+#if ETIMER_WITH_SLACK
+  next_expiration += timerlist->slack;
+  /* Only the timers that expire before the earliest deadline so far
+     can have an earlier one */
+  for(t = timerlist->next; t != NULL; t = t->next) {
+    expiration = t->timer.start + t->timer.interval;
+    if(TIME_LT(next_expiration, expiration)) {
+      break;
+    }
+    if(TIME_LT(expiration + t->slack, next_expiration)) {
+      next_expiration = expiration + t->slack;
+    }
+  }
+#endif /* ETIMER_WITH_SLACK */
+}
+/*---------------------------------------------------------------------------*/
+static void
+insert_timer(struct etimer *timer)
+{
+  struct etimer **tp;
+  clock_time_t expiration = timer->timer.start + timer->timer.interval;
+
+  /* After the timers that expire at the same time, to keep FIFO order */
+  for(tp = &timerlist; *tp != NULL; tp = &(*tp)->next) {
+    if(TIME_LT(expiration,
+               (*tp)->timer.start + (*tp)->timer.interval)) {
+      break;
+    }
+  }
+  timer->next = *tp;
+  *tp = timer;
+  update_time();
+}
+/*---------------------------------------------------------------------------*/
+static void
+remove_timer(struct etimer *timer)
+{
+  struct etimer **tp;
+
+  for(tp = &timerlist; *tp != NULL; tp = &(*tp)->next) {
+    if(*tp == timer) {
+      *tp = timer->next;
+      update_time();
+      break;
     }
-    next_expiration = now + tdist;
   }
+  timer->next = NULL;
 }
 /*---------------------------------------------------------------------------*/
 PROCESS_THREAD(etimer_process, ev, data)
 {
-  struct etimer *t, *u;
+  struct etimer *t;
 
   PROCESS_BEGIN();
 
@@ -105,37 +153,38 @@ PROCESS_THREAD(etimer_process, ev, data)
           }
         }
       }
+      update_time();
       continue;
     } else if(ev != PROCESS_EVENT_POLL) {
       continue;
     }
 
-again:
-
-    u = NULL;
-
-    for(t = timerlist; t != NULL; t = t->next) {
-      if(timer_expired(&t->timer)) {
-        if(process_post(t->p, PROCESS_EVENT_TIMER, t) == PROCESS_ERR_OK) {
+#if ETIMER_WITH_SLACK
+    /* The timers expired so far wait for the deadline, to expire
+       together with the ones that are due by then */
+    if(timerlist != NULL && TIME_LT(clock_time(), next_expiration)) {
+      continue;
+    }
+#endif /* ETIMER_WITH_SLACK */
 
-          /* Reset the process ID of the event timer, to signal that the
-             etimer has expired. This is later checked in the
-             etimer_expired() function. */
-          t->p = PROCESS_NONE;
-          if(u != NULL) {
-            u->next = t->next;
-          } else {
-            timerlist = t->next;
-          }
-          t->next = NULL;
-          update_time();
-          goto again;
-        } else {
-          etimer_request_poll();
-        }
+    /* Expired timers are at the head of the list */
+    PROFILE_BEGIN(expiry_probe);
+    while(timerlist != NULL && timer_expired(&timerlist->timer)) {
+      t = timerlist;
+      if(process_post(t->p, PROCESS_EVENT_TIMER, t) != PROCESS_ERR_OK) {
+        /* The event queue is full, retry later */
+        etimer_request_poll();
+        break;
       }
-      u = t;
+      /* Reset the process ID of the event timer, to signal that the
+         etimer has expired. This is later checked in the
+         etimer_expired() function. */
+      t->p = PROCESS_NONE;
+      timerlist = t->next;
+      t->next = NULL;
+      update_time();
     }
+    PROFILE_END(expiry_probe);
   }
 
   PROCESS_END();
@@ -150,36 +199,38 @@ etimer_request_poll(void)
 static void
 add_timer(struct etimer *timer)
 {
-  struct etimer *t;
-
   etimer_request_poll();
 
   if(timer->p != PROCESS_NONE) {
-    for(t = timerlist; t != NULL; t = t->next) {
-      if(t == timer) {
-        /* Timer already on list, bail out. */
-        timer->p = PROCESS_CURRENT();
-        update_time();
-        return;
-      }
-    }
+    /* Timer possibly on the list, with another expiration time */
+    remove_timer(timer);
   }
 
-  /* Timer not on list. */
   timer->p = PROCESS_CURRENT();
-  timer->next = timerlist;
-  timerlist = timer;
-
-  update_time();
+  insert_timer(timer);
 }
 /*---------------------------------------------------------------------------*/
 void
 etimer_set(struct etimer *et, clock_time_t interval)
 {
   timer_set(&et->timer, interval);
+#if ETIMER_WITH_SLACK
+  et->slack = 0;
+#endif /* ETIMER_WITH_SLACK */
   add_timer(et);
 }
 /*---------------------------------------------------------------------------*/
+#if ETIMER_WITH_SLACK
+void
+etimer_set_slack(struct etimer *et, clock_time_t slack)
+{
+  et->slack = slack;
+  if(et->p != PROCESS_NONE) {
+    update_time();
+  }
+}
+#endif /* ETIMER_WITH_SLACK */
+/*---------------------------------------------------------------------------*/
 void
 etimer_reset_with_new_interval(struct etimer *et, clock_time_t interval)
 {
@@ -206,7 +257,10 @@ void
 etimer_adjust(struct etimer *et, int timediff)
 {
   et->timer.start += timediff;
-  update_time();
+  if(et->p != PROCESS_NONE) {
+    remove_timer(et);
+    insert_timer(et);
+  }
 }
 /*---------------------------------------------------------------------------*/
 int
@@ -242,30 +296,7 @@ etimer_next_expiration_time(void)
 void
 etimer_stop(struct etimer *et)
 {
-  struct etimer *t;
-
-  /* First check if et is the first event timer on the list. */
-  if(et == timerlist) {
-    timerlist = timerlist->next;
-    update_time();
-  } else {
-    /* Else walk through the list and try to find the item before the
-       et timer. */
-    for(t = timerlist; t != NULL && t->next != et; t = t->next) {
-    }
-
-    if(t != NULL) {
-      /* We've found the item before the event timer that we are about
-         to remove. We point the items next pointer to the event after
-         the removed item. */
-      t->next = et->next;
-
-      update_time();
-    }
-  }
-
-  /* Remove the next pointer from the item to be removed. */
-  et->next = NULL;
+  remove_timer(et);
   /* Set the timer as expired */
   et->p = PROCESS_NONE;
 }
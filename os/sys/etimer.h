@@ -65,6 +65,36 @@
 
 #include "contiki.h"
 
+/**
+ * \brief Let event timers expire late, to share wakeups
+ *
+ * Each event timer gets a slack, set with etimer_set_slack(): the
+ * timer may expire up to that many clock ticks late. The next
+ * expiration time is then the earliest deadline of the pending timers,
+ * their expiration time plus their slack, and all the timers expired
+ * by then expire together. Independent periodic timers thus share
+ * their wakeups, and an idle system sleeps in longer stretches.
+ */
+#ifdef ETIMER_CONF_WITH_SLACK
+#define ETIMER_WITH_SLACK ETIMER_CONF_WITH_SLACK
+#else
+#define ETIMER_WITH_SLACK 0
+#endif
+
+/**
+ * \brief Slack hint of the periodic housekeeping timers of the stack
+ *
+ * A timer of period P may expire up to P / ETIMER_PERIODIC_SLACK_DIV
+ * late. The periodic timers keep their cadence, so a late expiration
+ * does not shift the next ones.
+ */
+#ifdef ETIMER_CONF_PERIODIC_SLACK_DIV
+#define ETIMER_PERIODIC_SLACK_DIV ETIMER_CONF_PERIODIC_SLACK_DIV
+#else
+#define ETIMER_PERIODIC_SLACK_DIV 4
+#endif
+#define ETIMER_PERIODIC_SLACK(period) ((period) / ETIMER_PERIODIC_SLACK_DIV)
+
 /**
  * A timer.
  *
@@ -77,6 +107,9 @@ struct etimer {
   struct timer timer;
   struct etimer *next;
   struct process *p;
+#if ETIMER_WITH_SLACK
+  clock_time_t slack;
+#endif /* ETIMER_WITH_SLACK */
 };
 
 /**
@@ -97,6 +130,23 @@ struct etimer {
  */
 void etimer_set(struct etimer *et, clock_time_t interval);
 
+#if ETIMER_WITH_SLACK
+/**
+ * \brief      Let an event timer expire late.
+ * \param et   A pointer to the event timer
+ * \param slack How many clock ticks late the timer may expire.
+ *
+ *             This function is a hint for the timers whose exact
+ *             expiration time does not matter, such as the periodic
+ *             housekeeping timers. etimer_set() clears the slack, while
+ *             etimer_reset() and etimer_restart() keep it: call this
+ *             function after etimer_set().
+ */
+void etimer_set_slack(struct etimer *et, clock_time_t slack);
+#else /* ETIMER_WITH_SLACK */
+#define etimer_set_slack(et, slack)
+#endif /* ETIMER_WITH_SLACK */
+
 /**
  * \brief      Reset an event timer with the same interval as was
  *             previously set.
@@ -242,7 +292,9 @@ int etimer_pending(void);
  *	       returns 0.
  *
  *             This functions returns next expiration time of all
- *             pending event timers.
+ *             pending event timers. With ETIMER_WITH_SLACK, this is
+ *             the latest time at which no timer is late by more than
+ *             its slack.
  */
 clock_time_t etimer_next_expiration_time(void);
 
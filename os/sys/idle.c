@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * \addtogroup idle
+ * @{
+ */
+
+/**
+ * \file
+ *         Tickless idle support
+ */
+
+#include "contiki.h"
+#include "sys/idle.h"
+#include "sys/etimer.h"
+#include "sys/rtimer.h"
+
+struct idle_stats idle_stats;
+
+static clock_time_t idle_start;
+static bool idle;
+/*---------------------------------------------------------------------------*/
+static clock_time_t
+until(clock_time_t deadline, clock_time_t now, clock_time_t max)
+{
+  clock_time_t ticks = deadline - now;
+
+  /* Passed deadlines look very far */
+  if(ticks > ((clock_time_t)~(clock_time_t)0 >> 1)) {
+    return 0;
+  }
+  return ticks < max ? ticks : max;
+}
+/*---------------------------------------------------------------------------*/
+clock_time_t
+idle_ticks(clock_time_t max)
+{
+  clock_time_t now;
+  rtimer_clock_t rtimer_next;
+  rtimer_clock_t rtimer_now;
+
+  if(process_nevents() > 0) {
+    return 0;
+  }
+
+  now = clock_time();
+  if(etimer_pending()) {
+    max = until(etimer_next_expiration_time(), now, max);
+  }
+
+  if(rtimer_next_expiration_time(&rtimer_next)) {
+    rtimer_now = RTIMER_NOW();
+    if(!RTIMER_CLOCK_LT(rtimer_now, rtimer_next)) {
+      return 0;
+    }
+    max = until(now + (clock_time_t)((uint64_t)(rtimer_next - rtimer_now) *
+                                     CLOCK_SECOND / RTIMER_SECOND),
+                now, max);
+  }
+
+  return max;
+}
+/*---------------------------------------------------------------------------*/
+void
+idle_enter(void)
+{
+  idle_start = clock_time();
+  idle = true;
+}
+/*---------------------------------------------------------------------------*/
+void
+idle_exit(void)
+{
+  if(!idle) {
+    return;
+  }
+  idle = false;
+  idle_stats.sleeps++;
+  idle_stats.ticks += clock_time() - idle_start;
+}
+/*---------------------------------------------------------------------------*/
+/** @} */
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ *         Header file for the tickless idle support
+ */
+
+/** \addtogroup sys
+ * @{ */
+
+/**
+ * \defgroup idle Tickless idle
+ *
+ * The next deadline of the system, for the platforms that sleep until
+ * their next piece of work instead of waking up at every clock tick.
+ * It merges the pending events and polls, the next event timer
+ * deadline, which includes the slack of the timers (see
+ * etimer_set_slack()), and the next real-time task.
+ *
+ * @{
+ */
+
+#ifndef IDLE_H_
+#define IDLE_H_
+
+#include "contiki.h"
+
+/* Whether the platform reports its idle stretches with idle_enter()
+   and idle_exit() */
+#ifdef PLATFORM_CONF_SUPPORTS_IDLE_STATS
+#define IDLE_WITH_STATS PLATFORM_CONF_SUPPORTS_IDLE_STATS
+#else
+#define IDLE_WITH_STATS 0
+#endif
+
+/** Idle stretches since the boot, which wrap around */
+struct idle_stats {
+  /** Number of idle stretches */
+  uint32_t sleeps;
+  /** Clock ticks spent idle */
+  uint32_t ticks;
+};
+
+extern struct idle_stats idle_stats;
+
+/**
+ * \brief      Get how long the system can stay idle
+ * \param max  The longest stretch the caller accepts, in clock ticks
+ * \return     The number of clock ticks until the next deadline, at
+ *             most max. Zero if a process has an event or a poll
+ *             pending, or if a deadline has passed.
+ *
+ *             The platform sleeps for the returned time, or until an
+ *             interrupt. A real-time task is reported rounded down to
+ *             the clock tick before it.
+ */
+clock_time_t idle_ticks(clock_time_t max);
+
+/**
+ * \brief      Report the start of an idle stretch
+ *
+ *             Called by the platform just before it sleeps.
+ */
+void idle_enter(void);
+
+/**
+ * \brief      Report the end of an idle stretch
+ *
+ *             Called by the platform when it wakes up. Does nothing if
+ *             idle_enter() was not called before.
+ */
+void idle_exit(void);
+
+#endif /* IDLE_H_ */
+
+/** @} */
+/** @} */
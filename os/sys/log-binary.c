@@ -0,0 +1,313 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * \addtogroup log
+ * @{
+ */
+
+/**
+ * \file
+ *         Binary log: deferred logging to a RAM ring
+ */
+
+#include "contiki.h"
+#include "sys/log.h"
+
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#if LOG_WITH_BINARY
+
+#if LOG_BINARY_BUF_SIZE < LOG_BINARY_MAX_RECORD
+#error "LOG_CONF_BINARY_BUF_SIZE is too small to hold a record"
+#endif
+
+const char log_binary_anchor[] = "binlog";
+
+/* Ring of records: the first byte of a record is its length */
+static uint8_t ring[LOG_BINARY_BUF_SIZE];
+static uint16_t ring_head, ring_tail, ring_used;
+static uint16_t nlost;
+static uint8_t drain_pending;
+
+/* The record being built, and its length */
+static uint8_t record[LOG_BINARY_MAX_RECORD];
+static uint8_t record_len;
+
+PROCESS(log_binary_process, "Binary log");
+/*---------------------------------------------------------------------------*/
+static uint32_t
+anchor_offset(const char *str)
+{
+  return (uint32_t)((uintptr_t)str - (uintptr_t)log_binary_anchor);
+}
+/*---------------------------------------------------------------------------*/
+/* Appends to the record, returns 0 if it does not fit */
+static int
+put(const void *data, uint8_t len)
+{
+  if(record_len + len > LOG_BINARY_MAX_RECORD) {
+    record[1] |= LOG_BINARY_TRUNCATED;
+    return 0;
+  }
+  memcpy(&record[record_len], data, len);
+  record_len += len;
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static int
+put_u32(uint32_t v)
+{
+  return put(&v, sizeof(v));
+}
+/*---------------------------------------------------------------------------*/
+static int
+put_string(const char *str)
+{
+  uint8_t len;
+
+  if(str == NULL) {
+    str = "(null)";
+  }
+  for(len = 0; len < LOG_BINARY_MAX_STRLEN && str[len] != '\0'; len++);
+  return put(&len, 1) && put(str, len);
+}
+/*---------------------------------------------------------------------------*/
+/*
+ * Stores the arguments in the order of the conversions of the format.
+ * Only the conversions are parsed, nothing is formatted.
+ */
+static void
+put_args(const char *fmt, va_list ap)
+{
+  const char *f;
+  int lmod;
+  int ok = 1;
+
+  for(f = fmt; *f != '\0' && ok; f++) {
+    if(*f != '%') {
+      continue;
+    }
+    f++;
+    /* Flags, width and precision */
+    while((*f >= '0' && *f <= '9') || *f == '.' || *f == '-' || *f == '+' ||
+          *f == ' ' || *f == '#' || *f == '*') {
+      if(*f == '*') {
+        ok = put_u32(va_arg(ap, int));
+      }
+      f++;
+    }
+    /* Length modifier: 1 for long, 2 for 64-bit, 3 for size_t */
+    lmod = 0;
+    while(*f == 'h' || *f == 'l' || *f == 'j' || *f == 'z' || *f == 't') {
+      if(*f == 'l') {
+        lmod++;
+      } else if(*f == 'j') {
+        lmod = 2;
+      } else if(*f != 'h') {
+        lmod = 3;
+      }
+      f++;
+    }
+    switch(*f) {
+    case 'd': case 'i': case 'u': case 'o': case 'x': case 'X': case 'c':
+      if(lmod == 1) {
+        ok = put_u32((uint32_t)va_arg(ap, long));
+      } else if(lmod == 2) {
+        uint64_t v = (uint64_t)va_arg(ap, long long);
+        ok = put(&v, sizeof(v));
+      } else if(lmod == 3) {
+        ok = put_u32((uint32_t)va_arg(ap, size_t));
+      } else {
+        ok = put_u32((uint32_t)va_arg(ap, int));
+      }
+      break;
+    case 'p':
+      ok = put_u32((uint32_t)(uintptr_t)va_arg(ap, void *));
+      break;
+    case 's':
+      ok = put_string(va_arg(ap, const char *));
+      break;
+    case 'e': case 'E': case 'f': case 'F': case 'g': case 'G': {
+      float v = (float)va_arg(ap, double);
+      ok = put(&v, sizeof(v));
+      break;
+    }
+    case '%':
+      break;
+    default:
+      /* End of the format, or unknown argument type */
+      if(*f != '\0') {
+        record[1] |= LOG_BINARY_TRUNCATED;
+      }
+      return;
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+ring_write(const uint8_t *data, uint16_t len)
+{
+  uint16_t first = MIN(len, LOG_BINARY_BUF_SIZE - ring_head);
+
+  memcpy(&ring[ring_head], data, first);
+  memcpy(ring, data + first, len - first);
+  ring_head += len;
+  if(ring_head >= LOG_BINARY_BUF_SIZE) {
+    ring_head -= LOG_BINARY_BUF_SIZE;
+  }
+  ring_used += len;
+}
+/*---------------------------------------------------------------------------*/
+static void
+ring_read(uint8_t *data, uint16_t len)
+{
+  uint16_t first = MIN(len, LOG_BINARY_BUF_SIZE - ring_tail);
+
+  memcpy(data, &ring[ring_tail], first);
+  memcpy(data + first, ring, len - first);
+  ring_tail += len;
+  if(ring_tail >= LOG_BINARY_BUF_SIZE) {
+    ring_tail -= LOG_BINARY_BUF_SIZE;
+  }
+  ring_used -= len;
+}
+/*---------------------------------------------------------------------------*/
+static void
+request_drain(void)
+{
+  if(!drain_pending && process_is_running(&log_binary_process) &&
+     process_post(&log_binary_process, PROCESS_EVENT_CONTINUE, NULL)
+     == PROCESS_ERR_OK) {
+    drain_pending = 1;
+  }
+}
+/*---------------------------------------------------------------------------*/
+void
+log_binary_printf(uint8_t flags, const char *module, const char *fmt, ...)
+{
+  va_list ap;
+  uint32_t now = (uint32_t)clock_time();
+  uint32_t offset;
+
+  record[1] = flags;
+  memcpy(&record[2], &now, sizeof(now));
+  offset = module != NULL ? anchor_offset(module) : 0;
+  memcpy(&record[6], &offset, sizeof(offset));
+  offset = anchor_offset(fmt);
+  memcpy(&record[10], &offset, sizeof(offset));
+  record_len = LOG_BINARY_HEADER_LEN;
+
+  va_start(ap, fmt);
+  put_args(fmt, ap);
+  va_end(ap);
+
+  record[0] = record_len;
+  if(LOG_BINARY_BUF_SIZE - ring_used < record_len) {
+    nlost++;
+  } else {
+    ring_write(record, record_len);
+  }
+  request_drain();
+}
+/*---------------------------------------------------------------------------*/
+int
+log_binary_read(uint8_t *buf)
+{
+  uint8_t len;
+
+  if(ring_used == 0) {
+    return 0;
+  }
+  len = ring[ring_tail];
+  ring_read(buf, len);
+  return len;
+}
+/*---------------------------------------------------------------------------*/
+int
+log_binary_drain(int max)
+{
+  static const char hex[] = "0123456789abcdef";
+  static char line[sizeof(LOG_BINARY_MARKER) + 2 * LOG_BINARY_MAX_RECORD];
+  uint8_t buf[LOG_BINARY_MAX_RECORD];
+  char *l;
+  int len;
+  int i;
+
+  if(nlost > 0) {
+    printf("[WARN: BinLog    ] %u records lost\n", nlost);
+    nlost = 0;
+  }
+
+  while(max-- > 0 && (len = log_binary_read(buf)) > 0) {
+    l = line + strlen(LOG_BINARY_MARKER);
+    memcpy(line, LOG_BINARY_MARKER, l - line);
+    for(i = 0; i < len; i++) {
+      *l++ = hex[buf[i] >> 4];
+      *l++ = hex[buf[i] & 0xf];
+    }
+    *l = '\0';
+    printf("%s\n", line);
+  }
+  return ring_used > 0;
+}
+/*---------------------------------------------------------------------------*/
+uint16_t
+log_binary_nlost(void)
+{
+  return nlost;
+}
+/*---------------------------------------------------------------------------*/
+void
+log_binary_init(void)
+{
+  process_start(&log_binary_process, NULL);
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(log_binary_process, ev, data)
+{
+  PROCESS_BEGIN();
+
+  while(1) {
+    drain_pending = 0;
+    if(log_binary_drain(LOG_BINARY_DRAIN_BATCH)) {
+      /* Let the other events go first before the next batch */
+      request_drain();
+    }
+    PROCESS_YIELD();
+  }
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
+#endif /* LOG_WITH_BINARY */
+/** @} */
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * \addtogroup log
+ * @{
+ */
+
+/**
+ * \file
+ *         Binary log: deferred logging to a RAM ring
+ *
+ *         Each log call stores a record with the log level, the
+ *         module and format strings, and the raw arguments. Strings
+ *         are referenced by their offset from log_binary_anchor, which
+ *         the host-side decoder resolves in the firmware image; %s
+ *         arguments are copied into the record. A process drains the
+ *         ring as hex lines prefixed with LOG_BINARY_MARKER when the
+ *         system is otherwise idle.
+ *
+ *         Record layout (target byte order):
+ *         length (1), flags (1), clock time (4), module offset (4),
+ *         format offset (4), arguments. Integer, %c and %p arguments
+ *         take 4 bytes, %ll and %j 8 bytes, floating point 4 bytes
+ *         (as float), and strings a length byte and up to
+ *         LOG_BINARY_MAX_STRLEN characters.
+ */
+
+#ifndef LOG_BINARY_H_
+#define LOG_BINARY_H_
+
+#include "contiki.h"
+
+/** Flag of the records that start a new log line, with prefix */
+#define LOG_BINARY_PREFIX    0x80
+/** Flag of the records whose arguments did not fit */
+#define LOG_BINARY_TRUNCATED 0x40
+/** Mask of the log level in the flags */
+#define LOG_BINARY_LEVEL     0x07
+
+/** Size of the record header */
+#define LOG_BINARY_HEADER_LEN 14
+/** Maximum size of a record */
+#define LOG_BINARY_MAX_RECORD 96
+/** Maximum number of characters stored for a %s argument */
+#define LOG_BINARY_MAX_STRLEN 32
+
+/** Start of the drained hex lines */
+#define LOG_BINARY_MARKER "#B"
+
+/** Reference for the string offsets in the records */
+extern const char log_binary_anchor[];
+
+PROCESS_NAME(log_binary_process);
+
+/**
+ * \brief Store a log record
+ * \param flags The log level, with LOG_BINARY_PREFIX for a new line
+ * \param module The module name, or NULL
+ * \param fmt A constant printf format string
+ *
+ * Not to be called from interrupt context.
+ */
+void log_binary_printf(uint8_t flags, const char *module,
+                       const char *fmt, ...)
+     __attribute__((__format__ (__printf__, 3, 4)));
+
+/**
+ * \brief Remove the oldest record from the ring
+ * \param buf Buffer of at least LOG_BINARY_MAX_RECORD bytes
+ * \return The length of the record, 0 if the ring is empty
+ *
+ * The default output of the records is the drain process; this
+ * function is for alternative outputs.
+ */
+int log_binary_read(uint8_t *buf);
+
+/**
+ * \brief Print up to max records as hex lines
+ * \return Non-zero if records are still in the ring
+ *
+ * The number of records lost since the last drain is printed first.
+ */
+int log_binary_drain(int max);
+
+/** \brief Number of records lost because the ring was full, since the last drain */
+uint16_t log_binary_nlost(void);
+
+/** \brief Start the drain process */
+void log_binary_init(void);
+
+#endif /* LOG_BINARY_H_ */
+/** @} */
@@ -75,8 +75,37 @@
 #define LOG_WITH_ANNOTATE 0
 #endif /* LOG_CONF_WITH_ANNOTATE */
 
+/*
+ * Binary logging: instead of formatting the logs synchronously, store
+ * compact records (level, module, format, raw arguments) in a RAM ring
+ * that is drained when the system is idle. The records are printed as
+ * hex lines, to be decoded on the host with tools/binlog/binlog-decode.py.
+ * Disabled by default.
+ */
+#ifdef LOG_CONF_WITH_BINARY
+#define LOG_WITH_BINARY LOG_CONF_WITH_BINARY
+#else /* LOG_CONF_WITH_BINARY */
+#define LOG_WITH_BINARY 0
+#endif /* LOG_CONF_WITH_BINARY */
+
+/* Size of the binary log ring, in bytes */
+#ifdef LOG_CONF_BINARY_BUF_SIZE
+#define LOG_BINARY_BUF_SIZE LOG_CONF_BINARY_BUF_SIZE
+#else /* LOG_CONF_BINARY_BUF_SIZE */
+#define LOG_BINARY_BUF_SIZE 1024
+#endif /* LOG_CONF_BINARY_BUF_SIZE */
+
+/* Maximum number of records printed each time the binary log is drained */
+#ifdef LOG_CONF_BINARY_DRAIN_BATCH
+#define LOG_BINARY_DRAIN_BATCH LOG_CONF_BINARY_DRAIN_BATCH
+#else /* LOG_CONF_BINARY_DRAIN_BATCH */
+#define LOG_BINARY_DRAIN_BATCH 4
+#endif /* LOG_CONF_BINARY_DRAIN_BATCH */
+
 /* Custom output function -- default is printf */
-#ifdef LOG_CONF_OUTPUT
+#if LOG_WITH_BINARY
+#define LOG_OUTPUT(...) log_binary_printf(0, NULL, __VA_ARGS__)
+#elif defined(LOG_CONF_OUTPUT)
 #define LOG_OUTPUT(...) LOG_CONF_OUTPUT(__VA_ARGS__)
 #else /* LOG_CONF_OUTPUT */
 #define LOG_OUTPUT(...) printf(__VA_ARGS__)
@@ -133,6 +162,10 @@
 #define LOG_CONF_LEVEL_MAC                         LOG_LEVEL_NONE
 #endif /* LOG_CONF_LEVEL_MAC */
 
+#ifndef LOG_CONF_LEVEL_LS
+#define LOG_CONF_LEVEL_LS                          LOG_LEVEL_NONE
+#endif /* LOG_CONF_LEVEL_LS */
+
 #ifndef LOG_CONF_LEVEL_FRAMER
 #define LOG_CONF_LEVEL_FRAMER                      LOG_LEVEL_NONE
 #endif /* LOG_CONF_LEVEL_FRAMER */
@@ -133,6 +133,14 @@ log_lladdr(const linkaddr_t *lladdr)
     LOG_OUTPUT("(NULL LL addr)");
     return;
   } else {
+#if LINKADDR_SIZE == 8
+    /* A single output call, rather than one per byte */
+    LOG_OUTPUT("%02x%02x.%02x%02x.%02x%02x.%02x%02x",
+               lladdr->u8[0], lladdr->u8[1], lladdr->u8[2], lladdr->u8[3],
+               lladdr->u8[4], lladdr->u8[5], lladdr->u8[6], lladdr->u8[7]);
+#elif LINKADDR_SIZE == 2
+    LOG_OUTPUT("%02x%02x", lladdr->u8[0], lladdr->u8[1]);
+#else
     unsigned int i;
     for(i = 0; i < LINKADDR_SIZE; i++) {
       if(i > 0 && i % 2 == 0) {
@@ -140,6 +148,7 @@ log_lladdr(const linkaddr_t *lladdr)
       }
       LOG_OUTPUT("%02x", lladdr->u8[i]);
     }
+#endif
   }
 }
 /*---------------------------------------------------------------------------*/
@@ -54,6 +54,9 @@
 #include <stdio.h>
 #include "net/linkaddr.h"
 #include "sys/log-conf.h"
+#if LOG_WITH_BINARY
+#include "sys/log-binary.h"
+#endif /* LOG_WITH_BINARY */
 #if NETSTACK_CONF_WITH_IPV6
 #include "net/ipv6/uip.h"
 #endif /* NETSTACK_CONF_WITH_IPV6 */
@@ -138,6 +141,17 @@ extern struct log_module all_modules[];
 
 /* Main log function */
 
+#if LOG_WITH_BINARY
+/* Store a record, the prefix is added by the host-side decoder */
+#define LOG(newline, level, levelstr, levelcolor, ...) do {  \
+                            if(level <= (LOG_LEVEL)) { \
+                              log_binary_printf((newline) ? \
+                                                (level) | LOG_BINARY_PREFIX : \
+                                                (level), \
+                                                LOG_MODULE, __VA_ARGS__); \
+                            } \
+                          } while (0)
+#else /* LOG_WITH_BINARY */
 #define LOG(newline, level, levelstr, levelcolor, ...) do {  \
                             if(level <= (LOG_LEVEL)) { \
                               if(newline) { \
@@ -157,6 +171,7 @@ extern struct log_module all_modules[];
                               LOG_OUTPUT(__VA_ARGS__); \
                             } \
                           } while (0)
+#endif /* LOG_WITH_BINARY */
 
 /* For Cooja annotations */
 #define LOG_ANNOTATE(...) do {  \
@@ -44,6 +44,7 @@
  */
 
 #include <stdio.h>
+#include <string.h>
 
 #include "contiki.h"
 #include "sys/process.h"
@@ -65,12 +66,50 @@ struct event_data {
   struct process *p;
 };
 
-static process_num_events_t nevents, fevent;
+/*
+ * A FIFO ring of events. Without priorities, there is a single ring
+ * of PROCESS_CONF_NUMEVENTS entries.
+ */
+struct event_ring {
+  struct event_data *events;
+  process_num_events_t size;
+  process_num_events_t nevents, fevent;
+};
+
+#if PROCESS_WITH_PRIORITIES
+#if PROCESS_NUMEVENTS_APPLICATION + PROCESS_NUMEVENTS_NETWORK + \
+    PROCESS_NUMEVENTS_SYSTEM > 255
+#error "The event rings cannot hold more than 255 events in total"
+#endif
+#define NRINGS PROCESS_PRIO_COUNT
+static struct event_data events_application[PROCESS_NUMEVENTS_APPLICATION];
+static struct event_data events_network[PROCESS_NUMEVENTS_NETWORK];
+static struct event_data events_system[PROCESS_NUMEVENTS_SYSTEM];
+/* Indexed by priority */
+static struct event_ring rings[NRINGS] = {
+  { events_application, PROCESS_NUMEVENTS_APPLICATION, 0, 0 },
+  { events_network, PROCESS_NUMEVENTS_NETWORK, 0, 0 },
+  { events_system, PROCESS_NUMEVENTS_SYSTEM, 0, 0 },
+};
+#else /* PROCESS_WITH_PRIORITIES */
+#define NRINGS 1
 static struct event_data events[PROCESS_CONF_NUMEVENTS];
+static struct event_ring rings[NRINGS] = {
+  { events, PROCESS_CONF_NUMEVENTS, 0, 0 },
+};
+#endif /* PROCESS_WITH_PRIORITIES */
+
+/* Total number of events in the rings */
+static process_num_events_t nevents;
 
 #if PROCESS_CONF_STATS
 process_num_events_t process_maxevents;
-#endif
+#if PROCESS_WITH_PRIORITIES
+process_num_events_t process_maxevents_prio[PROCESS_PRIO_COUNT];
+#endif /* PROCESS_WITH_PRIORITIES */
+unsigned short process_broadcast_ndropped;
+unsigned short process_ndropped;
+#endif /* PROCESS_CONF_STATS */
 
 static volatile unsigned char poll_requested;
 
@@ -207,11 +246,21 @@ process_exit(struct process *p)
 void
 process_init(void)
 {
+  struct event_ring *r;
+
   lastevent = PROCESS_EVENT_MAX;
 
-  nevents = fevent = 0;
+  nevents = 0;
+  for(r = rings; r < rings + NRINGS; r++) {
+    r->nevents = r->fevent = 0;
+  }
 #if PROCESS_CONF_STATS
   process_maxevents = 0;
+#if PROCESS_WITH_PRIORITIES
+  memset(process_maxevents_prio, 0, sizeof(process_maxevents_prio));
+#endif /* PROCESS_WITH_PRIORITIES */
+  process_broadcast_ndropped = 0;
+  process_ndropped = 0;
 #endif /* PROCESS_CONF_STATS */
 
   process_current = process_list = NULL;
@@ -249,6 +298,7 @@ do_event(void)
   process_data_t data;
   struct process *receiver;
   struct process *p;
+  struct event_ring *r;
 
   /*
    * If there are any events in the queue, take the first one and walk
@@ -260,15 +310,24 @@ do_event(void)
 
   if(nevents > 0) {
 
-    /* There are events that we should deliver. */
-    ev = events[fevent].ev;
+    /* There are events that we should deliver. Take them from the
+       highest priority ring that is not empty. */
+    r = &rings[NRINGS - 1];
+    while(r->nevents == 0) {
+      r--;
+    }
+
+    ev = r->events[r->fevent].ev;
 
-    data = events[fevent].data;
-    receiver = events[fevent].p;
+    data = r->events[r->fevent].data;
+    receiver = r->events[r->fevent].p;
 
     /* Since we have seen the new event, we move pointer upwards
        and decrease the number of events. */
-    fevent = (fevent + 1) % PROCESS_CONF_NUMEVENTS;
+    if(++r->fevent == r->size) {
+      r->fevent = 0;
+    }
+    --r->nevents;
     --nevents;
 
     /* If this is a broadcast event, we deliver it to all events, in
@@ -322,6 +381,8 @@ int
 process_post(struct process *p, process_event_t ev, process_data_t data)
 {
   process_num_events_t snum;
+  unsigned sum;
+  struct event_ring *r;
 
   if(PROCESS_CURRENT() == NULL) {
     PRINTF("process_post: NULL process posts event %d to process '%s', nevents %d\n",
@@ -332,7 +393,21 @@ process_post(struct process *p, process_event_t ev, process_data_t data)
            p == PROCESS_BROADCAST ? "<broadcast>" : PROCESS_NAME_STRING(p), nevents);
   }
 
-  if(nevents == PROCESS_CONF_NUMEVENTS) {
+#if PROCESS_WITH_PRIORITIES
+  r = &rings[p == PROCESS_BROADCAST ? PROCESS_PRIO_SYSTEM : p->prio];
+#else /* PROCESS_WITH_PRIORITIES */
+  r = &rings[0];
+#endif /* PROCESS_WITH_PRIORITIES */
+
+  if(r->nevents == r->size) {
+#if PROCESS_CONF_STATS
+    process_ndropped++;
+    if(p == PROCESS_BROADCAST) {
+      process_broadcast_ndropped++;
+    } else {
+      p->ndropped++;
+    }
+#endif /* PROCESS_CONF_STATS */
 #if DEBUG
     if(p == PROCESS_BROADCAST) {
       printf("soft panic: event queue is full when broadcast event %d was posted from %s\n", ev, PROCESS_NAME_STRING(process_current));
@@ -343,16 +418,27 @@ process_post(struct process *p, process_event_t ev, process_data_t data)
     return PROCESS_ERR_FULL;
   }
 
-  snum = (process_num_events_t)(fevent + nevents) % PROCESS_CONF_NUMEVENTS;
-  events[snum].ev = ev;
-  events[snum].data = data;
-  events[snum].p = p;
+  /* The sum may not fit in a process_num_events_t */
+  sum = (unsigned)r->fevent + r->nevents;
+  if(sum >= r->size) {
+    sum -= r->size;
+  }
+  snum = (process_num_events_t)sum;
+  r->events[snum].ev = ev;
+  r->events[snum].data = data;
+  r->events[snum].p = p;
+  ++r->nevents;
   ++nevents;
 
 #if PROCESS_CONF_STATS
   if(nevents > process_maxevents) {
     process_maxevents = nevents;
   }
+#if PROCESS_WITH_PRIORITIES
+  if(r->nevents > process_maxevents_prio[r - rings]) {
+    process_maxevents_prio[r - rings] = r->nevents;
+  }
+#endif /* PROCESS_WITH_PRIORITIES */
 #endif /* PROCESS_CONF_STATS */
 
   return PROCESS_ERR_OK;
@@ -367,6 +453,14 @@ process_post_synch(struct process *p, process_event_t ev, process_data_t data)
   process_current = caller;
 }
 /*---------------------------------------------------------------------------*/
+#if PROCESS_WITH_PRIORITIES
+void
+process_set_priority(struct process *p, unsigned char prio)
+{
+  p->prio = prio < PROCESS_PRIO_COUNT ? prio : PROCESS_PRIO_SYSTEM;
+}
+#endif /* PROCESS_WITH_PRIORITIES */
+/*---------------------------------------------------------------------------*/
 void
 process_poll(struct process *p)
 {
@@ -88,6 +88,55 @@ typedef unsigned char process_num_events_t;
 #define PROCESS_CONF_NUMEVENTS 32
 #endif /* PROCESS_CONF_NUMEVENTS */
 
+/**
+ * \brief Queue the events in one ring per priority
+ *
+ * By default, all asynchronous events share a single FIFO ring of
+ * PROCESS_CONF_NUMEVENTS entries. With priorities, an event is queued
+ * in the ring of the priority of the process it is posted to, and the
+ * kernel always delivers the oldest event of the highest non-empty
+ * priority first. Broadcast events go to the system ring. A burst of
+ * application events then neither delays nor crowds out the events of
+ * the network stack. Lower priorities are not served while a higher
+ * priority has events pending.
+ */
+#ifdef PROCESS_CONF_WITH_PRIORITIES
+#define PROCESS_WITH_PRIORITIES PROCESS_CONF_WITH_PRIORITIES
+#else
+#define PROCESS_WITH_PRIORITIES 0
+#endif
+
+/**
+ * \name Process priorities
+ * @{
+ */
+#define PROCESS_PRIO_APPLICATION 0 /**< Default priority of a process */
+#define PROCESS_PRIO_NETWORK     1 /**< MAC, routing and IP processes */
+#define PROCESS_PRIO_SYSTEM      2 /**< Timer and kernel services */
+#define PROCESS_PRIO_COUNT       3
+/** @} */
+
+/** Size of the event ring of the application priority */
+#ifdef PROCESS_CONF_NUMEVENTS_APPLICATION
+#define PROCESS_NUMEVENTS_APPLICATION PROCESS_CONF_NUMEVENTS_APPLICATION
+#else
+#define PROCESS_NUMEVENTS_APPLICATION PROCESS_CONF_NUMEVENTS
+#endif
+
+/** Size of the event ring of the network priority */
+#ifdef PROCESS_CONF_NUMEVENTS_NETWORK
+#define PROCESS_NUMEVENTS_NETWORK PROCESS_CONF_NUMEVENTS_NETWORK
+#else
+#define PROCESS_NUMEVENTS_NETWORK 16
+#endif
+
+/** Size of the event ring of the system priority */
+#ifdef PROCESS_CONF_NUMEVENTS_SYSTEM
+#define PROCESS_NUMEVENTS_SYSTEM PROCESS_CONF_NUMEVENTS_SYSTEM
+#else
+#define PROCESS_NUMEVENTS_SYSTEM 8
+#endif
+
 #define PROCESS_EVENT_NONE            0x80
 #define PROCESS_EVENT_INIT            0x81
 #define PROCESS_EVENT_POLL            0x82
@@ -323,6 +372,13 @@ struct process {
   PT_THREAD((* thread)(struct pt *, process_event_t, process_data_t));
   struct pt pt;
   unsigned char state, needspoll;
+#if PROCESS_WITH_PRIORITIES
+  unsigned char prio;
+#endif /* PROCESS_WITH_PRIORITIES */
+#if PROCESS_CONF_STATS
+  /* Number of events that could not be posted to the process */
+  unsigned short ndropped;
+#endif /* PROCESS_CONF_STATS */
 };
 
 /**
@@ -389,6 +445,22 @@ void process_post_synch(struct process *p,
  */
 void process_exit(struct process *p);
 
+#if PROCESS_WITH_PRIORITIES
+/**
+ * \brief      Set the priority of the events posted to a process
+ * \param p    The process
+ * \param prio The priority, one of PROCESS_PRIO_APPLICATION,
+ *             PROCESS_PRIO_NETWORK or PROCESS_PRIO_SYSTEM
+ *
+ *             Processes have the application priority until this
+ *             function is called. Events already queued for the
+ *             process keep their priority.
+ */
+void process_set_priority(struct process *p, unsigned char prio);
+#else /* PROCESS_WITH_PRIORITIES */
+#define process_set_priority(p, prio)
+#endif /* PROCESS_WITH_PRIORITIES */
+
 
 /**
  * Get a pointer to the currently running process.
@@ -519,6 +591,19 @@ int process_is_running(struct process *p);
  */
 int process_nevents(void);
 
+#if PROCESS_CONF_STATS
+/** Highest number of events that were queued at the same time */
+extern process_num_events_t process_maxevents;
+#if PROCESS_WITH_PRIORITIES
+/** Highest number of events that were queued in each priority ring */
+extern process_num_events_t process_maxevents_prio[PROCESS_PRIO_COUNT];
+#endif /* PROCESS_WITH_PRIORITIES */
+/** Number of broadcast events that could not be posted */
+extern unsigned short process_broadcast_ndropped;
+/** Number of events that could not be posted, broadcast or not */
+extern unsigned short process_ndropped;
+#endif /* PROCESS_CONF_STATS */
+
 /** @} */
 
 extern struct process *process_list;
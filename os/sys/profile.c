@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * \addtogroup profile
+ * @{
+ */
+
+/**
+ * \file
+ *         Hot-path profiler: probe registry and periodic dump
+ */
+
+#include "contiki.h"
+#include "sys/profile.h"
+
+#if PROFILE_CONF_ON
+
+#include "lib/list.h"
+
+#include <inttypes.h>
+
+/* Log configuration */
+#include "sys/log.h"
+#define LOG_MODULE "Profile"
+#define LOG_LEVEL LOG_LEVEL_INFO
+
+LIST(probes);
+
+#if PROFILE_DUMP_PERIOD
+PROCESS(profile_process, "Profile");
+#endif /* PROFILE_DUMP_PERIOD */
+/*---------------------------------------------------------------------------*/
+void
+profile_probe_add(struct profile_probe *p, PROFILE_TIME_T elapsed)
+{
+  if(!p->registered) {
+    p->registered = 1;
+    list_add(probes, p);
+  }
+  p->count++;
+  p->total += elapsed;
+  if(elapsed > p->max) {
+    p->max = elapsed;
+  }
+}
+/*---------------------------------------------------------------------------*/
+struct profile_probe *
+profile_probe_head(void)
+{
+  return list_head(probes);
+}
+/*---------------------------------------------------------------------------*/
+void
+profile_reset(void)
+{
+  struct profile_probe *p;
+
+  for(p = list_head(probes); p != NULL; p = list_item_next(p)) {
+    p->count = 0;
+    p->total = 0;
+    p->max = 0;
+  }
+}
+/*---------------------------------------------------------------------------*/
+void
+profile_dump(void)
+{
+  static unsigned count = 0;
+  struct profile_probe *p;
+
+  LOG_INFO("--- Profile summary #%u (%"PRIu32" ticks per second)\n",
+           count++, (uint32_t)PROFILE_SECOND);
+  for(p = list_head(probes); p != NULL; p = list_item_next(p)) {
+    LOG_INFO("%-20s: %8"PRIu32" runs, total %10"PRIu64", max %8"PRIu32
+             ", avg %8"PRIu32"\n",
+             p->name, p->count, p->total, (uint32_t)p->max,
+             p->count ? (uint32_t)(p->total / p->count) : 0);
+  }
+}
+/*---------------------------------------------------------------------------*/
+#if PROFILE_DUMP_PERIOD
+PROCESS_THREAD(profile_process, ev, data)
+{
+  static struct etimer periodic_timer;
+
+  PROCESS_BEGIN();
+
+  etimer_set(&periodic_timer, PROFILE_DUMP_PERIOD);
+  while(1) {
+    PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&periodic_timer));
+    etimer_reset(&periodic_timer);
+    /* Each summary covers one period */
+    profile_dump();
+    profile_reset();
+  }
+
+  PROCESS_END();
+}
+#endif /* PROFILE_DUMP_PERIOD */
+/*---------------------------------------------------------------------------*/
+void
+profile_init(void)
+{
+#ifdef PROFILE_ARCH_INIT
+  PROFILE_ARCH_INIT();
+#endif /* PROFILE_ARCH_INIT */
+#if PROFILE_DUMP_PERIOD
+  process_start(&profile_process, NULL);
+#endif /* PROFILE_DUMP_PERIOD */
+}
+/*---------------------------------------------------------------------------*/
+#endif /* PROFILE_CONF_ON */
+/** @} */
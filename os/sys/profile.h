@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * \addtogroup sys
+ * @{
+ */
+
+/**
+ * \defgroup profile Hot-path profiler
+ * @{
+ *
+ * Named probes that measure how long a section of code runs. Each
+ * probe counts the runs of its section and records their total and
+ * longest duration, in ticks of PROFILE_SECOND.
+ *
+ * A probe is declared once per file with PROFILE_PROBE(), and a
+ * section is delimited with PROFILE_BEGIN() and PROFILE_END(). The
+ * section must not yield nor be re-entered before it ends. A probe
+ * registers itself the first time its section ends. The probes are
+ * reported by the "profile" shell command and, every
+ * PROFILE_DUMP_PERIOD, in the log.
+ *
+ * The time source is RTIMER_NOW() unless the CPU provides a finer
+ * one, such as the DWT cycle counter of the Cortex-M3/M4, through
+ * PROFILE_CONF_ARCH_HEADER_PATH. With PROFILE_CONF_ON set to 0 (the
+ * default), the probes compile to nothing.
+ */
+
+/**
+ * \file
+ *         Header file for the hot-path profiler
+ */
+
+#ifndef PROFILE_H_
+#define PROFILE_H_
+
+#include "contiki.h"
+
+#ifndef PROFILE_CONF_ON
+/* The profiler is disabled by default */
+#define PROFILE_CONF_ON 0
+#endif /* PROFILE_CONF_ON */
+
+#if PROFILE_CONF_ON
+
+#ifdef PROFILE_CONF_ARCH_HEADER_PATH
+#include PROFILE_CONF_ARCH_HEADER_PATH
+#endif /* PROFILE_CONF_ARCH_HEADER_PATH */
+
+/*
+ * The time source: a project that sets PROFILE_CONF_CURRENT_TIME
+ * should also set PROFILE_CONF_TIME_T and PROFILE_CONF_SECOND.
+ */
+#ifdef PROFILE_CONF_CURRENT_TIME
+#define PROFILE_CURRENT_TIME PROFILE_CONF_CURRENT_TIME
+#elif defined(PROFILE_ARCH_CURRENT_TIME)
+#define PROFILE_CURRENT_TIME PROFILE_ARCH_CURRENT_TIME
+#else
+#define PROFILE_CURRENT_TIME RTIMER_NOW
+#endif
+
+#ifdef PROFILE_CONF_TIME_T
+#define PROFILE_TIME_T PROFILE_CONF_TIME_T
+#elif defined(PROFILE_ARCH_TIME_T)
+#define PROFILE_TIME_T PROFILE_ARCH_TIME_T
+#else
+#define PROFILE_TIME_T rtimer_clock_t
+#endif
+
+#ifdef PROFILE_CONF_SECOND
+#define PROFILE_SECOND PROFILE_CONF_SECOND
+#elif defined(PROFILE_ARCH_SECOND)
+#define PROFILE_SECOND PROFILE_ARCH_SECOND
+#else
+#define PROFILE_SECOND RTIMER_SECOND
+#endif
+
+/** Period of the profile dump to the log, 0 to disable it */
+#ifdef PROFILE_CONF_DUMP_PERIOD
+#define PROFILE_DUMP_PERIOD PROFILE_CONF_DUMP_PERIOD
+#else
+#define PROFILE_DUMP_PERIOD (60 * CLOCK_SECOND)
+#endif
+
+struct profile_probe {
+  struct profile_probe *next;
+  const char *name;
+  PROFILE_TIME_T start;
+  PROFILE_TIME_T max;
+  uint64_t total;
+  uint32_t count;
+  uint8_t registered;
+};
+
+/**
+ * \brief Declare a probe
+ * \param var The variable of the probe
+ * \param str The name under which the probe is reported
+ */
+#define PROFILE_PROBE(var, str) \
+  static struct profile_probe var = { NULL, str, 0, 0, 0, 0, 0 }
+
+/** \brief Start a section measured by the probe \a var */
+#define PROFILE_BEGIN(var) ((var).start = PROFILE_CURRENT_TIME())
+
+/** \brief End a section measured by the probe \a var */
+#define PROFILE_END(var) \
+  profile_probe_add(&(var), \
+                    (PROFILE_TIME_T)(PROFILE_CURRENT_TIME() - (var).start))
+
+/**
+ * \brief Account for a run of a section
+ * \param p The probe of the section
+ * \param elapsed The duration of the run
+ *
+ * Called by PROFILE_END(). Registers the probe on its first run.
+ */
+void profile_probe_add(struct profile_probe *p, PROFILE_TIME_T elapsed);
+
+/**
+ * \brief The registered probes
+ * \return The first probe; the others follow through its next field
+ */
+struct profile_probe *profile_probe_head(void);
+
+/** \brief Clear the counters of all probes */
+void profile_reset(void);
+
+/** \brief Log the counters of all probes */
+void profile_dump(void);
+
+/**
+ * \brief Initialize the profiler
+ *
+ * Starts the time source, if needed, and the periodic dump.
+ */
+void profile_init(void);
+
+#else /* PROFILE_CONF_ON */
+
+/* A declaration that nothing refers to, to keep the trailing ';' legal */
+#define PROFILE_PROBE(var, str) extern struct profile_probe var
+#define PROFILE_BEGIN(var)
+#define PROFILE_END(var)
+
+#endif /* PROFILE_CONF_ON */
+
+#endif /* PROFILE_H_ */
+/** @} */
+/** @} */
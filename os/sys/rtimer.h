@@ -172,6 +172,13 @@ int rtimer_set(struct rtimer *task, rtimer_clock_t time,
  */
 void rtimer_run_next(void);
 
+/**
+ * \brief      Get the scheduled real-time task, if any
+ * \param time A pointer to where to store the time of the task
+ * \return     Non-zero if a real-time task is scheduled
+ */
+int rtimer_next_expiration_time(rtimer_clock_t *time);
+
 /**
  * \brief      Get the current clock time
  * \return     The current time
@@ -6,3 +6,6 @@
  * This file serves as a dummy contiki.h to make it possible to
  * compile a test file having "#include <lib/memb.h>" in it.
  */
+
+/* Test the free-list pools, declared with MEMB_FREE_LIST(), as well */
+#define MEMB_CONF_WITH_FREE_LIST 1
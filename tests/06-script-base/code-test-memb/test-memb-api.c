@@ -45,22 +45,21 @@ typedef struct test_struct {
 } test_struct_t;
 
 MEMB(memb_pool, test_struct_t, NUM_MEMB_BLOCKS);
+MEMB_FREE_LIST(memb_free_list_pool, test_struct_t, NUM_MEMB_BLOCKS);
+MEMB_FREE_LIST(memb_uninitialized_pool, test_struct_t, NUM_MEMB_BLOCKS);
 
-int
-main(void)
+static int
+test_pool(struct memb *pool)
 {
   int ret;
   test_struct_t *memb_block_p;
   test_struct_t *memb_block_list[NUM_MEMB_BLOCKS];
 
-  /* initialize the memory blocks */
-  memb_init(&memb_pool);
-
   /*
    * all the blocks should be "unused"; memb_numfree() should return
    * NUM_MEMB_BLOCKS
    */
-  if((ret = memb_numfree(&memb_pool)) != NUM_MEMB_BLOCKS) {
+  if((ret = memb_numfree(pool)) != NUM_MEMB_BLOCKS) {
     printf("test failed: memb_numfree() returns %d, which should be %d\n",
            ret, NUM_MEMB_BLOCKS);
     return -1;
@@ -71,15 +70,15 @@ main(void)
   /* allocate memory blocks */
   memset(memb_block_list, 0, sizeof(memb_block_list));
   for(int i = 0; i < NUM_MEMB_BLOCKS; i++) {
-    memb_block_p = (test_struct_t *)memb_alloc(&memb_pool);
+    memb_block_p = (test_struct_t *)memb_alloc(pool);
     if(memb_block_p == NULL) {
       printf("test failed: memb_alloc() returns NULL with i==%d\n", i);
       return -1;
-    } else if((ret = memb_inmemb(&memb_pool, memb_block_p)) != 1) {
+    } else if((ret = memb_inmemb(pool, memb_block_p)) != 1) {
       printf("test failed: %p returned memb_alloc() is invalid\n",
              memb_block_p);
       return -1;
-    } else if((ret = memb_numfree(&memb_pool)) != NUM_MEMB_BLOCKS - i - 1) {
+    } else if((ret = memb_numfree(pool)) != NUM_MEMB_BLOCKS - i - 1) {
       printf("test failed: memb_numfree() returns an invalid value %d, "
              "which should be %d\n", ret, NUM_MEMB_BLOCKS - i - 1);
       return -1;
@@ -91,7 +90,7 @@ main(void)
   }
 
   /* try to allocate another memory block, which should fail */
-  if((memb_block_p = (test_struct_t *)memb_alloc(&memb_pool)) != NULL) {
+  if((memb_block_p = (test_struct_t *)memb_alloc(pool)) != NULL) {
     printf("test failed: memb_alloc() allocates more memory than defined\n");
     return -1;
   } else {
@@ -101,11 +100,11 @@ main(void)
   /* free the allocated memory blocks */
   for(int i = 0; i < NUM_MEMB_BLOCKS; i++) {
     memb_block_p = memb_block_list[i];
-    if((ret = memb_free(&memb_pool, memb_block_p)) != 0) {
+    if((ret = memb_free(pool, memb_block_p)) != 0) {
       printf("test failed: cannot memb_free() to %p, return value is %d\n",
              memb_block_p, ret);
       return -1;
-    } else if((ret = memb_numfree(&memb_pool)) != i + 1) {
+    } else if((ret = memb_numfree(pool)) != i + 1) {
       printf("test failed: memb_numfree() returns an invalid value %d, "
              "which should be %d\n", ret, i + 1);
       return -1;
@@ -120,12 +119,12 @@ main(void)
    */
   for(int i = 0; i < NUM_MEMB_BLOCKS; i++) {
     memb_block_p = memb_block_list[i];
-    if((ret = memb_free(&memb_pool, memb_block_p)) != -1) {
+    if((ret = memb_free(pool, memb_block_p)) != -1) {
       /* double free shouldn't succeed (we should have -1 returned) */
       printf("test failed: cannot double free to %p, return value is %d\n",
              memb_block_p, ret);
       return -1;
-    } else if((ret = memb_numfree(&memb_pool)) != NUM_MEMB_BLOCKS) {
+    } else if((ret = memb_numfree(pool)) != NUM_MEMB_BLOCKS) {
       /* memb_numfree() should return NUM_MEMB_BLOCKS as no memory is used */
       printf("test failed: memb_numfree() returns an invalid value %d, "
              "which should be %d\n", ret, NUM_MEMB_BLOCKS);
@@ -137,10 +136,10 @@ main(void)
   }
 
   /* free with a invalid address, which are not the beginning of a block */
-  if((memb_block_p = memb_alloc(&memb_pool)) == NULL) {
+  if((memb_block_p = memb_alloc(pool)) == NULL) {
     printf("test failed: memb_alloc() returns NULL while no memory is used\n");
     return -1;
-  } else if(memb_free(&memb_pool, ONE_BYTE_OFF_ADDR(memb_block_p)) != -1) {
+  } else if(memb_free(pool, ONE_BYTE_OFF_ADDR(memb_block_p)) != -1) {
     printf("test failed: memb_free accepts an invalid address %p, "
            "which is one byte off from memory block starting at %p\n",
            ONE_BYTE_OFF_ADDR(memb_block_p), memb_block_p);
@@ -148,7 +147,50 @@ main(void)
   } else {
     printf("- memb_free is OK: reject an invalid address %p\n",
            ONE_BYTE_OFF_ADDR(memb_block_p));
-    (void)memb_free(&memb_pool, memb_block_p);
+    (void)memb_free(pool, memb_block_p);
+  }
+
+  /* a freed block is allocated again, whatever its position */
+  for(int i = 0; i < NUM_MEMB_BLOCKS; i++) {
+    memb_block_list[i] = memb_alloc(pool);
+  }
+  (void)memb_free(pool, memb_block_list[NUM_MEMB_BLOCKS / 2]);
+  if((memb_block_p = memb_alloc(pool)) != memb_block_list[NUM_MEMB_BLOCKS / 2]) {
+    printf("test failed: memb_alloc() returns %p instead of the freed block "
+           "%p\n", memb_block_p, memb_block_list[NUM_MEMB_BLOCKS / 2]);
+    return -1;
+  } else {
+    printf("- memb_alloc is OK: freed block %p is allocated again\n",
+           memb_block_p);
+  }
+  for(int i = 0; i < NUM_MEMB_BLOCKS; i++) {
+    (void)memb_free(pool, memb_block_list[i]);
+  }
+
+  return 0;
+}
+
+int
+main(void)
+{
+  /* initialize the memory blocks */
+  memb_init(&memb_pool);
+  memb_init(&memb_free_list_pool);
+
+  printf("Memory blocks\n");
+  if(test_pool(&memb_pool) != 0) {
+    return -1;
+  }
+
+  printf("Memory blocks with a free list\n");
+  if(test_pool(&memb_free_list_pool) != 0) {
+    return -1;
+  }
+
+  /* a pool is usable before memb_init(), as it is zero-initialized */
+  printf("Memory blocks with a free list, not initialized\n");
+  if(test_pool(&memb_uninitialized_pool) != 0) {
+    return -1;
   }
 
   return 0;
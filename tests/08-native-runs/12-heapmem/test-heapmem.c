@@ -66,6 +66,11 @@
 #else
 #define TEST_MAX_SIZE       200
 #endif
+/* Configuration for the churn test, which mimics packet and application
+   buffers of various sizes. */
+#define CHURN_OPERATIONS  200000
+#define CHURN_CONCURRENT     400
+#define CHURN_MAX_SIZE      1280
 /*****************************************************************************/
 PROCESS(test_heapmem_process, "Heapmem test process");
 AUTOSTART_PROCESSES(&test_heapmem_process);
@@ -277,6 +282,138 @@ UNIT_TEST(zones)
   UNIT_TEST_END();
 }
 /*****************************************************************************/
+/* Mostly small allocations, with a tail of large buffers. */
+static size_t
+churn_size(void)
+{
+  switch(rand() % 4) {
+  case 0:
+    return 1 + rand() % CHURN_MAX_SIZE;
+  case 1:
+    return 1 + rand() % (CHURN_MAX_SIZE / 4);
+  default:
+    return 1 + rand() % 64;
+  }
+}
+/*****************************************************************************/
+/* Fills a block with a pattern of its own. */
+static void
+fill_block(uint8_t *ptr, size_t size, unsigned tag)
+{
+  for(size_t i = 0; i < size; i++) {
+    ptr[i] = (uint8_t)(tag * 31 + i);
+  }
+}
+/*****************************************************************************/
+/* Returns true if the first size bytes of a block still hold its pattern. */
+static bool
+check_block(const uint8_t *ptr, size_t size, unsigned tag)
+{
+  for(size_t i = 0; i < size; i++) {
+    if(ptr[i] != (uint8_t)(tag * 31 + i)) {
+      return false;
+    }
+  }
+  return true;
+}
+/*****************************************************************************/
+UNIT_TEST_REGISTER(churn, "Allocation churn and fragmentation");
+UNIT_TEST(churn)
+{
+  UNIT_TEST_BEGIN();
+
+  static uint8_t *ptrs[CHURN_CONCURRENT];
+  static size_t sizes[CHURN_CONCURRENT];
+  static unsigned tags[CHURN_CONCURRENT];
+  size_t live = 0, peak_live = 0, peak_footprint = 0;
+  unsigned failed = 0, corrupted = 0;
+  heapmem_stats_t stats;
+
+  memset(ptrs, 0, sizeof(ptrs));
+
+  for(unsigned count = 0; count < CHURN_OPERATIONS; count++) {
+    unsigned i = rand() % CHURN_CONCURRENT;
+    size_t size = churn_size();
+
+    if(ptrs[i] != NULL) {
+      /* Other blocks must not have written over this one. */
+      if(!check_block(ptrs[i], sizes[i], tags[i])) {
+        corrupted++;
+      }
+      live -= sizes[i];
+      if(count & 1) {
+        /* Reallocation: the common part of the block is preserved. */
+        uint8_t *ptr = heapmem_realloc(ptrs[i], size);
+        if(ptr == NULL) {
+          failed++;
+          heapmem_free(ptrs[i]);
+          ptrs[i] = NULL;
+          continue;
+        }
+        if(!check_block(ptr, size < sizes[i] ? size : sizes[i], tags[i])) {
+          corrupted++;
+        }
+        ptrs[i] = ptr;
+      } else {
+        heapmem_free(ptrs[i]);
+        ptrs[i] = heapmem_alloc(size);
+        if(ptrs[i] == NULL) {
+          failed++;
+          continue;
+        }
+      }
+    } else {
+      ptrs[i] = heapmem_alloc(size);
+      if(ptrs[i] == NULL) {
+        failed++;
+        continue;
+      }
+    }
+
+    sizes[i] = size;
+    tags[i] = count;
+    fill_block(ptrs[i], size, count);
+    live += size;
+    peak_live = live > peak_live ? live : peak_live;
+
+    if((count & 0x3ff) == 0) {
+      heapmem_stats(&stats);
+      if(stats.footprint > peak_footprint) {
+        peak_footprint = stats.footprint;
+      }
+    }
+  }
+
+  heapmem_stats(&stats);
+  /* Footprint per byte requested, including the chunk headers. */
+  printf("Fragmentation: live %zu, footprint %zu (%zu%%), "
+         "peak live %zu, peak footprint %zu (%zu%%)\n",
+         live, stats.footprint,
+         live > 0 ? stats.footprint * 100 / live : 0,
+         peak_live, peak_footprint,
+         peak_live > 0 ? peak_footprint * 100 / peak_live : 0);
+  printf("Failed allocations: %u, corrupted blocks: %u\n", failed, corrupted);
+
+  for(unsigned i = 0; i < CHURN_CONCURRENT; i++) {
+    if(ptrs[i] != NULL) {
+      UNIT_TEST_ASSERT(check_block(ptrs[i], sizes[i], tags[i]));
+      UNIT_TEST_ASSERT(heapmem_free(ptrs[i]) == true);
+    }
+  }
+
+  UNIT_TEST_ASSERT(corrupted == 0);
+#if HEAPMEM_CONF_WITH_SIZE_CLASSES
+  /* Freed chunks are coalesced at once and reused by the best-fitting
+     size class: the churn neither fails nor grows the heap much beyond
+     the peak of the live data. The first-fit search may give up and
+     grow the heap instead. */
+  UNIT_TEST_ASSERT(failed == 0);
+  UNIT_TEST_ASSERT(peak_footprint <= 2 * peak_live);
+#endif /* HEAPMEM_CONF_WITH_SIZE_CLASSES */
+
+  UNIT_TEST_END();
+}
+/*****************************************************************************/
 PROCESS_THREAD(test_heapmem_process, ev, data)
 {
   PROCESS_BEGIN();
@@ -294,10 +431,13 @@ PROCESS_THREAD(test_heapmem_process, ev, data)
   UNIT_TEST_RUN(reallocations);
   UNIT_TEST_RUN(stats_check);
   UNIT_TEST_RUN(zones);
+  /* Last, as the heap may be left fragmented. */
+  UNIT_TEST_RUN(churn);
 
   if(!UNIT_TEST_PASSED(do_many_allocations) ||
      !UNIT_TEST_PASSED(max_alloc) ||
      !UNIT_TEST_PASSED(invalid_freeing) ||
+     !UNIT_TEST_PASSED(churn) ||
      !UNIT_TEST_PASSED(stats_check) ||
      !UNIT_TEST_PASSED(zones)) {
     printf("=check-me= FAILED\n");
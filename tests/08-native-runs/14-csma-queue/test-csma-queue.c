@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ *      Micro-benchmark of the CSMA packet enqueue cost as a function of
+ *      the number of neighbors that have packets queued. With the
+ *      neighbor-table-backed queues, also checks that clearing the neighbor
+ *      tables fails the queued packets outside of the neighbor table.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "contiki.h"
+#include "net/netstack.h"
+#include "net/packetbuf.h"
+#include "net/nbr-table.h"
+#include "net/mac/csma/csma.h"
+#include "unit-test/unit-test.h"
+/*****************************************************************************/
+/* Size of the dummy payload of every packet */
+#define PAYLOAD_LEN 40
+/* Largest number of active neighbors benchmarked */
+#define MAX_ACTIVE_NEIGHBORS 128
+/*****************************************************************************/
+PROCESS(test_csma_queue_process, "CSMA queue test process");
+AUTOSTART_PROCESSES(&test_csma_queue_process);
+
+static unsigned active_neighbors;
+static unsigned sent_count;
+static unsigned queue_full_count;
+static unsigned tx_err_count;
+static int in_nbr_table_clear;
+static int sent_in_nbr_table_clear;
+/*****************************************************************************/
+static uint64_t
+now_ns(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+/*****************************************************************************/
+static void
+packet_sent(void *ptr, int status, int num_tx)
+{
+  sent_count++;
+  if(in_nbr_table_clear) {
+    sent_in_nbr_table_clear = 1;
+  }
+  if(status == MAC_TX_QUEUE_FULL) {
+    queue_full_count++;
+  }
+  if(status == MAC_TX_ERR) {
+    tx_err_count++;
+  }
+}
+/*****************************************************************************/
+static void
+enqueue_with_callback(unsigned neighbor, mac_callback_t sent)
+{
+  linkaddr_t addr;
+
+  /* Neighbor addresses start at 1, as the null address means broadcast */
+  memset(&addr, 0, sizeof(addr));
+  addr.u8[LINKADDR_SIZE - 2] = (neighbor + 1) >> 8;
+  addr.u8[LINKADDR_SIZE - 1] = (neighbor + 1) & 0xff;
+
+  packetbuf_clear();
+  memset(packetbuf_dataptr(), 0x55, PAYLOAD_LEN);
+  packetbuf_set_datalen(PAYLOAD_LEN);
+  packetbuf_set_addr(PACKETBUF_ADDR_RECEIVER, &addr);
+  packetbuf_set_attr(PACKETBUF_ATTR_MAX_MAC_TRANSMISSIONS, 1);
+  NETSTACK_MAC.send(sent, (void *)(uintptr_t)neighbor);
+}
+/*****************************************************************************/
+static void
+enqueue(unsigned neighbor)
+{
+  enqueue_with_callback(neighbor, packet_sent);
+}
+/*****************************************************************************/
+UNIT_TEST_REGISTER(enqueue_cost, "Enqueue cost");
+UNIT_TEST(enqueue_cost)
+{
+  UNIT_TEST_BEGIN();
+
+  uint64_t start;
+  uint64_t duration;
+  unsigned i;
+
+  /* Give every neighbor a non-empty queue */
+  for(i = 0; i < active_neighbors; i++) {
+    enqueue(i);
+  }
+
+  /* Enqueue a second packet for every neighbor: each one requires
+     looking up an existing neighbor queue */
+  start = now_ns();
+  for(i = 0; i < active_neighbors; i++) {
+    enqueue(i);
+  }
+  duration = now_ns() - start;
+
+  printf("Active neighbors: %3u, enqueue cost: %5lu ns/packet\n",
+         active_neighbors, (unsigned long)(duration / active_neighbors));
+
+  UNIT_TEST_ASSERT(queue_full_count == 0);
+
+  UNIT_TEST_END();
+}
+/*****************************************************************************/
+#if CSMA_WITH_NBR_TABLE_QUEUES
+static unsigned requeued_count;
+
+/* Re-enters CSMA from the sent callback of a dropped packet */
+static void
+packet_sent_requeue(void *ptr, int status, int num_tx)
+{
+  packet_sent(ptr, status, num_tx);
+  if(status == MAC_TX_ERR) {
+    enqueue((uintptr_t)ptr);
+    requeued_count++;
+  }
+}
+/*****************************************************************************/
+UNIT_TEST_REGISTER(clear_tables, "Clear the neighbor tables");
+UNIT_TEST(clear_tables)
+{
+  UNIT_TEST_BEGIN();
+
+  unsigned i;
+
+  for(i = 0; i < 4; i++) {
+    enqueue_with_callback(i, packet_sent_requeue);
+  }
+
+  in_nbr_table_clear = 1;
+  nbr_table_clear();
+  in_nbr_table_clear = 0;
+
+  /* The packets are failed later, not from within the neighbor table */
+  UNIT_TEST_ASSERT(!sent_in_nbr_table_clear);
+  UNIT_TEST_ASSERT(tx_err_count == 0);
+
+  UNIT_TEST_END();
+}
+#endif /* CSMA_WITH_NBR_TABLE_QUEUES */
+/*****************************************************************************/
+PROCESS_THREAD(test_csma_queue_process, ev, data)
+{
+  static int failed;
+
+  PROCESS_BEGIN();
+
+  printf("Run unit-test\n");
+  printf("---\n");
+
+  for(active_neighbors = 1; active_neighbors <= MAX_ACTIVE_NEIGHBORS;
+      active_neighbors *= 2) {
+    sent_count = 0;
+    UNIT_TEST_RUN(enqueue_cost);
+    if(!UNIT_TEST_PASSED(enqueue_cost)) {
+      failed = 1;
+    }
+
+    /* Let CSMA drain all queues before the next round */
+    while(sent_count < 2 * active_neighbors) {
+      PROCESS_PAUSE();
+    }
+  }
+
+#if CSMA_WITH_NBR_TABLE_QUEUES
+  sent_count = 0;
+  UNIT_TEST_RUN(clear_tables);
+  if(!UNIT_TEST_PASSED(clear_tables)) {
+    failed = 1;
+  }
+
+  /* Every dropped packet fails with MAC_TX_ERR and its sent callback
+     queues a new packet, which is then sent */
+  while(sent_count < 8) {
+    PROCESS_PAUSE();
+  }
+  if(tx_err_count != 4 || requeued_count != 4) {
+    printf("Clearing the neighbor tables: %u packets failed, %u queued again\n",
+           tx_err_count, requeued_count);
+    failed = 1;
+  }
+#endif /* CSMA_WITH_NBR_TABLE_QUEUES */
+
+  if(failed) {
+    printf("=check-me= FAILED\n");
+    printf("---\n");
+  }
+
+  printf("=check-me= DONE\n");
+  printf("---\n");
+
+  PROCESS_END();
+}
@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ *      Checks tsch_schedule_get_next_active_link() against a linear walk of
+ *      the schedule, and measures its cost for growing schedules.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "contiki.h"
+#include "net/mac/tsch/tsch.h"
+#include "unit-test/unit-test.h"
+/*****************************************************************************/
+/* Slotframe sizes, as used by Orchestra with a 6TiSCH minimal cell */
+static const uint16_t slotframe_sizes[] = { 397, 101, 31, 7 };
+#define NUM_SLOTFRAMES (sizeof(slotframe_sizes) / sizeof(slotframe_sizes[0]))
+/* Largest number of links benchmarked */
+#define MAX_LINKS TSCH_SCHEDULE_MAX_LINKS
+/* Number of neighbors the Tx links are spread over */
+#define NUM_NEIGHBORS 48
+/* Number of consecutive ASNs checked against the reference */
+#define CHECKED_ASNS 20000
+/* Number of lookups timed */
+#define TIMED_LOOKUPS 200000
+/*****************************************************************************/
+PROCESS(test_tsch_schedule_process, "TSCH schedule test process");
+AUTOSTART_PROCESSES(&test_tsch_schedule_process);
+
+static unsigned num_links;
+/*****************************************************************************/
+/* Stubs for the parts of TSCH the schedule module depends on. The schedule
+ * is never locked here, and neighbor queues are always empty. */
+const linkaddr_t tsch_broadcast_address = { { 0xff, 0xff } };
+struct tsch_link *current_link;
+
+int
+tsch_is_locked(void)
+{
+  return 0;
+}
+
+int
+tsch_get_lock(void)
+{
+  return 1;
+}
+
+void
+tsch_release_lock(void)
+{
+}
+
+struct tsch_neighbor *
+tsch_queue_add_nbr(const linkaddr_t *addr)
+{
+  return NULL;
+}
+
+struct tsch_neighbor *
+tsch_queue_get_nbr(const linkaddr_t *addr)
+{
+  return NULL;
+}
+
+void
+tsch_queue_update_ready(const struct tsch_neighbor *n)
+{
+}
+/*****************************************************************************/
+static uint64_t
+now_ns(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+/*****************************************************************************/
+static void
+create_schedule(unsigned links)
+{
+  static const uint8_t options[] = {
+    LINK_OPTION_RX,
+    LINK_OPTION_TX,
+    LINK_OPTION_TX | LINK_OPTION_RX | LINK_OPTION_SHARED,
+  };
+  struct tsch_slotframe *sf[NUM_SLOTFRAMES];
+  linkaddr_t addr;
+  unsigned total_slots = 0;
+  unsigned i;
+
+  tsch_schedule_remove_all_slotframes();
+  for(i = 0; i < NUM_SLOTFRAMES; i++) {
+    sf[i] = tsch_schedule_add_slotframe(i, slotframe_sizes[i]);
+    total_slots += slotframe_sizes[i];
+  }
+
+  /* Spread the links uniformly over the timeslots of all slotframes */
+  srand(links);
+  for(i = 0; i < links; i++) {
+    unsigned slot = rand() % total_slots;
+    unsigned s = 0;
+    while(slot >= slotframe_sizes[s]) {
+      slot -= slotframe_sizes[s];
+      s++;
+    }
+    memset(&addr, 0, sizeof(addr));
+    addr.u8[LINKADDR_SIZE - 1] = 1 + rand() % NUM_NEIGHBORS;
+    tsch_schedule_add_link(sf[s], options[rand() % 3], LINK_TYPE_NORMAL, &addr,
+                           slot, rand() % 4, 0);
+  }
+}
+/*****************************************************************************/
+/* Reference: walks all links, with the default link comparator on empty
+ * queues (which keeps the current best link) */
+static struct tsch_link *
+reference_next_active_link(struct tsch_asn_t *asn, uint16_t *time_offset,
+                           struct tsch_link **backup_link)
+{
+  uint16_t time_to_curr_best = 0;
+  struct tsch_link *curr_best = NULL;
+  struct tsch_link *curr_backup = NULL;
+  struct tsch_slotframe *sf;
+  struct tsch_link *l;
+
+  for(sf = tsch_schedule_slotframe_head(); sf != NULL;
+      sf = tsch_schedule_slotframe_next(sf)) {
+    uint16_t timeslot = TSCH_ASN_MOD(*asn, sf->size);
+    for(l = list_head(sf->links_list); l != NULL; l = list_item_next(l)) {
+      uint16_t time_to_timeslot = l->timeslot > timeslot ?
+        l->timeslot - timeslot : sf->size.val + l->timeslot - timeslot;
+      if(curr_best == NULL || time_to_timeslot < time_to_curr_best) {
+        time_to_curr_best = time_to_timeslot;
+        curr_best = l;
+        curr_backup = NULL;
+      } else if(time_to_timeslot == time_to_curr_best) {
+        struct tsch_link *new_best = NULL;
+        if((curr_best->link_options & LINK_OPTION_TX) == (l->link_options & LINK_OPTION_TX)) {
+          if(l->slotframe_handle < curr_best->slotframe_handle) {
+            new_best = l;
+          } else if(l->slotframe_handle == curr_best->slotframe_handle) {
+            new_best = curr_best;
+          }
+        } else if(l->link_options & LINK_OPTION_TX) {
+          new_best = l;
+        }
+        if(new_best != l && (l->link_options & LINK_OPTION_RX)) {
+          if(curr_backup == NULL || l->slotframe_handle < curr_backup->slotframe_handle) {
+            curr_backup = l;
+          }
+        }
+        if(new_best != curr_best && (curr_best->link_options & LINK_OPTION_RX)) {
+          if(curr_backup == NULL || curr_best->slotframe_handle < curr_backup->slotframe_handle) {
+            curr_backup = curr_best;
+          }
+        }
+        if(new_best != NULL) {
+          curr_best = new_best;
+        }
+      }
+    }
+  }
+  *time_offset = time_to_curr_best;
+  *backup_link = curr_backup;
+  return curr_best;
+}
+/*****************************************************************************/
+UNIT_TEST_REGISTER(next_active_link, "Next active link");
+UNIT_TEST(next_active_link)
+{
+  UNIT_TEST_BEGIN();
+
+  struct tsch_asn_t asn;
+  struct tsch_link *link;
+  struct tsch_link *backup;
+  struct tsch_link *ref_link;
+  struct tsch_link *ref_backup;
+  uint16_t offset;
+  uint16_t ref_offset;
+  uint64_t start;
+  uint64_t duration;
+  unsigned mismatches = 0;
+  unsigned i;
+
+  create_schedule(num_links);
+
+  TSCH_ASN_INIT(asn, 0, 0);
+  for(i = 0; i < CHECKED_ASNS; i++) {
+    link = tsch_schedule_get_next_active_link(&asn, &offset, &backup);
+    ref_link = reference_next_active_link(&asn, &ref_offset, &ref_backup);
+    if(link != ref_link || offset != ref_offset || backup != ref_backup) {
+      mismatches++;
+    }
+    TSCH_ASN_INC(asn, 1);
+  }
+
+  TSCH_ASN_INIT(asn, 0, 0);
+  start = now_ns();
+  for(i = 0; i < TIMED_LOOKUPS; i++) {
+    link = tsch_schedule_get_next_active_link(&asn, &offset, &backup);
+    TSCH_ASN_INC(asn, offset);
+  }
+  duration = now_ns() - start;
+
+  printf("Links: %3u, next active link lookup: %5lu ns\n",
+         num_links, (unsigned long)(duration / TIMED_LOOKUPS));
+
+  UNIT_TEST_ASSERT(mismatches == 0);
+
+  UNIT_TEST_END();
+}
+/*****************************************************************************/
+PROCESS_THREAD(test_tsch_schedule_process, ev, data)
+{
+  static int failed;
+
+  PROCESS_BEGIN();
+
+  printf("Run unit-test\n");
+  printf("---\n");
+
+  for(num_links = 16; num_links <= MAX_LINKS; num_links *= 2) {
+    UNIT_TEST_RUN(next_active_link);
+    if(!UNIT_TEST_PASSED(next_active_link)) {
+      failed = 1;
+    }
+  }
+
+  tsch_schedule_remove_all_slotframes();
+
+  if(failed) {
+    printf("=check-me= FAILED\n");
+    printf("---\n");
+  }
+
+  printf("=check-me= DONE\n");
+  printf("---\n");
+
+  PROCESS_END();
+}
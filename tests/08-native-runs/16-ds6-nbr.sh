@@ -0,0 +1,3 @@
+#!/bin/bash -e
+
+./run-one.sh 16-ds6-nbr
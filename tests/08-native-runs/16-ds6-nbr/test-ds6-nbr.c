@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ *      Checks uip_ds6_nbr_lookup() against a linear walk of the neighbor
+ *      cache, also when a neighbor gets a second address, and measures
+ *      its cost with a full neighbor table.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "contiki.h"
+#include "net/ipv6/uip-ds6.h"
+#include "net/ipv6/uip-ds6-nbr.h"
+#include "unit-test/unit-test.h"
+/*****************************************************************************/
+#define NUM_NEIGHBORS NBR_TABLE_MAX_NEIGHBORS
+/* Number of lookups timed */
+#define TIMED_LOOKUPS 300000
+/*****************************************************************************/
+PROCESS(test_ds6_nbr_process, "IPv6 neighbor cache test process");
+AUTOSTART_PROCESSES(&test_ds6_nbr_process);
+/*****************************************************************************/
+static uint64_t
+now_ns(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+/*****************************************************************************/
+/* The link-layer and link-local SLAAC address of neighbor i */
+static void
+neighbor_addr(unsigned i, uip_lladdr_t *lladdr, uip_ipaddr_t *ipaddr)
+{
+  memset(lladdr, 0, sizeof(*lladdr));
+  lladdr->addr[0] = 0x02;
+  lladdr->addr[sizeof(*lladdr) - 2] = i >> 8;
+  lladdr->addr[sizeof(*lladdr) - 1] = i & 0xff;
+  uip_ip6addr(ipaddr, 0xfe80, 0, 0, 0, 0, 0, 0, 0);
+  uip_ds6_set_addr_iid(ipaddr, lladdr);
+}
+/*****************************************************************************/
+/* The lookup as done before the neighbor cache was indexed */
+static uip_ds6_nbr_t *
+reference_lookup(const uip_ipaddr_t *ipaddr)
+{
+  uip_ds6_nbr_t *nbr;
+  for(nbr = uip_ds6_nbr_head(); nbr != NULL; nbr = uip_ds6_nbr_next(nbr)) {
+    if(uip_ipaddr_cmp(&nbr->ipaddr, ipaddr)) {
+      return nbr;
+    }
+  }
+  return NULL;
+}
+/*****************************************************************************/
+static unsigned
+count_mismatches(void)
+{
+  uip_lladdr_t lladdr;
+  uip_ipaddr_t ipaddr;
+  unsigned mismatches = 0;
+  unsigned i;
+
+  /* One more than the table size: the last address is never present */
+  for(i = 0; i <= NUM_NEIGHBORS; i++) {
+    neighbor_addr(i, &lladdr, &ipaddr);
+    if(uip_ds6_nbr_lookup(&ipaddr) != reference_lookup(&ipaddr)) {
+      mismatches++;
+    }
+  }
+  return mismatches;
+}
+/*****************************************************************************/
+UNIT_TEST_REGISTER(nbr_lookup, "Neighbor cache lookup");
+UNIT_TEST(nbr_lookup)
+{
+  uip_lladdr_t lladdr;
+  uip_ipaddr_t ipaddr;
+  uip_ds6_nbr_t *nbr;
+  uint64_t start;
+  uint64_t hashed;
+  uint64_t linear;
+  unsigned added = 0;
+  unsigned mismatches;
+  unsigned i;
+
+  UNIT_TEST_BEGIN();
+
+  for(i = 0; i < NUM_NEIGHBORS; i++) {
+    neighbor_addr(i, &lladdr, &ipaddr);
+    if(uip_ds6_nbr_add(&ipaddr, &lladdr, 0, NBR_REACHABLE,
+                       NBR_TABLE_REASON_IPV6_ND, NULL) != NULL) {
+      added++;
+    }
+  }
+  UNIT_TEST_ASSERT(added == NUM_NEIGHBORS);
+  mismatches = count_mismatches();
+
+  /* Time lookups of all neighbors, in turn */
+  start = now_ns();
+  for(i = 0; i < TIMED_LOOKUPS; i++) {
+    neighbor_addr(i % NUM_NEIGHBORS, &lladdr, &ipaddr);
+    mismatches += uip_ds6_nbr_lookup(&ipaddr) == NULL;
+  }
+  hashed = now_ns() - start;
+
+  start = now_ns();
+  for(i = 0; i < TIMED_LOOKUPS; i++) {
+    neighbor_addr(i % NUM_NEIGHBORS, &lladdr, &ipaddr);
+    mismatches += reference_lookup(&ipaddr) == NULL;
+  }
+  linear = now_ns() - start;
+
+  printf("Neighbors: %u, lookup: %lu ns (linear walk: %lu ns)\n", added,
+         (unsigned long)(hashed / TIMED_LOOKUPS),
+         (unsigned long)(linear / TIMED_LOOKUPS));
+
+  /* Remove every third neighbor, and change the link-layer address of
+   * every fifth one */
+  for(i = 0; i < NUM_NEIGHBORS; i += 3) {
+    neighbor_addr(i, &lladdr, &ipaddr);
+    uip_ds6_nbr_rm(uip_ds6_nbr_lookup(&ipaddr));
+  }
+  for(i = 1; i < NUM_NEIGHBORS; i += 5) {
+    neighbor_addr(i, &lladdr, &ipaddr);
+    nbr = uip_ds6_nbr_lookup(&ipaddr);
+    if(nbr != NULL) {
+      lladdr.addr[0] = 0x06;
+      uip_ds6_nbr_update_ll(&nbr, &lladdr);
+    }
+  }
+  mismatches += count_mismatches();
+
+  /* Empty the cache */
+  while((nbr = uip_ds6_nbr_head()) != NULL) {
+    uip_ds6_nbr_rm(nbr);
+  }
+  mismatches += count_mismatches();
+
+  UNIT_TEST_ASSERT(mismatches == 0);
+
+  UNIT_TEST_END();
+}
+/*****************************************************************************/
+UNIT_TEST_REGISTER(second_addr, "Second address of a neighbor");
+UNIT_TEST(second_addr)
+{
+  uip_lladdr_t lladdr;
+  uip_ipaddr_t link_local;
+  uip_ipaddr_t global;
+  uip_ds6_nbr_t *nbr;
+  unsigned i;
+
+  UNIT_TEST_BEGIN();
+
+  /* Neighbors sharing the buckets of the one that gets a second address */
+  for(i = 0; i < 3; i++) {
+    neighbor_addr(i, &lladdr, &link_local);
+    uip_ds6_nbr_add(&link_local, &lladdr, 0, NBR_REACHABLE,
+                    NBR_TABLE_REASON_IPV6_ND, NULL);
+  }
+  neighbor_addr(1, &lladdr, &link_local);
+  uip_ipaddr_copy(&global, &link_local);
+  global.u16[0] = UIP_HTONS(0xfd00);
+
+  /* As for a neighbor solicitation from its global address */
+  nbr = uip_ds6_nbr_add(&global, &lladdr, 0, NBR_REACHABLE,
+                        NBR_TABLE_REASON_IPV6_ND, NULL);
+  UNIT_TEST_ASSERT(nbr != NULL);
+  UNIT_TEST_ASSERT(uip_ds6_nbr_lookup(&global) == nbr);
+  UNIT_TEST_ASSERT(uip_ds6_nbr_lookup(&link_local) ==
+                   reference_lookup(&link_local));
+  UNIT_TEST_ASSERT(count_mismatches() == 0);
+
+  while((nbr = uip_ds6_nbr_head()) != NULL) {
+    uip_ds6_nbr_rm(nbr);
+  }
+  UNIT_TEST_ASSERT(uip_ds6_nbr_lookup(&global) == NULL);
+  UNIT_TEST_ASSERT(count_mismatches() == 0);
+
+  UNIT_TEST_END();
+}
+/*****************************************************************************/
+PROCESS_THREAD(test_ds6_nbr_process, ev, data)
+{
+  PROCESS_BEGIN();
+
+  printf("Run unit-test\n");
+  printf("---\n");
+
+  UNIT_TEST_RUN(nbr_lookup);
+  UNIT_TEST_RUN(second_addr);
+
+  if(!UNIT_TEST_PASSED(nbr_lookup) || !UNIT_TEST_PASSED(second_addr)) {
+    printf("=check-me= FAILED\n");
+    printf("---\n");
+  }
+
+  printf("=check-me= DONE\n");
+  printf("---\n");
+
+  PROCESS_END();
+}
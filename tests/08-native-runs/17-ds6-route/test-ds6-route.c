@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+
+/**
+ * \file
+ *      Checks uip_ds6_route_lookup() with the hashed routing table
+ *      against a linear longest-prefix match, and measures its cost with
+ *      a table full of host routes.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "contiki.h"
+#include "net/ipv6/uip-ds6.h"
+#include "net/ipv6/uip-ds6-nbr.h"
+#include "net/ipv6/uip-ds6-route.h"
+#include "unit-test/unit-test.h"
+/*****************************************************************************/
+#define NUM_NEXTHOPS 4
+#define NUM_PREFIXES 3
+#define NUM_HOSTS (UIP_DS6_ROUTE_NB - NUM_PREFIXES)
+/* Number of lookups timed */
+#define TIMED_LOOKUPS 300000
+/*****************************************************************************/
+PROCESS(test_ds6_route_process, "IPv6 routing table test process");
+AUTOSTART_PROCESSES(&test_ds6_route_process);
+/*****************************************************************************/
+static uip_ipaddr_t nexthops[NUM_NEXTHOPS];
+/*****************************************************************************/
+static uint64_t
+now_ns(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+/*****************************************************************************/
+/* The address of host i, all under fd00::/64 */
+static void
+host_addr(unsigned i, uip_ipaddr_t *ipaddr)
+{
+  uip_ip6addr(ipaddr, 0xfd00, 0, 0, 0, 0x0200, 0, i >> 16, (i & 0xffff) + 1);
+}
+/*****************************************************************************/
+/* The longest-prefix match as done before the table was indexed */
+static uip_ds6_route_t *
+reference_lookup(const uip_ipaddr_t *addr)
+{
+  uip_ds6_route_t *r;
+  uip_ds6_route_t *found = NULL;
+  for(r = uip_ds6_route_head(); r != NULL; r = uip_ds6_route_next(r)) {
+    if((found == NULL || r->length > found->length) &&
+       uip_ipaddr_prefixcmp(addr, &r->ipaddr, r->length)) {
+      found = r;
+    }
+  }
+  return found;
+}
+/*****************************************************************************/
+static unsigned
+check_addr(const uip_ipaddr_t *addr)
+{
+  return uip_ds6_route_lookup(addr) != reference_lookup(addr);
+}
+/*****************************************************************************/
+static unsigned
+count_mismatches(void)
+{
+  uip_ipaddr_t addr;
+  unsigned mismatches = 0;
+  unsigned i;
+
+  /* One more than the number of hosts: the last one has no host route */
+  for(i = 0; i <= NUM_HOSTS; i++) {
+    host_addr(i, &addr);
+    mismatches += check_addr(&addr);
+  }
+  /* Addresses covered by a prefix route only, or by none */
+  uip_ip6addr(&addr, 0xfd00, 0, 0, 0, 0, 0, 1, 2);
+  mismatches += check_addr(&addr);
+  uip_ip6addr(&addr, 0xfd00, 0, 0, 1, 0, 0, 0, 5);
+  mismatches += check_addr(&addr);
+  uip_ip6addr(&addr, 0xfd00, 5, 0, 0, 0, 0, 0, 1);
+  mismatches += check_addr(&addr);
+  uip_ip6addr(&addr, 0xfe00, 0, 0, 0, 0, 0, 0, 1);
+  mismatches += check_addr(&addr);
+  return mismatches;
+}
+/*****************************************************************************/
+UNIT_TEST_REGISTER(route_lookup, "Routing table lookup");
+UNIT_TEST(route_lookup)
+{
+  uip_lladdr_t lladdr;
+  uip_ipaddr_t addr;
+  uip_ds6_route_t *r;
+  uint64_t start;
+  uint64_t hashed;
+  uint64_t linear;
+  unsigned mismatches;
+  unsigned i;
+
+  UNIT_TEST_BEGIN();
+
+  for(i = 0; i < NUM_NEXTHOPS; i++) {
+    memset(&lladdr, 0, sizeof(lladdr));
+    lladdr.addr[0] = 0x02;
+    lladdr.addr[sizeof(lladdr) - 1] = i + 1;
+    uip_ip6addr(&nexthops[i], 0xfe80, 0, 0, 0, 0, 0, 0, 0);
+    uip_ds6_set_addr_iid(&nexthops[i], &lladdr);
+    UNIT_TEST_ASSERT(uip_ds6_nbr_add(&nexthops[i], &lladdr, 0, NBR_REACHABLE,
+                                     NBR_TABLE_REASON_IPV6_ND, NULL) != NULL);
+  }
+
+  for(i = 0; i < NUM_HOSTS; i++) {
+    host_addr(i, &addr);
+    UNIT_TEST_ASSERT(uip_ds6_route_add(&addr, 128,
+                                       &nexthops[1 + i % (NUM_NEXTHOPS - 1)]) != NULL);
+  }
+  /* Adding a route replaces the one that its address currently
+   * matches: add the prefixes last, with distinct base addresses */
+  uip_ip6addr(&addr, 0xfd00, 0, 0, 0, 0, 0, 0, 0);
+  UNIT_TEST_ASSERT(uip_ds6_route_add(&addr, 64, &nexthops[0]) != NULL);
+  uip_ip6addr(&addr, 0xfd00, 0, 0, 1, 0, 0, 0, 0);
+  UNIT_TEST_ASSERT(uip_ds6_route_add(&addr, 64, &nexthops[1]) != NULL);
+  uip_ip6addr(&addr, 0xfd00, 0xffff, 0, 0, 0, 0, 0, 0);
+  UNIT_TEST_ASSERT(uip_ds6_route_add(&addr, 16, &nexthops[2]) != NULL);
+  UNIT_TEST_ASSERT(uip_ds6_route_num_routes() == UIP_DS6_ROUTE_NB);
+  mismatches = count_mismatches();
+
+  /* Time lookups of all hosts, in turn */
+  start = now_ns();
+  for(i = 0; i < TIMED_LOOKUPS; i++) {
+    host_addr(i % NUM_HOSTS, &addr);
+    mismatches += uip_ds6_route_lookup(&addr) == NULL;
+  }
+  hashed = now_ns() - start;
+
+  start = now_ns();
+  for(i = 0; i < TIMED_LOOKUPS; i++) {
+    host_addr(i % NUM_HOSTS, &addr);
+    mismatches += reference_lookup(&addr) == NULL;
+  }
+  linear = now_ns() - start;
+
+  printf("Routes: %u, lookup: %lu ns (linear walk: %lu ns)\n",
+         uip_ds6_route_num_routes(),
+         (unsigned long)(hashed / TIMED_LOOKUPS),
+         (unsigned long)(linear / TIMED_LOOKUPS));
+
+  /* Use every route but the host route to host 7: adding a route to a
+   * full table then evicts it, and host 7 falls back to fd00::/64 */
+  count_mismatches(); /* Uses the prefix routes after host 7 */
+  host_addr(7, &addr);
+  r = reference_lookup(&addr);
+  for(i = 0; i < NUM_HOSTS; i++) {
+    if(i != 7) {
+      host_addr(i, &addr);
+      uip_ds6_route_lookup(&addr);
+    }
+  }
+  uip_ip6addr(&addr, 0xfd02, 0, 0, 0, 0, 0, 0, 1);
+  UNIT_TEST_ASSERT(uip_ds6_route_add(&addr, 128, &nexthops[3]) != NULL);
+  UNIT_TEST_ASSERT(uip_ds6_route_num_routes() == UIP_DS6_ROUTE_NB);
+  host_addr(7, &addr);
+  UNIT_TEST_ASSERT(uip_ds6_route_lookup(&addr) != r);
+  UNIT_TEST_ASSERT(uip_ds6_route_lookup(&addr)->length == 64);
+  mismatches += count_mismatches();
+
+  /* Remove every third host route, then all routes via one next hop */
+  for(i = 0; i < NUM_HOSTS; i += 3) {
+    host_addr(i, &addr);
+    r = uip_ds6_route_lookup(&addr);
+    if(r != NULL && r->length == 128) {
+      uip_ds6_route_rm(r);
+    }
+  }
+  mismatches += count_mismatches();
+  uip_ds6_route_rm_by_nexthop(&nexthops[1]);
+  mismatches += count_mismatches();
+
+  /* Empty the table */
+  while((r = uip_ds6_route_head()) != NULL) {
+    uip_ds6_route_rm(r);
+  }
+  UNIT_TEST_ASSERT(uip_ds6_route_num_routes() == 0);
+  mismatches += count_mismatches();
+
+  UNIT_TEST_ASSERT(mismatches == 0);
+
+  UNIT_TEST_END();
+}
+/*****************************************************************************/
+PROCESS_THREAD(test_ds6_route_process, ev, data)
+{
+  PROCESS_BEGIN();
+
+  printf("Run unit-test\n");
+  printf("---\n");
+
+  UNIT_TEST_RUN(route_lookup);
+
+  if(!UNIT_TEST_PASSED(route_lookup)) {
+    printf("=check-me= FAILED\n");
+    printf("---\n");
+  }
+
+  printf("=check-me= DONE\n");
+  printf("---\n");
+
+  PROCESS_END();
+}
@@ -0,0 +1,255 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ *      Tests of the sorted event timer list: timers expire in the order of
+ *      their expiration time, timers that expire at the same time keep the
+ *      order they were set in, and every timer expires once, not before its
+ *      time and within a bounded latency, including in a burst of
+ *      simultaneous expirations. Stopped timers must not expire, and a
+ *      timer set again or adjusted while pending takes its new place.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "contiki.h"
+#include "lib/random.h"
+#include "unit-test/unit-test.h"
+/*****************************************************************************/
+#define NUM_TIMERS 4000
+/* Every STOP_EVERY-th timer is stopped before it expires */
+#define STOP_EVERY 10
+/* Largest delay accepted between the expiration time of a timer and its
+   event, including when all timers expire at once */
+#define MAX_LATENCY (CLOCK_SECOND / 10)
+/*****************************************************************************/
+PROCESS(test_etimer_process, "Event timer test process");
+AUTOSTART_PROCESSES(&test_etimer_process);
+/*****************************************************************************/
+static struct etimer timers[NUM_TIMERS];
+static uint8_t fired[NUM_TIMERS];
+static unsigned expired_count;
+static unsigned expected_count;
+/* The previous expiration time and index of the timers that expired */
+static clock_time_t last_expiration;
+static unsigned last_index;
+/* Results of the checks of every expiration */
+static unsigned unknown_count;
+static unsigned repeated_count;
+static unsigned early_count;
+static unsigned out_of_order_count;
+static unsigned out_of_fifo_order_count;
+static clock_time_t max_latency;
+/*****************************************************************************/
+static void
+reset_checks(void)
+{
+  memset(fired, 0, sizeof(fired));
+  expired_count = 0;
+  unknown_count = 0;
+  repeated_count = 0;
+  early_count = 0;
+  out_of_order_count = 0;
+  out_of_fifo_order_count = 0;
+  max_latency = 0;
+}
+/*****************************************************************************/
+/* Checks an expiration, in the order the events are received */
+static void
+check_expiration(struct etimer *et)
+{
+  unsigned i = et - timers;
+  clock_time_t expiration = etimer_expiration_time(et);
+  clock_time_t latency = clock_time() - expiration;
+
+  if(i >= NUM_TIMERS) {
+    unknown_count++;
+    return;
+  }
+  if(fired[i]) {
+    repeated_count++;
+  }
+  fired[i] = 1;
+  if(!etimer_expired(et) || latency > CLOCK_SECOND * 60) {
+    early_count++;
+  } else if(latency > max_latency) {
+    max_latency = latency;
+  }
+  if(expired_count > 0) {
+    if((clock_time_t)(expiration - last_expiration) > CLOCK_SECOND * 60) {
+      out_of_order_count++;
+    } else if(expiration == last_expiration && i < last_index) {
+      out_of_fifo_order_count++;
+    }
+  }
+  last_expiration = expiration;
+  last_index = i;
+  expired_count++;
+}
+/*****************************************************************************/
+static unsigned
+count_pending(void)
+{
+  unsigned i;
+  unsigned count = 0;
+
+  for(i = 0; i < NUM_TIMERS; i++) {
+    if(!etimer_expired(&timers[i])) {
+      count++;
+    }
+  }
+  return count;
+}
+/*****************************************************************************/
+UNIT_TEST_REGISTER(random_intervals, "Random intervals");
+UNIT_TEST(random_intervals)
+{
+  UNIT_TEST_BEGIN();
+
+  UNIT_TEST_ASSERT(unknown_count == 0);
+  UNIT_TEST_ASSERT(repeated_count == 0);
+  UNIT_TEST_ASSERT(early_count == 0);
+  UNIT_TEST_ASSERT(out_of_order_count == 0);
+  UNIT_TEST_ASSERT(out_of_fifo_order_count == 0);
+  UNIT_TEST_ASSERT(max_latency <= MAX_LATENCY);
+  UNIT_TEST_ASSERT(expired_count == expected_count);
+  UNIT_TEST_ASSERT(count_pending() == 0);
+
+  UNIT_TEST_END();
+}
+/*****************************************************************************/
+UNIT_TEST_REGISTER(burst, "Simultaneous expirations");
+UNIT_TEST(burst)
+{
+  UNIT_TEST_BEGIN();
+
+  UNIT_TEST_ASSERT(unknown_count == 0);
+  UNIT_TEST_ASSERT(repeated_count == 0);
+  UNIT_TEST_ASSERT(early_count == 0);
+  UNIT_TEST_ASSERT(out_of_order_count == 0);
+  UNIT_TEST_ASSERT(out_of_fifo_order_count == 0);
+  UNIT_TEST_ASSERT(max_latency <= MAX_LATENCY);
+  UNIT_TEST_ASSERT(expired_count == NUM_TIMERS);
+
+  UNIT_TEST_END();
+}
+/*****************************************************************************/
+UNIT_TEST_REGISTER(reorder, "Set again, adjust and stop pending timers");
+UNIT_TEST(reorder)
+{
+  UNIT_TEST_BEGIN();
+
+  /* Expected order: timers 2, 0, then 3 */
+  UNIT_TEST_ASSERT(unknown_count == 0);
+  UNIT_TEST_ASSERT(repeated_count == 0);
+  UNIT_TEST_ASSERT(early_count == 0);
+  UNIT_TEST_ASSERT(expired_count == 3);
+  UNIT_TEST_ASSERT(fired[0] && !fired[1] && fired[2] && fired[3]);
+  UNIT_TEST_ASSERT(last_index == 3);
+  UNIT_TEST_ASSERT(out_of_order_count == 0);
+
+  UNIT_TEST_END();
+}
+/*****************************************************************************/
+PROCESS_THREAD(test_etimer_process, ev, data)
+{
+  static int failed;
+  static unsigned i;
+
+  PROCESS_BEGIN();
+
+  printf("Run unit-test\n");
+  printf("---\n");
+
+  /* Random intervals, some timers stopped before they expire */
+  reset_checks();
+  for(i = 0; i < NUM_TIMERS; i++) {
+    etimer_set(&timers[i], 1 + random_rand() % CLOCK_SECOND);
+  }
+  for(i = 0; i < NUM_TIMERS; i += STOP_EVERY) {
+    etimer_stop(&timers[i]);
+  }
+  expected_count = NUM_TIMERS - (NUM_TIMERS + STOP_EVERY - 1) / STOP_EVERY;
+  while(expired_count < expected_count) {
+    PROCESS_WAIT_EVENT_UNTIL(ev == PROCESS_EVENT_TIMER);
+    check_expiration(data);
+  }
+  UNIT_TEST_RUN(random_intervals);
+  if(!UNIT_TEST_PASSED(random_intervals)) {
+    failed = 1;
+  }
+
+  /* All timers expire at once, in the order they were set */
+  reset_checks();
+  for(i = 0; i < NUM_TIMERS; i++) {
+    etimer_set(&timers[i], CLOCK_SECOND / 4);
+  }
+  while(expired_count < NUM_TIMERS) {
+    PROCESS_WAIT_EVENT_UNTIL(ev == PROCESS_EVENT_TIMER);
+    check_expiration(data);
+  }
+  UNIT_TEST_RUN(burst);
+  if(!UNIT_TEST_PASSED(burst)) {
+    failed = 1;
+  }
+
+  /* Pending timers moved around in the list */
+  reset_checks();
+  etimer_set(&timers[0], CLOCK_SECOND / 2);
+  etimer_set(&timers[1], CLOCK_SECOND / 4);
+  etimer_set(&timers[2], CLOCK_SECOND);
+  etimer_set(&timers[3], CLOCK_SECOND / 8);
+  /* Timer 2 now expires first, and timer 3 last */
+  etimer_adjust(&timers[2], -(int)(CLOCK_SECOND - CLOCK_SECOND / 16));
+  etimer_set(&timers[3], CLOCK_SECOND * 3 / 4);
+  etimer_stop(&timers[1]);
+  while(expired_count < 3) {
+    PROCESS_WAIT_EVENT_UNTIL(ev == PROCESS_EVENT_TIMER);
+    check_expiration(data);
+    if(expired_count == 1 && last_index != 2) {
+      out_of_order_count++;
+    }
+  }
+  UNIT_TEST_RUN(reorder);
+  if(!UNIT_TEST_PASSED(reorder)) {
+    failed = 1;
+  }
+
+  if(failed) {
+    printf("=check-me= FAILED\n");
+    printf("---\n");
+  }
+
+  printf("=check-me= DONE\n");
+  printf("---\n");
+
+  PROCESS_END();
+}
@@ -0,0 +1,329 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ *      Tests of the callback timers in the timing wheel: timers expire at
+ *      their tick, rounded up to the coarse tick for long ones, across the
+ *      cascades from the coarse to the fine wheel; stopped timers do not
+ *      expire and reset timers expire again; stopping or setting a timer
+ *      that was never set, or a copy of a pending timer, leaves the wheel
+ *      intact, and timers survive a later ctimer_init().
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "contiki.h"
+#include "lib/random.h"
+#include "unit-test/unit-test.h"
+/*****************************************************************************/
+#define NUM_TIMERS 2000
+/* Timers are set to expire within MAX_INTERVAL */
+#define MAX_INTERVAL (3 * CLOCK_SECOND)
+/* Every STOP_EVERY-th timer is stopped before it expires */
+#define STOP_EVERY 10
+/* Every RESET_EVERY-th timer is reset once when it expires */
+#define RESET_EVERY 7
+/* Largest delay accepted between the expiration tick of a timer and its
+   callback */
+#define MAX_LATENCY (CLOCK_SECOND / 20)
+/*****************************************************************************/
+/* Marks the timers pending in the wheel */
+PROCESS_NAME(ctimer_process);
+
+PROCESS(test_ctimer_process, "Callback timer test process");
+AUTOSTART_PROCESSES(&test_ctimer_process);
+/*****************************************************************************/
+static struct ctimer timers[NUM_TIMERS];
+/* Copy of a pending timer, which the wheel does not hold */
+static struct ctimer copied;
+static uint8_t fired[NUM_TIMERS];
+static unsigned errors;
+static unsigned early_count;
+static clock_time_t max_latency;
+/*****************************************************************************/
+/* Clock time a is before b, across wrap-around */
+#define TIME_LT(a, b) \
+  ((clock_time_t)((a) - (b)) > ((clock_time_t)~(clock_time_t)0 >> 1))
+/*****************************************************************************/
+static void
+reset_checks(void)
+{
+  memset(fired, 0, sizeof(fired));
+  errors = 0;
+  early_count = 0;
+  max_latency = 0;
+}
+/*****************************************************************************/
+/* Tick at which the wheel expires a timer */
+static clock_time_t
+expiration_tick(struct ctimer *c)
+{
+  clock_time_t expiration = etimer_expiration_time(&c->etimer);
+
+  if(c->etimer.timer.interval > CTIMER_WHEEL_SLOTS) {
+    /* Long timers are rounded up to the coarse tick */
+    expiration += (CTIMER_WHEEL_COARSE_TICK -
+                   expiration % CTIMER_WHEEL_COARSE_TICK) %
+      CTIMER_WHEEL_COARSE_TICK;
+  }
+  return expiration;
+}
+/*****************************************************************************/
+static void
+callback(void *ptr)
+{
+  struct ctimer *c = ptr;
+  unsigned i = c - timers;
+  clock_time_t now = clock_time();
+  clock_time_t expiration = expiration_tick(c);
+
+  if(i >= NUM_TIMERS || !ctimer_expired(c) ||
+     PROCESS_CURRENT() != &test_ctimer_process) {
+    /* Unknown, still pending or in the wrong context */
+    errors++;
+    return;
+  }
+  if(TIME_LT(now, expiration)) {
+    early_count++;
+  } else if((clock_time_t)(now - expiration) > max_latency) {
+    max_latency = now - expiration;
+  }
+  if(++fired[i] == 1 && i % RESET_EVERY == 0) {
+    ctimer_reset(c);
+    if(ctimer_expired(c)) {
+      errors++;
+    }
+  }
+}
+/*****************************************************************************/
+static unsigned
+count_pending(void)
+{
+  unsigned i;
+  unsigned count = 0;
+
+  for(i = 0; i < NUM_TIMERS; i++) {
+    if(!ctimer_expired(&timers[i])) {
+      count++;
+    }
+  }
+  return count;
+}
+/*****************************************************************************/
+static unsigned
+expected_fired(unsigned i)
+{
+  if(i % STOP_EVERY == 0) {
+    return 0;
+  }
+  return i % RESET_EVERY == 0 ? 2 : 1;
+}
+/*****************************************************************************/
+static unsigned
+count_unexpected(void)
+{
+  unsigned i;
+  unsigned count = 0;
+
+  for(i = 0; i < NUM_TIMERS; i++) {
+    if(fired[i] != expected_fired(i)) {
+      count++;
+    }
+  }
+  return count;
+}
+/*****************************************************************************/
+UNIT_TEST_REGISTER(cascade, "Expiration across the wheel cascades");
+UNIT_TEST(cascade)
+{
+  UNIT_TEST_BEGIN();
+
+  /* Every interval from 1 tick to a few revolutions of the coarse wheel */
+  UNIT_TEST_ASSERT(errors == 0);
+  UNIT_TEST_ASSERT(early_count == 0);
+  UNIT_TEST_ASSERT(max_latency <= MAX_LATENCY);
+  UNIT_TEST_ASSERT(count_pending() == 0);
+
+  UNIT_TEST_END();
+}
+/*****************************************************************************/
+UNIT_TEST_REGISTER(stop_reset, "Stopped and reset timers");
+UNIT_TEST(stop_reset)
+{
+  UNIT_TEST_BEGIN();
+
+  UNIT_TEST_ASSERT(errors == 0);
+  UNIT_TEST_ASSERT(early_count == 0);
+  UNIT_TEST_ASSERT(max_latency <= MAX_LATENCY);
+  UNIT_TEST_ASSERT(count_unexpected() == 0);
+  UNIT_TEST_ASSERT(count_pending() == 0);
+
+  UNIT_TEST_END();
+}
+/*****************************************************************************/
+UNIT_TEST_REGISTER(never_set, "Timers never set");
+UNIT_TEST(never_set)
+{
+  static struct ctimer garbage;
+  struct ctimer *sentinel = NULL;
+
+  UNIT_TEST_BEGIN();
+
+  /* A timer in memory that was not zeroed, whose links point elsewhere */
+  memset(&garbage, 0xa5, sizeof(garbage));
+  garbage.etimer.p = &ctimer_process;
+  garbage.next = &timers[0];
+  garbage.pprev = &sentinel;
+  ctimer_stop(&garbage);
+  UNIT_TEST_ASSERT(sentinel == NULL);
+  UNIT_TEST_ASSERT(ctimer_expired(&garbage));
+
+  memset(&garbage, 0xa5, sizeof(garbage));
+  garbage.etimer.p = &ctimer_process;
+  garbage.next = &timers[0];
+  garbage.pprev = &sentinel;
+  ctimer_set(&garbage, CLOCK_SECOND, NULL, NULL);
+  UNIT_TEST_ASSERT(sentinel == NULL);
+  UNIT_TEST_ASSERT(!ctimer_expired(&garbage));
+  ctimer_stop(&garbage);
+  UNIT_TEST_ASSERT(ctimer_expired(&garbage));
+
+  UNIT_TEST_END();
+}
+/*****************************************************************************/
+UNIT_TEST_REGISTER(copy, "Copy of a pending timer");
+UNIT_TEST(copy)
+{
+  UNIT_TEST_BEGIN();
+
+  UNIT_TEST_ASSERT(errors == 0);
+  UNIT_TEST_ASSERT(fired[3] == 1);
+  UNIT_TEST_ASSERT(ctimer_expired(&copied));
+
+  UNIT_TEST_END();
+}
+/*****************************************************************************/
+UNIT_TEST_REGISTER(init, "Timers set before ctimer_init()");
+UNIT_TEST(init)
+{
+  UNIT_TEST_BEGIN();
+
+  UNIT_TEST_ASSERT(errors == 0);
+  UNIT_TEST_ASSERT(early_count == 0);
+  UNIT_TEST_ASSERT(max_latency <= MAX_LATENCY);
+  UNIT_TEST_ASSERT(fired[1] == 1 && fired[2] == 1);
+
+  UNIT_TEST_END();
+}
+/*****************************************************************************/
+PROCESS_THREAD(test_ctimer_process, ev, data)
+{
+  static struct etimer et;
+  static int failed;
+  static unsigned i;
+
+  PROCESS_BEGIN();
+
+  printf("Run unit-test\n");
+  printf("---\n");
+
+  /* Re-setting armed timers, as the MAC layer does with its backoffs,
+     then one timer per interval, across the cascades */
+  reset_checks();
+  for(i = 1; i < NUM_TIMERS; i++) {
+    ctimer_set(&timers[i], random_rand() % MAX_INTERVAL, callback, &timers[i]);
+  }
+  for(i = 1; i < NUM_TIMERS; i++) {
+    ctimer_set(&timers[i], i, callback, &timers[i]);
+  }
+  /* Reset timers expire again within 2 * NUM_TIMERS */
+  etimer_set(&et, 2 * NUM_TIMERS + CTIMER_WHEEL_COARSE_TICK + CLOCK_SECOND);
+  PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&et));
+  UNIT_TEST_RUN(cascade);
+  if(!UNIT_TEST_PASSED(cascade)) {
+    failed = 1;
+  }
+
+  /* Random intervals, some timers stopped and some reset */
+  reset_checks();
+  for(i = 0; i < NUM_TIMERS; i++) {
+    ctimer_set(&timers[i], random_rand() % MAX_INTERVAL, callback, &timers[i]);
+  }
+  for(i = 0; i < NUM_TIMERS; i += STOP_EVERY) {
+    ctimer_stop(&timers[i]);
+  }
+  /* Reset timers expire again within 2 * MAX_INTERVAL */
+  etimer_set(&et, 2 * MAX_INTERVAL + CLOCK_SECOND);
+  PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&et));
+  UNIT_TEST_RUN(stop_reset);
+  if(!UNIT_TEST_PASSED(stop_reset)) {
+    failed = 1;
+  }
+
+  UNIT_TEST_RUN(never_set);
+  if(!UNIT_TEST_PASSED(never_set)) {
+    failed = 1;
+  }
+
+  /* Stopping the copy of a pending timer leaves the timer in the wheel */
+  reset_checks();
+  ctimer_set(&timers[3], CTIMER_WHEEL_SLOTS / 2, callback, &timers[3]);
+  copied = timers[3];
+  ctimer_stop(&copied);
+  etimer_set(&et, CTIMER_WHEEL_SLOTS / 2 + CLOCK_SECOND);
+  PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&et));
+  UNIT_TEST_RUN(copy);
+  if(!UNIT_TEST_PASSED(copy)) {
+    failed = 1;
+  }
+
+  /* A short and a long timer, then the wheel is initialized again */
+  reset_checks();
+  ctimer_set(&timers[1], CTIMER_WHEEL_SLOTS / 2, callback, &timers[1]);
+  ctimer_set(&timers[2], CTIMER_WHEEL_SLOTS * 4, callback, &timers[2]);
+  ctimer_init();
+  etimer_set(&et, CTIMER_WHEEL_SLOTS * 4 + CTIMER_WHEEL_COARSE_TICK + CLOCK_SECOND);
+  PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&et));
+  UNIT_TEST_RUN(init);
+  if(!UNIT_TEST_PASSED(init)) {
+    failed = 1;
+  }
+
+  if(failed) {
+    printf("=check-me= FAILED\n");
+    printf("---\n");
+  }
+
+  printf("=check-me= DONE\n");
+  printf("---\n");
+
+  PROCESS_END();
+}
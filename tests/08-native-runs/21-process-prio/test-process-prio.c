@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ *      Test of the event priorities: network events posted behind a
+ *      burst of application events must be delivered first, and a full
+ *      application ring must neither crowd out network events nor lose
+ *      track of the events it drops.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "contiki.h"
+#include "unit-test/unit-test.h"
+/*****************************************************************************/
+#define APP_BURST 20
+#define NET_BURST 4
+/* Tags of the network events start here */
+#define NET_TAG 100
+/*****************************************************************************/
+PROCESS(test_process_prio_process, "Process priority test process");
+PROCESS(app_sink_process, "Application sink");
+PROCESS(net_sink_process, "Network sink");
+AUTOSTART_PROCESSES(&test_process_prio_process);
+/*****************************************************************************/
+static process_event_t test_event;
+static uintptr_t delivered[APP_BURST + NET_BURST];
+static unsigned ndelivered;
+static unsigned app_before_net;
+static unsigned ndropped;
+static unsigned ncontinue;
+static int net_post_when_app_full;
+/*****************************************************************************/
+static void
+record(process_event_t ev, process_data_t data)
+{
+  if(ev == test_event && ndelivered < APP_BURST + NET_BURST) {
+    delivered[ndelivered++] = (uintptr_t)data;
+  }
+}
+/*****************************************************************************/
+PROCESS_THREAD(app_sink_process, ev, data)
+{
+  PROCESS_BEGIN();
+  while(1) {
+    PROCESS_WAIT_EVENT();
+    record(ev, data);
+    if(ev == PROCESS_EVENT_CONTINUE) {
+      ncontinue++;
+    }
+  }
+  PROCESS_END();
+}
+/*****************************************************************************/
+PROCESS_THREAD(net_sink_process, ev, data)
+{
+  PROCESS_BEGIN();
+  while(1) {
+    PROCESS_WAIT_EVENT();
+    record(ev, data);
+  }
+  PROCESS_END();
+}
+/*****************************************************************************/
+UNIT_TEST_REGISTER(priority_order, "Priority order");
+UNIT_TEST(priority_order)
+{
+  unsigned i;
+
+  UNIT_TEST_BEGIN();
+
+  UNIT_TEST_ASSERT(ndelivered == APP_BURST + NET_BURST);
+  /* Network events first, then application events, each in FIFO order */
+  for(i = 0; i < NET_BURST; i++) {
+    UNIT_TEST_ASSERT(delivered[i] == NET_TAG + i);
+  }
+  for(i = 0; i < APP_BURST; i++) {
+    UNIT_TEST_ASSERT(delivered[NET_BURST + i] == i);
+  }
+
+  UNIT_TEST_END();
+}
+/*****************************************************************************/
+UNIT_TEST_REGISTER(ring_full, "Full application ring");
+UNIT_TEST(ring_full)
+{
+  UNIT_TEST_BEGIN();
+
+  UNIT_TEST_ASSERT(ndropped > 0);
+  UNIT_TEST_ASSERT(app_sink_process.ndropped == ndropped);
+  UNIT_TEST_ASSERT(net_sink_process.ndropped == 0);
+  UNIT_TEST_ASSERT(net_post_when_app_full == PROCESS_ERR_OK);
+  UNIT_TEST_ASSERT(process_maxevents_prio[PROCESS_PRIO_APPLICATION] ==
+                   PROCESS_NUMEVENTS_APPLICATION);
+
+  UNIT_TEST_END();
+}
+/*****************************************************************************/
+PROCESS_THREAD(test_process_prio_process, ev, data)
+{
+  static struct etimer et;
+  static unsigned i;
+
+  PROCESS_BEGIN();
+
+  printf("Run unit-test\n");
+  printf("---\n");
+
+  test_event = process_alloc_event();
+  process_set_priority(&net_sink_process, PROCESS_PRIO_NETWORK);
+  process_start(&app_sink_process, NULL);
+  process_start(&net_sink_process, NULL);
+
+  /* Network events posted behind a burst of application events */
+  for(i = 0; i < APP_BURST; i++) {
+    process_post(&app_sink_process, test_event, (process_data_t)(uintptr_t)i);
+  }
+  for(i = 0; i < NET_BURST; i++) {
+    process_post(&net_sink_process, test_event,
+                 (process_data_t)(uintptr_t)(NET_TAG + i));
+  }
+  while(ndelivered < APP_BURST + NET_BURST) {
+    PROCESS_PAUSE();
+  }
+  for(app_before_net = 0; app_before_net < ndelivered; app_before_net++) {
+    if(delivered[app_before_net] >= NET_TAG) {
+      break;
+    }
+  }
+
+  /* Overflow the application ring */
+  for(i = 0; i < PROCESS_NUMEVENTS_APPLICATION + 5; i++) {
+    if(process_post(&app_sink_process, PROCESS_EVENT_CONTINUE, NULL)
+       != PROCESS_ERR_OK) {
+      ndropped++;
+    }
+  }
+  net_post_when_app_full = process_post(&net_sink_process,
+                                        PROCESS_EVENT_CONTINUE, NULL);
+  /* The ring is full: wait with a timer, which retries its post */
+  while(ncontinue < PROCESS_NUMEVENTS_APPLICATION + 5 - ndropped) {
+    etimer_set(&et, 1);
+    PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&et));
+  }
+
+  printf("Application events delivered before the first network event: %u\n",
+         app_before_net);
+  printf("Dropped application events: %u, high-water marks: "
+         "application %u/%u, network %u/%u, system %u/%u\n",
+         app_sink_process.ndropped,
+         process_maxevents_prio[PROCESS_PRIO_APPLICATION],
+         PROCESS_NUMEVENTS_APPLICATION,
+         process_maxevents_prio[PROCESS_PRIO_NETWORK],
+         PROCESS_NUMEVENTS_NETWORK,
+         process_maxevents_prio[PROCESS_PRIO_SYSTEM],
+         PROCESS_NUMEVENTS_SYSTEM);
+
+  UNIT_TEST_RUN(priority_order);
+  UNIT_TEST_RUN(ring_full);
+
+  if(!UNIT_TEST_PASSED(priority_order) || !UNIT_TEST_PASSED(ring_full)) {
+    printf("=check-me= FAILED\n");
+    printf("---\n");
+  }
+
+  printf("=check-me= DONE\n");
+  printf("---\n");
+
+  PROCESS_END();
+}
+/*****************************************************************************/
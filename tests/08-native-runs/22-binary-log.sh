@@ -0,0 +1,8 @@
+#!/bin/bash -e
+
+./run-one.sh 22-binary-log
+
+# The drained records must decode back to the text of the log call
+../../tools/binlog/binlog-decode.py 22-binary-log/test-binary-log.native \
+  22-binary-log/test-binary-log.run.log |
+  grep -F "[INFO: Test      ] Binary log check: 42 -7 0x1f abc z%" > /dev/null
@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ *      Test of the binary log: layout of the records, accounting of the
+ *      records lost when the ring is full, and draining of the ring in
+ *      batches that leave room for the other events.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "contiki.h"
+#include "unit-test/unit-test.h"
+
+#include "sys/log.h"
+#define LOG_MODULE "Test"
+#define LOG_LEVEL LOG_LEVEL_DBG
+/*****************************************************************************/
+#define DRAIN_RECORDS (2 * LOG_BINARY_DRAIN_BATCH + 1)
+/*****************************************************************************/
+PROCESS(test_binary_log_process, "Binary log test process");
+AUTOSTART_PROCESSES(&test_binary_log_process);
+/*****************************************************************************/
+static const char *
+anchored(const uint8_t *field)
+{
+  int32_t offset;
+
+  memcpy(&offset, field, sizeof(offset));
+  return log_binary_anchor + offset;
+}
+/*****************************************************************************/
+static uint32_t
+u32_at(const uint8_t *field)
+{
+  uint32_t v;
+
+  memcpy(&v, field, sizeof(v));
+  return v;
+}
+/*****************************************************************************/
+static void
+log_check_line(void)
+{
+  LOG_INFO("Binary log check: %d %ld 0x%02x %s %c%%\n",
+           42, -7L, 31, "abc", 'z');
+}
+/*****************************************************************************/
+UNIT_TEST_REGISTER(record_layout, "Record layout");
+UNIT_TEST(record_layout)
+{
+  uint8_t buf[LOG_BINARY_MAX_RECORD];
+  int len;
+
+  UNIT_TEST_BEGIN();
+
+  while(log_binary_read(buf) > 0);
+  log_check_line();
+  len = log_binary_read(buf);
+
+  UNIT_TEST_ASSERT(len == LOG_BINARY_HEADER_LEN + 4 + 4 + 4 + 1 + 3 + 4);
+  UNIT_TEST_ASSERT(buf[0] == len);
+  UNIT_TEST_ASSERT(buf[1] == (LOG_LEVEL_INFO | LOG_BINARY_PREFIX));
+  UNIT_TEST_ASSERT(strcmp(anchored(&buf[6]), LOG_MODULE) == 0);
+  UNIT_TEST_ASSERT(strncmp(anchored(&buf[10]), "Binary log check:", 17) == 0);
+  UNIT_TEST_ASSERT(u32_at(&buf[14]) == 42);
+  UNIT_TEST_ASSERT((int32_t)u32_at(&buf[18]) == -7);
+  UNIT_TEST_ASSERT(u32_at(&buf[22]) == 31);
+  UNIT_TEST_ASSERT(buf[26] == 3 && memcmp(&buf[27], "abc", 3) == 0);
+  UNIT_TEST_ASSERT(u32_at(&buf[30]) == 'z');
+  UNIT_TEST_ASSERT(log_binary_read(buf) == 0);
+
+  /* Strings are copied, up to LOG_BINARY_MAX_STRLEN characters */
+  LOG_INFO("%s\n", "0123456789abcdef0123456789abcdef0123456789");
+  len = log_binary_read(buf);
+  UNIT_TEST_ASSERT(len == LOG_BINARY_HEADER_LEN + 1 + LOG_BINARY_MAX_STRLEN);
+  UNIT_TEST_ASSERT(buf[LOG_BINARY_HEADER_LEN] == LOG_BINARY_MAX_STRLEN);
+
+  /* A continuation has no prefix flag */
+  LOG_DBG_("%u\n", 5u);
+  len = log_binary_read(buf);
+  UNIT_TEST_ASSERT(len == LOG_BINARY_HEADER_LEN + 4);
+  UNIT_TEST_ASSERT(buf[1] == LOG_LEVEL_DBG);
+
+  UNIT_TEST_END();
+}
+/*****************************************************************************/
+UNIT_TEST_REGISTER(ring_full, "Full ring");
+UNIT_TEST(ring_full)
+{
+  uint8_t buf[LOG_BINARY_MAX_RECORD];
+  unsigned i;
+  unsigned stored = 0;
+
+  UNIT_TEST_BEGIN();
+
+  while(log_binary_read(buf) > 0);
+  log_binary_drain(0);
+  for(i = 0; i < LOG_BINARY_BUF_SIZE / (LOG_BINARY_HEADER_LEN + 4) + 10; i++) {
+    LOG_INFO("Record %u\n", i);
+  }
+  UNIT_TEST_ASSERT(log_binary_nlost() > 0);
+  while(log_binary_read(buf) > 0) {
+    /* The oldest records are kept */
+    UNIT_TEST_ASSERT(u32_at(&buf[LOG_BINARY_HEADER_LEN]) == stored);
+    stored++;
+  }
+  UNIT_TEST_ASSERT(stored + log_binary_nlost() == i);
+  log_binary_drain(0);
+  UNIT_TEST_ASSERT(log_binary_nlost() == 0);
+
+  UNIT_TEST_END();
+}
+/*****************************************************************************/
+PROCESS_THREAD(test_binary_log_process, ev, data)
+{
+  static uint8_t buf[LOG_BINARY_MAX_RECORD];
+  static unsigned i;
+  static unsigned left;
+  static int drained_in_batches;
+
+  PROCESS_BEGIN();
+
+  printf("Run unit-test\n");
+  printf("---\n");
+
+  UNIT_TEST_RUN(record_layout);
+  UNIT_TEST_RUN(ring_full);
+
+  /*
+   * The drain request posted by the first log call is queued before the
+   * event of the pause: the drain process prints one batch, then posts
+   * its next batch behind the pending events.
+   */
+  while(log_binary_read(buf) > 0);
+  for(i = 0; i < DRAIN_RECORDS; i++) {
+    LOG_INFO("Drain %u\n", i);
+  }
+  PROCESS_PAUSE();
+  left = 0;
+  while(log_binary_read(buf) > 0) {
+    left++;
+  }
+  drained_in_batches = left == DRAIN_RECORDS - LOG_BINARY_DRAIN_BATCH;
+  printf("Records left after one drain event: %u of %u\n",
+         left, DRAIN_RECORDS);
+
+  /* Drained by the binary log process, then decoded by the test script */
+  log_check_line();
+  while(log_binary_drain(0)) {
+    PROCESS_PAUSE();
+  }
+
+  if(!UNIT_TEST_PASSED(record_layout) || !UNIT_TEST_PASSED(ring_full) ||
+     !drained_in_batches) {
+    printf("=check-me= FAILED\n");
+    printf("---\n");
+  }
+
+  printf("=check-me= DONE\n");
+  printf("---\n");
+
+  PROCESS_END();
+}
+/*****************************************************************************/
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ *      Test of the profiler: a probe must count the runs of its
+ *      section, their total and longest duration across a wrap of
+ *      the time source, and register itself once, on its first run.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "contiki.h"
+#include "sys/profile.h"
+#include "unit-test/unit-test.h"
+/*****************************************************************************/
+PROCESS(test_profile_process, "Profile test process");
+AUTOSTART_PROCESSES(&test_profile_process);
+/*****************************************************************************/
+static uint32_t now;
+
+PROFILE_PROBE(test_probe, "test");
+/*****************************************************************************/
+uint32_t
+test_profile_time(void)
+{
+  return now;
+}
+/*****************************************************************************/
+static void
+run_section(uint32_t duration)
+{
+  PROFILE_BEGIN(test_probe);
+  now += duration;
+  PROFILE_END(test_probe);
+}
+/*****************************************************************************/
+static unsigned
+count_probes(const char *name)
+{
+  struct profile_probe *p;
+  unsigned n = 0;
+
+  for(p = profile_probe_head(); p != NULL; p = p->next) {
+    if(!strcmp(p->name, name)) {
+      n++;
+    }
+  }
+  return n;
+}
+/*****************************************************************************/
+UNIT_TEST_REGISTER(counters, "Probe counters");
+UNIT_TEST(counters)
+{
+  UNIT_TEST_BEGIN();
+
+  /* Not registered before its first run */
+  UNIT_TEST_ASSERT(count_probes("test") == 0);
+
+  run_section(5);
+  run_section(3);
+  run_section(10);
+  UNIT_TEST_ASSERT(count_probes("test") == 1);
+  UNIT_TEST_ASSERT(test_probe.count == 3);
+  UNIT_TEST_ASSERT(test_probe.total == 18);
+  UNIT_TEST_ASSERT(test_probe.max == 10);
+
+  /* A section across the wrap of the time source */
+  now = UINT32_MAX - 1;
+  run_section(7);
+  UNIT_TEST_ASSERT(test_probe.count == 4);
+  UNIT_TEST_ASSERT(test_probe.total == 25);
+  UNIT_TEST_ASSERT(count_probes("test") == 1);
+
+  UNIT_TEST_END();
+}
+/*****************************************************************************/
+UNIT_TEST_REGISTER(reset, "Probe reset");
+UNIT_TEST(reset)
+{
+  UNIT_TEST_BEGIN();
+
+  profile_reset();
+  UNIT_TEST_ASSERT(test_probe.count == 0);
+  UNIT_TEST_ASSERT(test_probe.total == 0);
+  UNIT_TEST_ASSERT(test_probe.max == 0);
+
+  /* Still registered */
+  run_section(2);
+  UNIT_TEST_ASSERT(count_probes("test") == 1);
+  UNIT_TEST_ASSERT(test_probe.count == 1);
+  UNIT_TEST_ASSERT(test_probe.max == 2);
+
+  UNIT_TEST_END();
+}
+/*****************************************************************************/
+UNIT_TEST_REGISTER(system_probe, "Event timer probe");
+UNIT_TEST(system_probe)
+{
+  UNIT_TEST_BEGIN();
+
+  /* The event timer that woke the test up went through the probe */
+  UNIT_TEST_ASSERT(count_probes("etimer_process") == 1);
+
+  UNIT_TEST_END();
+}
+/*****************************************************************************/
+PROCESS_THREAD(test_profile_process, ev, data)
+{
+  static struct etimer et;
+
+  PROCESS_BEGIN();
+
+  printf("Run unit-test\n");
+  printf("---\n");
+
+  UNIT_TEST_RUN(counters);
+  UNIT_TEST_RUN(reset);
+
+  etimer_set(&et, 1);
+  PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&et));
+  UNIT_TEST_RUN(system_probe);
+
+  profile_dump();
+
+  if(!UNIT_TEST_PASSED(counters) || !UNIT_TEST_PASSED(reset) ||
+     !UNIT_TEST_PASSED(system_probe)) {
+    printf("=check-me= FAILED\n");
+    printf("---\n");
+  }
+
+  printf("=check-me= DONE\n");
+  printf("---\n");
+
+  PROCESS_END();
+}
+/*****************************************************************************/
@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ *      Test of the resource statistics: the memb pools and the heapmem
+ *      zones must keep their high-water marks and count their failed
+ *      allocations, and the report must print them.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "contiki.h"
+#include "lib/memb.h"
+#include "lib/heapmem.h"
+#include "services/resource-stats/resource-stats.h"
+#include "unit-test/unit-test.h"
+/*****************************************************************************/
+PROCESS(test_resource_stats_process, "Resource stats test process");
+AUTOSTART_PROCESSES(&test_resource_stats_process);
+/*****************************************************************************/
+MEMB(test_pool, int, 3);
+/* Never passed to memb_init() */
+MEMB(test_lazy_pool, int, 2);
+
+static char report[1024];
+/*****************************************************************************/
+static unsigned
+count_pools(struct memb *m)
+{
+  struct memb *p;
+  unsigned n = 0;
+
+  for(p = memb_pools(); p != NULL; p = p->next_pool) {
+    if(p == m) {
+      n++;
+    }
+  }
+  return n;
+}
+/*****************************************************************************/
+static void
+append_report(const char *str)
+{
+  strncat(report, str, sizeof(report) - strlen(report) - 1);
+}
+/*****************************************************************************/
+UNIT_TEST_REGISTER(memb_stats, "Memory block statistics");
+UNIT_TEST(memb_stats)
+{
+  int *blocks[3];
+  int i;
+
+  UNIT_TEST_BEGIN();
+
+  memb_init(&test_pool);
+  memb_init(&test_pool);
+  UNIT_TEST_ASSERT(count_pools(&test_pool) == 1);
+  UNIT_TEST_ASSERT(count_pools(&test_lazy_pool) == 0);
+
+  for(i = 0; i < 3; i++) {
+    blocks[i] = memb_alloc(&test_pool);
+    UNIT_TEST_ASSERT(blocks[i] != NULL);
+  }
+  UNIT_TEST_ASSERT(memb_numfree(&test_pool) == 0);
+  UNIT_TEST_ASSERT(memb_alloc(&test_pool) == NULL);
+  UNIT_TEST_ASSERT(memb_alloc(&test_pool) == NULL);
+  UNIT_TEST_ASSERT(test_pool.nfailed == 2);
+
+  memb_free(&test_pool, blocks[1]);
+  memb_free(&test_pool, blocks[2]);
+  UNIT_TEST_ASSERT(memb_numfree(&test_pool) == 2);
+  UNIT_TEST_ASSERT(test_pool.nused == 1);
+  UNIT_TEST_ASSERT(test_pool.maxused == 3);
+
+  /* Listed on its first allocation */
+  UNIT_TEST_ASSERT(memb_alloc(&test_lazy_pool) != NULL);
+  UNIT_TEST_ASSERT(count_pools(&test_lazy_pool) == 1);
+  UNIT_TEST_ASSERT(test_lazy_pool.maxused == 1);
+
+  UNIT_TEST_END();
+}
+/*****************************************************************************/
+UNIT_TEST_REGISTER(heapmem_stats, "Heap zone statistics");
+UNIT_TEST(heapmem_stats)
+{
+  heapmem_zone_t zone;
+  heapmem_zone_stats_t stats;
+  char *a, *b;
+  size_t peak;
+
+  UNIT_TEST_BEGIN();
+
+  zone = heapmem_zone_register("test", 1024);
+  UNIT_TEST_ASSERT(zone != HEAPMEM_ZONE_INVALID);
+
+  a = heapmem_zone_alloc(zone, 100);
+  b = heapmem_zone_alloc(zone, 100);
+  UNIT_TEST_ASSERT(a != NULL && b != NULL);
+  UNIT_TEST_ASSERT(heapmem_zone_stats(zone, &stats));
+  UNIT_TEST_ASSERT(!strcmp(stats.name, "test"));
+  UNIT_TEST_ASSERT(stats.zone_size == 1024);
+  UNIT_TEST_ASSERT(stats.allocated >= 200);
+  UNIT_TEST_ASSERT(stats.max_allocated == stats.allocated);
+  UNIT_TEST_ASSERT(stats.nfailed == 0);
+
+  /* Cannot grow in place past b: moves, and must not leak the old chunk */
+  a = heapmem_realloc(a, 400);
+  UNIT_TEST_ASSERT(a != NULL);
+  heapmem_zone_stats(zone, &stats);
+  UNIT_TEST_ASSERT(stats.allocated >= 500 && stats.allocated < 600);
+  peak = stats.max_allocated;
+  UNIT_TEST_ASSERT(peak >= stats.allocated);
+
+  UNIT_TEST_ASSERT(heapmem_zone_alloc(zone, 2000) == NULL);
+  heapmem_free(a);
+  heapmem_free(b);
+  heapmem_zone_stats(zone, &stats);
+  UNIT_TEST_ASSERT(stats.allocated == 0);
+  UNIT_TEST_ASSERT(stats.max_allocated == peak);
+  UNIT_TEST_ASSERT(stats.nfailed == 1);
+
+  UNIT_TEST_ASSERT(!heapmem_zone_stats(zone + 1, &stats));
+
+  UNIT_TEST_END();
+}
+/*****************************************************************************/
+UNIT_TEST_REGISTER(report_format, "Report lines");
+UNIT_TEST(report_format)
+{
+  UNIT_TEST_BEGIN();
+
+  resource_stats_report(append_report);
+  UNIT_TEST_ASSERT(strstr(report,
+                          "pool test_pool: max=3 size=3 failed=2\n") != NULL);
+  UNIT_TEST_ASSERT(strstr(report,
+                          "pool test_lazy_pool: max=1 size=2 failed=0\n") != NULL);
+  UNIT_TEST_ASSERT(strstr(report, "pool heap-test: max=") != NULL);
+  UNIT_TEST_ASSERT(strstr(report, "pool events: max=") != NULL);
+
+  UNIT_TEST_END();
+}
+/*****************************************************************************/
+PROCESS_THREAD(test_resource_stats_process, ev, data)
+{
+  PROCESS_BEGIN();
+
+  printf("Run unit-test\n");
+  printf("---\n");
+
+  UNIT_TEST_RUN(memb_stats);
+  UNIT_TEST_RUN(heapmem_stats);
+  UNIT_TEST_RUN(report_format);
+
+  printf("%s", report);
+
+  if(!UNIT_TEST_PASSED(memb_stats) || !UNIT_TEST_PASSED(heapmem_stats) ||
+     !UNIT_TEST_PASSED(report_format)) {
+    printf("=check-me= FAILED\n");
+    printf("---\n");
+  }
+
+  printf("=check-me= DONE\n");
+  printf("---\n");
+
+  PROCESS_END();
+}
+/*****************************************************************************/
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ *      Test of the tickless idle support: timers with a slack must
+ *      expire together at the earliest deadline, and the platform must
+ *      stay idle until then, unless an event is pending.
+ */
+
+#include <stdio.h>
+
+#include "contiki.h"
+#include "sys/idle.h"
+#include "unit-test/unit-test.h"
+/*****************************************************************************/
+PROCESS(test_idle_process, "Idle test process");
+AUTOSTART_PROCESSES(&test_idle_process);
+/*****************************************************************************/
+/* Milliseconds on native */
+#define SHORT (CLOCK_SECOND / 20)
+#define LONG (CLOCK_SECOND / 10)
+
+static struct etimer early_timer;
+static struct etimer late_timer;
+static struct ctimer callback_timer;
+static clock_time_t early_fired;
+static clock_time_t late_fired;
+/*****************************************************************************/
+static void
+callback(void *ptr)
+{
+}
+/*****************************************************************************/
+UNIT_TEST_REGISTER(deadline, "Next deadline with slack");
+UNIT_TEST(deadline)
+{
+  clock_time_t now;
+
+  UNIT_TEST_BEGIN();
+
+  now = clock_time();
+  etimer_set(&early_timer, SHORT);
+  etimer_set_slack(&early_timer, 4 * SHORT);
+  UNIT_TEST_ASSERT(etimer_next_expiration_time() == now + 5 * SHORT);
+
+  /* A later timer without slack sets an earlier deadline */
+  etimer_set(&late_timer, LONG);
+  UNIT_TEST_ASSERT(etimer_next_expiration_time() == now + LONG);
+
+  /* A callback timer with a large slack does not change it */
+  ctimer_set(&callback_timer, LONG, callback, NULL);
+  ctimer_set_slack(&callback_timer, 100 * LONG);
+  UNIT_TEST_ASSERT(etimer_next_expiration_time() == now + LONG);
+
+  /* etimer_set() clears the slack */
+  etimer_set(&early_timer, SHORT);
+  UNIT_TEST_ASSERT(etimer_next_expiration_time() == now + SHORT);
+  etimer_set_slack(&early_timer, 4 * SHORT);
+
+  /* Setting the timers polled the etimer process: no idle time */
+  UNIT_TEST_ASSERT(idle_ticks(CLOCK_SECOND) == 0);
+
+  UNIT_TEST_END();
+}
+/*****************************************************************************/
+UNIT_TEST_REGISTER(coalesced, "Coalesced expiration");
+UNIT_TEST(coalesced)
+{
+  UNIT_TEST_BEGIN();
+
+  UNIT_TEST_ASSERT(early_fired != 0 && late_fired != 0);
+  /* The early timer waited for the late one */
+  UNIT_TEST_ASSERT(early_fired == late_fired);
+  UNIT_TEST_ASSERT(early_fired - etimer_expiration_time(&late_timer) <
+                   SHORT);
+
+  UNIT_TEST_END();
+}
+/*****************************************************************************/
+UNIT_TEST_REGISTER(stats, "Idle statistics");
+UNIT_TEST(stats)
+{
+  struct idle_stats before = idle_stats;
+
+  UNIT_TEST_BEGIN();
+
+  /* Not idle: no stretch */
+  idle_exit();
+  UNIT_TEST_ASSERT(idle_stats.sleeps == before.sleeps);
+
+  idle_enter();
+  idle_exit();
+  idle_exit();
+  UNIT_TEST_ASSERT(idle_stats.sleeps == before.sleeps + 1);
+
+  /* The platform reported the idle time of the waits above */
+  UNIT_TEST_ASSERT(before.sleeps > 0);
+  UNIT_TEST_ASSERT(before.ticks >= LONG - SHORT);
+
+  UNIT_TEST_END();
+}
+/*****************************************************************************/
+PROCESS_THREAD(test_idle_process, ev, data)
+{
+  PROCESS_BEGIN();
+
+  printf("Run unit-test\n");
+  printf("---\n");
+
+  UNIT_TEST_RUN(deadline);
+
+  while(late_fired == 0 || early_fired == 0) {
+    PROCESS_WAIT_EVENT_UNTIL(ev == PROCESS_EVENT_TIMER);
+    if(data == &early_timer) {
+      early_fired = clock_time();
+    } else if(data == &late_timer) {
+      late_fired = clock_time();
+    }
+  }
+  ctimer_stop(&callback_timer);
+
+  UNIT_TEST_RUN(coalesced);
+  UNIT_TEST_RUN(stats);
+
+  if(!UNIT_TEST_PASSED(deadline) || !UNIT_TEST_PASSED(coalesced) ||
+     !UNIT_TEST_PASSED(stats)) {
+    printf("=check-me= FAILED\n");
+    printf("---\n");
+  }
+
+  printf("=check-me= DONE\n");
+  printf("---\n");
+
+  PROCESS_END();
+}
+/*****************************************************************************/
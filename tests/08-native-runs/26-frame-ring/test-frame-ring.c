@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ *      Test of the frame ring: frames come out in order, whole and with
+ *      their metadata, and the frames that don't fit are counted, also
+ *      when the producer is a signal handler that interrupts the
+ *      consumer at any point.
+ *
+ *      The signal handler runs on the same core as the consumer, and
+ *      memory_barrier() is empty on native: this checks the index
+ *      protocol against preemption, not the ordering the barriers give
+ *      on other CPUs.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <signal.h>
+#include <sys/time.h>
+
+#include "contiki.h"
+#include "lib/frame-ring.h"
+#include "unit-test/unit-test.h"
+/*****************************************************************************/
+PROCESS(test_frame_ring_process, "Frame ring test process");
+AUTOSTART_PROCESSES(&test_frame_ring_process);
+/*****************************************************************************/
+#define FRAME_SIZE 32
+
+FRAME_RING(ring, 8, FRAME_SIZE);
+
+/* Frames produced by the signal handler */
+static volatile uint32_t produced;
+/*****************************************************************************/
+/* Frame number seq: its length and contents follow from seq */
+static uint16_t
+frame_len(uint32_t seq)
+{
+  return 4 + seq % (FRAME_SIZE - 3);
+}
+/*****************************************************************************/
+static void
+frame_fill(uint8_t *frame, uint32_t seq)
+{
+  uint16_t i;
+
+  memcpy(frame, &seq, sizeof(seq));
+  for(i = sizeof(seq); i < frame_len(seq); i++) {
+    frame[i] = (uint8_t)(seq + i);
+  }
+}
+/*****************************************************************************/
+static int
+frame_check(const uint8_t *frame, uint16_t len, uint32_t seq)
+{
+  uint8_t expected[FRAME_SIZE];
+
+  frame_fill(expected, seq);
+  return len == frame_len(seq) && memcmp(frame, expected, len) == 0;
+}
+/*****************************************************************************/
+UNIT_TEST_REGISTER(order, "Order, capacity and drops");
+UNIT_TEST(order)
+{
+  uint8_t frame[FRAME_SIZE];
+  struct frame_ring_info info;
+  uint32_t seq;
+  int len;
+
+  UNIT_TEST_BEGIN();
+
+  frame_ring_init(&ring);
+  UNIT_TEST_ASSERT(frame_ring_get(&ring, frame, sizeof(frame), &info) == 0);
+
+  /* Eight slots hold seven frames */
+  for(seq = 0; seq < 7; seq++) {
+    frame_fill(frame, seq);
+    UNIT_TEST_ASSERT(frame_ring_put(&ring, frame, frame_len(seq),
+                                    -(int8_t)seq, seq) == 1);
+  }
+  UNIT_TEST_ASSERT(frame_ring_count(&ring) == 7);
+  frame_fill(frame, seq);
+  UNIT_TEST_ASSERT(frame_ring_put(&ring, frame, frame_len(seq), 0, 0) == 0);
+  UNIT_TEST_ASSERT(frame_ring_reserve(&ring) == NULL);
+  UNIT_TEST_ASSERT(frame_ring_dropped(&ring) == 2);
+
+  for(seq = 0; seq < 7; seq++) {
+    len = frame_ring_get(&ring, frame, sizeof(frame), &info);
+    UNIT_TEST_ASSERT(frame_check(frame, len, seq));
+    UNIT_TEST_ASSERT(info.len == len);
+    UNIT_TEST_ASSERT(info.rssi == -(int8_t)seq && info.lqi == seq);
+  }
+  UNIT_TEST_ASSERT(frame_ring_count(&ring) == 0);
+
+  /* Frames larger than the slots are dropped */
+  UNIT_TEST_ASSERT(frame_ring_put(&ring, frame, FRAME_SIZE + 1, 0, 0) == 0);
+  UNIT_TEST_ASSERT(frame_ring_dropped(&ring) == 3);
+  UNIT_TEST_ASSERT(frame_ring_count(&ring) == 0);
+
+  UNIT_TEST_END();
+}
+/*****************************************************************************/
+UNIT_TEST_REGISTER(zero_copy, "Reserve, commit, peek and release");
+UNIT_TEST(zero_copy)
+{
+  uint8_t frame[FRAME_SIZE];
+  struct frame_ring_info info;
+  const uint8_t *peeked;
+  uint8_t *slot;
+  uint32_t seq;
+
+  UNIT_TEST_BEGIN();
+
+  frame_ring_init(&ring);
+  UNIT_TEST_ASSERT(frame_ring_peek(&ring, &info) == NULL);
+
+  /* Wrap around the ring several times */
+  for(seq = 0; seq < 100; seq++) {
+    slot = frame_ring_reserve(&ring);
+    UNIT_TEST_ASSERT(slot != NULL);
+    frame_fill(slot, seq);
+    /* Not visible until committed */
+    UNIT_TEST_ASSERT(frame_ring_peek(&ring, &info) == NULL || seq % 2);
+    frame_ring_commit(&ring, frame_len(seq), 0, 0);
+
+    if(seq % 2) {
+      /* Two frames queued: take them out */
+      peeked = frame_ring_peek(&ring, &info);
+      UNIT_TEST_ASSERT(peeked != NULL && frame_check(peeked, info.len, seq - 1));
+      frame_ring_release(&ring);
+      UNIT_TEST_ASSERT(frame_ring_get(&ring, frame, sizeof(frame), NULL) ==
+                       frame_len(seq));
+      UNIT_TEST_ASSERT(frame_check(frame, frame_len(seq), seq));
+    }
+  }
+  UNIT_TEST_ASSERT(frame_ring_count(&ring) == 0);
+  UNIT_TEST_ASSERT(frame_ring_dropped(&ring) == 0);
+
+  /* Frames too large for the consumer buffer are skipped */
+  frame_fill(frame, 20);
+  frame_ring_put(&ring, frame, frame_len(20), 0, 0);
+  frame_fill(frame, 1);
+  frame_ring_put(&ring, frame, frame_len(1), 0, 0);
+  UNIT_TEST_ASSERT(frame_ring_get(&ring, frame, frame_len(1), NULL) ==
+                   frame_len(1));
+  UNIT_TEST_ASSERT(frame_check(frame, frame_len(1), 1));
+  UNIT_TEST_ASSERT(frame_ring_count(&ring) == 0);
+
+  UNIT_TEST_END();
+}
+/*****************************************************************************/
+static void
+producer(int signum)
+{
+  uint8_t *slot = frame_ring_reserve(&ring);
+
+  if(slot != NULL) {
+    frame_fill(slot, produced);
+    frame_ring_commit(&ring, frame_len(produced), 0, 0);
+  }
+  produced++;
+}
+/*****************************************************************************/
+UNIT_TEST_REGISTER(interrupt, "Producer in a signal handler");
+UNIT_TEST(interrupt)
+{
+  struct itimerval period = { { 0, 100 }, { 0, 100 } };
+  struct itimerval stop = { { 0, 0 }, { 0, 0 } };
+  uint8_t frame[FRAME_SIZE];
+  uint32_t received = 0;
+  uint32_t expected = 0;
+  uint32_t seq;
+  int in_order = 1;
+  int whole = 1;
+  uint32_t stalled;
+  int len;
+
+  UNIT_TEST_BEGIN();
+
+  frame_ring_init(&ring);
+  produced = 0;
+  signal(SIGVTALRM, producer);
+  setitimer(ITIMER_VIRTUAL, &period, NULL);
+
+  /* Consume as fast as possible, but stall now and then for drops */
+  while(produced < 400) {
+    len = frame_ring_get(&ring, frame, sizeof(frame), NULL);
+    if(len > 0) {
+      memcpy(&seq, frame, sizeof(seq));
+      in_order &= seq >= expected;
+      whole &= frame_check(frame, len, seq);
+      expected = seq + 1;
+      received++;
+      if(seq % 100 == 99) {
+        for(stalled = produced; produced < stalled + 10;);
+      }
+    }
+  }
+
+  setitimer(ITIMER_VIRTUAL, &stop, NULL);
+  signal(SIGVTALRM, SIG_DFL);
+  while((len = frame_ring_get(&ring, frame, sizeof(frame), NULL)) > 0) {
+    memcpy(&seq, frame, sizeof(seq));
+    in_order &= seq >= expected;
+    whole &= frame_check(frame, len, seq);
+    expected = seq + 1;
+    received++;
+  }
+
+  printf("Produced %lu frames, received %lu, dropped %u\n",
+         (unsigned long)produced, (unsigned long)received,
+         frame_ring_dropped(&ring));
+  UNIT_TEST_ASSERT(in_order);
+  UNIT_TEST_ASSERT(whole);
+  UNIT_TEST_ASSERT(received + frame_ring_dropped(&ring) == produced);
+  UNIT_TEST_ASSERT(frame_ring_dropped(&ring) > 0);
+
+  UNIT_TEST_END();
+}
+/*****************************************************************************/
+PROCESS_THREAD(test_frame_ring_process, ev, data)
+{
+  PROCESS_BEGIN();
+
+  printf("Run unit-test\n");
+  printf("---\n");
+
+  UNIT_TEST_RUN(order);
+  UNIT_TEST_RUN(zero_copy);
+  UNIT_TEST_RUN(interrupt);
+
+  if(!UNIT_TEST_PASSED(order) || !UNIT_TEST_PASSED(zero_copy) ||
+     !UNIT_TEST_PASSED(interrupt)) {
+    printf("=check-me= FAILED\n");
+    printf("---\n");
+  }
+
+  printf("=check-me= DONE\n");
+  printf("---\n");
+
+  PROCESS_END();
+}
+/*****************************************************************************/
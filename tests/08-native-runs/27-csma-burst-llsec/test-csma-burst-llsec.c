@@ -0,0 +1,292 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ *      Test of CSMA bursts with link-layer security: the frames of a
+ *      burst carry the frame pending bit, and the receiver can
+ *      authenticate every one of them, retransmissions included.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "contiki.h"
+#include "net/netstack.h"
+#include "net/packetbuf.h"
+#include "net/mac/csma/csma.h"
+#include "net/mac/csma/csma-security.h"
+#include "unit-test/unit-test.h"
+/*****************************************************************************/
+PROCESS(test_csma_burst_llsec_process, "CSMA burst LLSEC test process");
+AUTOSTART_PROCESSES(&test_csma_burst_llsec_process);
+/*****************************************************************************/
+#define PAYLOAD_LEN 20
+#define BURST_LEN 3
+/* Frames sent: the first one is not ACKed, and sent again */
+#define MAX_FRAMES (BURST_LEN + 1)
+#define MAX_FRAME_LEN 127
+
+static uint8_t frames[MAX_FRAMES][MAX_FRAME_LEN];
+static int frame_lens[MAX_FRAMES];
+static int frame_count;
+
+static const uint8_t *prepared;
+static int ack_pending;
+static uint8_t ack_dsn;
+
+static int sent_count;
+static int sent_ok_count;
+static linkaddr_t receiver;
+/*****************************************************************************/
+static int
+radio_init(void)
+{
+  return 1;
+}
+/*****************************************************************************/
+static int
+radio_prepare(const void *payload, unsigned short payload_len)
+{
+  prepared = payload;
+  return 0;
+}
+/*****************************************************************************/
+static int
+radio_transmit(unsigned short len)
+{
+  if(frame_count < MAX_FRAMES) {
+    memcpy(frames[frame_count], prepared, len);
+    frame_lens[frame_count] = len;
+  }
+  /* ACK every frame but the very first one */
+  ack_pending = frame_count > 0;
+  ack_dsn = prepared[2];
+  frame_count++;
+  return RADIO_TX_OK;
+}
+/*****************************************************************************/
+static int
+radio_send(const void *payload, unsigned short payload_len)
+{
+  radio_prepare(payload, payload_len);
+  return radio_transmit(payload_len);
+}
+/*****************************************************************************/
+static int
+radio_read(void *buf, unsigned short buf_len)
+{
+  uint8_t *ack = buf;
+
+  if(!ack_pending || buf_len < CSMA_ACK_LEN) {
+    return 0;
+  }
+  ack_pending = 0;
+  ack[0] = FRAME802154_ACKFRAME;
+  ack[1] = 0;
+  ack[2] = ack_dsn;
+  return CSMA_ACK_LEN;
+}
+/*****************************************************************************/
+static int
+radio_channel_clear(void)
+{
+  return 1;
+}
+/*****************************************************************************/
+static int
+radio_receiving_packet(void)
+{
+  return 0;
+}
+/*****************************************************************************/
+static int
+radio_pending_packet(void)
+{
+  return ack_pending;
+}
+/*****************************************************************************/
+static int
+radio_on(void)
+{
+  return 1;
+}
+/*****************************************************************************/
+static int
+radio_off(void)
+{
+  return 1;
+}
+/*****************************************************************************/
+static radio_result_t
+radio_get_value(radio_param_t param, radio_value_t *value)
+{
+  if(param == RADIO_CONST_MAX_PAYLOAD_LEN) {
+    *value = MAX_FRAME_LEN;
+    return RADIO_RESULT_OK;
+  }
+  return RADIO_RESULT_NOT_SUPPORTED;
+}
+/*****************************************************************************/
+static radio_result_t
+radio_set_value(radio_param_t param, radio_value_t value)
+{
+  return RADIO_RESULT_NOT_SUPPORTED;
+}
+/*****************************************************************************/
+static radio_result_t
+radio_get_object(radio_param_t param, void *dest, size_t size)
+{
+  return RADIO_RESULT_NOT_SUPPORTED;
+}
+/*****************************************************************************/
+static radio_result_t
+radio_set_object(radio_param_t param, const void *src, size_t size)
+{
+  return RADIO_RESULT_NOT_SUPPORTED;
+}
+/*****************************************************************************/
+const struct radio_driver test_radio_driver = {
+  radio_init,
+  radio_prepare,
+  radio_transmit,
+  radio_send,
+  radio_read,
+  radio_channel_clear,
+  radio_receiving_packet,
+  radio_pending_packet,
+  radio_on,
+  radio_off,
+  radio_get_value,
+  radio_set_value,
+  radio_get_object,
+  radio_set_object
+};
+/*****************************************************************************/
+static void
+packet_sent(void *ptr, int status, int num_tx)
+{
+  sent_count++;
+  if(status == MAC_TX_OK) {
+    sent_ok_count++;
+  }
+}
+/*****************************************************************************/
+static void
+enqueue(uint8_t fill)
+{
+  packetbuf_clear();
+  memset(packetbuf_dataptr(), fill, PAYLOAD_LEN);
+  packetbuf_set_datalen(PAYLOAD_LEN);
+  packetbuf_set_addr(PACKETBUF_ADDR_RECEIVER, &receiver);
+  packetbuf_set_attr(PACKETBUF_ATTR_SECURITY_LEVEL,
+                     PACKETBUF_ATTR_SECURITY_LEVEL_DEFAULT);
+  NETSTACK_MAC.send(packet_sent, NULL);
+}
+/*****************************************************************************/
+/* Parse a recorded frame as the receiver would; returns the payload fill
+   byte, or -1 if the frame does not authenticate */
+static int
+receive(int i)
+{
+  linkaddr_t sender;
+  int fill;
+
+  linkaddr_copy(&sender, &linkaddr_node_addr);
+  linkaddr_set_node_addr(&receiver);
+
+  packetbuf_clear();
+  memcpy(packetbuf_dataptr(), frames[i], frame_lens[i]);
+  packetbuf_set_datalen(frame_lens[i]);
+  fill = csma_security_parse_frame() < 0 ? -1 : *(uint8_t *)packetbuf_dataptr();
+
+  linkaddr_set_node_addr(&sender);
+  return fill;
+}
+/*****************************************************************************/
+UNIT_TEST_REGISTER(burst, "Authenticated burst frames");
+UNIT_TEST(burst)
+{
+  int i;
+  /* Payload of each recorded frame, and whether it has the pending bit */
+  static const int expected_fill[MAX_FRAMES] = { 1, 1, 2, 3 };
+  static const int expected_pending[MAX_FRAMES] = { 1, 1, 1, 0 };
+
+  UNIT_TEST_BEGIN();
+
+  UNIT_TEST_ASSERT(sent_count == BURST_LEN);
+  UNIT_TEST_ASSERT(sent_ok_count == BURST_LEN);
+  UNIT_TEST_ASSERT(frame_count == MAX_FRAMES);
+
+  for(i = 0; i < MAX_FRAMES; i++) {
+    UNIT_TEST_ASSERT(receive(i) == expected_fill[i]);
+    UNIT_TEST_ASSERT(packetbuf_attr(PACKETBUF_ATTR_PENDING) ==
+                     expected_pending[i]);
+    UNIT_TEST_ASSERT(packetbuf_attr(PACKETBUF_ATTR_SECURITY_LEVEL) ==
+                     CSMA_LLSEC_SECURITY_LEVEL);
+  }
+
+  UNIT_TEST_END();
+}
+/*****************************************************************************/
+PROCESS_THREAD(test_csma_burst_llsec_process, ev, data)
+{
+  static struct etimer timeout;
+  static uint8_t fill;
+
+  PROCESS_BEGIN();
+
+  printf("Run unit-test\n");
+  printf("---\n");
+
+  linkaddr_copy(&receiver, &linkaddr_node_addr);
+  receiver.u8[LINKADDR_SIZE - 1] ^= 0xff;
+
+  for(fill = 1; fill <= BURST_LEN; fill++) {
+    enqueue(fill);
+  }
+
+  etimer_set(&timeout, CLOCK_SECOND * 5);
+  while(sent_count < BURST_LEN && !etimer_expired(&timeout)) {
+    PROCESS_PAUSE();
+  }
+
+  UNIT_TEST_RUN(burst);
+
+  if(!UNIT_TEST_PASSED(burst)) {
+    printf("=check-me= FAILED\n");
+    printf("---\n");
+  }
+
+  printf("=check-me= DONE\n");
+  printf("---\n");
+
+  PROCESS_END();
+}
+/*****************************************************************************/
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ *      Test of an event ring larger than 128 entries: events posted while
+ *      the ring wraps around must all be delivered, in FIFO order.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "contiki.h"
+#include "unit-test/unit-test.h"
+/*****************************************************************************/
+/* Moves the first event of the ring past half of the ring */
+#define FIRST_BURST 150
+/* Then wraps around the end of the ring */
+#define SECOND_BURST 180
+/*****************************************************************************/
+PROCESS(test_process_events_process, "Process events test process");
+PROCESS(sink_process, "Sink");
+AUTOSTART_PROCESSES(&test_process_events_process);
+/*****************************************************************************/
+static process_event_t test_event;
+static unsigned nposted;
+static unsigned nfailed;
+static unsigned ndelivered;
+static unsigned nout_of_order;
+/*****************************************************************************/
+PROCESS_THREAD(sink_process, ev, data)
+{
+  PROCESS_BEGIN();
+  while(1) {
+    PROCESS_WAIT_EVENT_UNTIL(ev == test_event);
+    if((uintptr_t)data != ndelivered) {
+      nout_of_order++;
+    }
+    ndelivered++;
+  }
+  PROCESS_END();
+}
+/*****************************************************************************/
+static void
+post_burst(unsigned count)
+{
+  unsigned i;
+
+  for(i = 0; i < count; i++) {
+    if(process_post(&sink_process, test_event,
+                    (process_data_t)(uintptr_t)nposted) == PROCESS_ERR_OK) {
+      nposted++;
+    } else {
+      nfailed++;
+    }
+  }
+}
+/*****************************************************************************/
+UNIT_TEST_REGISTER(ring_wrap, "Ring wrap-around");
+UNIT_TEST(ring_wrap)
+{
+  UNIT_TEST_BEGIN();
+
+  UNIT_TEST_ASSERT(nfailed == 0);
+  UNIT_TEST_ASSERT(nposted == FIRST_BURST + SECOND_BURST);
+  UNIT_TEST_ASSERT(ndelivered == nposted);
+  UNIT_TEST_ASSERT(nout_of_order == 0);
+
+  UNIT_TEST_END();
+}
+/*****************************************************************************/
+PROCESS_THREAD(test_process_events_process, ev, data)
+{
+  PROCESS_BEGIN();
+
+  printf("Run unit-test\n");
+  printf("---\n");
+
+  test_event = process_alloc_event();
+  process_start(&sink_process, NULL);
+
+  /* The events of a burst are all delivered before the continue event
+     of the pause */
+  post_burst(FIRST_BURST);
+  PROCESS_PAUSE();
+  post_burst(SECOND_BURST);
+  PROCESS_PAUSE();
+
+  printf("Events posted: %u, failed: %u, delivered: %u, out of order: %u\n",
+         nposted, nfailed, ndelivered, nout_of_order);
+
+  UNIT_TEST_RUN(ring_wrap);
+
+  if(!UNIT_TEST_PASSED(ring_wrap)) {
+    printf("=check-me= FAILED\n");
+    printf("---\n");
+  }
+
+  printf("=check-me= DONE\n");
+  printf("---\n");
+
+  PROCESS_END();
+}
+/*****************************************************************************/
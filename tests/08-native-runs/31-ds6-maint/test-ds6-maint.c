@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ *      Test of the cadence of the uip-ds6 maintenance scheduler with timer
+ *      slack enabled: a task of period one second must run every second.
+ */
+
+#include <stdio.h>
+
+#include "contiki.h"
+#include "net/ipv6/uip-ds6-maint.h"
+#include "unit-test/unit-test.h"
+/*****************************************************************************/
+#define TEST_SECONDS 10
+/*****************************************************************************/
+PROCESS(test_ds6_maint_process, "uip-ds6 maintenance test process");
+AUTOSTART_PROCESSES(&test_ds6_maint_process);
+/*****************************************************************************/
+static uip_ds6_maint_task_t task;
+static unsigned nruns;
+/*****************************************************************************/
+static void
+count_run(void)
+{
+  nruns++;
+}
+/*****************************************************************************/
+UNIT_TEST_REGISTER(cadence, "One second task");
+UNIT_TEST(cadence)
+{
+  UNIT_TEST_BEGIN();
+
+  UNIT_TEST_ASSERT(nruns >= TEST_SECONDS - 1);
+  UNIT_TEST_ASSERT(nruns <= TEST_SECONDS);
+
+  UNIT_TEST_END();
+}
+/*****************************************************************************/
+PROCESS_THREAD(test_ds6_maint_process, ev, data)
+{
+  static struct etimer et;
+
+  PROCESS_BEGIN();
+
+  printf("Run unit-test\n");
+  printf("---\n");
+
+  uip_ds6_maint_add(&task, CLOCK_SECOND, count_run, NULL);
+  etimer_set(&et, TEST_SECONDS * CLOCK_SECOND + CLOCK_SECOND / 2);
+  PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&et));
+  uip_ds6_maint_remove(&task);
+  printf("Runs in %u seconds: %u\n", TEST_SECONDS, nruns);
+
+  UNIT_TEST_RUN(cadence);
+
+  if(!UNIT_TEST_PASSED(cadence)) {
+    printf("=check-me= FAILED\n");
+    printf("---\n");
+  }
+
+  printf("=check-me= DONE\n");
+  printf("---\n");
+
+  PROCESS_END();
+}
+/*****************************************************************************/
@@ -0,0 +1,26 @@
+#!/bin/bash
+source ../utils.sh
+
+# Contiki directory
+CONTIKI=$1
+
+CODE_DIR=sicslowpan-copy
+CODE=sicslowpan-copy
+
+echo "Building native node"
+make -C $CODE_DIR TARGET=native
+
+timeout -k 1s 10s "$CODE_DIR/$CODE.native"
+EXIT_CODE=$?
+echo "exit code:" $EXIT_CODE
+
+if [ $EXIT_CODE -ne 0 ]; then
+  printf "%-32s TEST FAIL\n" "$CODE"
+  exit 1
+fi
+
+printf "%-32s TEST OK\n" "$CODE"
+
+# We do not want Make to stop -> Return 0
+# The Makefile will check if a log contains FAIL at the end
+exit 0
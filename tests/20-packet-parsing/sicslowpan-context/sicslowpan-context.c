@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ *      Checks that IPHC compresses addresses against each of several
+ *      address contexts, and measures the 6LoWPAN output path in ns per
+ *      packet, with packets that alternate between prefixes and with
+ *      packets that all use the same ones.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "contiki.h"
+#include "net/netstack.h"
+#include "net/packetbuf.h"
+#include "net/ipv6/uip.h"
+#include "net/ipv6/sicslowpan.h"
+/*---------------------------------------------------------------------------*/
+#define NUM_CONTEXTS SICSLOWPAN_CONF_MAX_ADDR_CONTEXTS
+/* Number of packets timed per run */
+#define TIMED_PACKETS 200000
+/* Bytes saved by the context of one address with an inline IID */
+#define CONTEXT_SAVING 8
+/* The context identifier extension byte, sent when a context is used */
+#define CID_LEN 1
+/*---------------------------------------------------------------------------*/
+PROCESS(sicslowpan_context_process, "6LoWPAN context benchmark");
+AUTOSTART_PROCESSES(&sicslowpan_context_process);
+
+static int frame_len;
+/*---------------------------------------------------------------------------*/
+static void
+init(void)
+{
+}
+/*---------------------------------------------------------------------------*/
+static void
+send(mac_callback_t sent, void *ptr)
+{
+  frame_len = packetbuf_totlen();
+  mac_call_sent_callback(sent, ptr, MAC_TX_OK, 1);
+}
+/*---------------------------------------------------------------------------*/
+static void
+input(void)
+{
+}
+/*---------------------------------------------------------------------------*/
+static int
+on(void)
+{
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static int
+off(void)
+{
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static int
+max_payload(void)
+{
+  return 127;
+}
+/*---------------------------------------------------------------------------*/
+const struct mac_driver frame_mac_driver = {
+  "frame-mac",
+  init,
+  send,
+  input,
+  on,
+  off,
+  max_payload,
+};
+/*---------------------------------------------------------------------------*/
+static uint64_t
+now_ns(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+/*---------------------------------------------------------------------------*/
+/* The address of a node under the prefix of RSU n, fd00:0:0:n::/64 */
+static void
+rsu_addr(uip_ipaddr_t *addr, uint16_t n, uint16_t node)
+{
+  uip_ip6addr(addr, 0xfd00, 0, 0, n, 0x1234, 0x5678, 0x9abc, node);
+}
+/*---------------------------------------------------------------------------*/
+/* Sends a UDP packet between RSU prefixes, returns the frame length */
+static int
+send_packet(uint16_t src_rsu, uint16_t dst_rsu)
+{
+  linkaddr_t dest;
+  uint16_t payload_len = 16;
+
+  memset(uip_buf, 0, UIP_IPH_LEN + UIP_UDPH_LEN);
+  UIP_IP_BUF->vtc = 0x60;
+  UIP_IP_BUF->proto = UIP_PROTO_UDP;
+  UIP_IP_BUF->ttl = 64;
+  uipbuf_set_len_field(UIP_IP_BUF, UIP_UDPH_LEN + payload_len);
+  rsu_addr(&UIP_IP_BUF->srcipaddr, src_rsu, 1);
+  rsu_addr(&UIP_IP_BUF->destipaddr, dst_rsu, 2);
+  UIP_UDP_BUF->srcport = UIP_HTONS(0xf0b1);
+  UIP_UDP_BUF->destport = UIP_HTONS(0xf0b2);
+  UIP_UDP_BUF->udplen = UIP_HTONS(UIP_UDPH_LEN + payload_len);
+  memset(uip_buf + UIP_IPH_LEN + UIP_UDPH_LEN, 0x55, payload_len);
+  uip_len = UIP_IPH_LEN + UIP_UDPH_LEN + payload_len;
+  uipbuf_clear_attr();
+
+  memset(&dest, 0, sizeof(dest));
+  dest.u8[LINKADDR_SIZE - 1] = 2;
+  frame_len = 0;
+  if(!sicslowpan_driver.output(&dest)) {
+    return 0;
+  }
+  return frame_len;
+}
+/*---------------------------------------------------------------------------*/
+static unsigned long
+time_packets(int alternate)
+{
+  uint64_t start;
+  unsigned i;
+
+  start = now_ns();
+  for(i = 0; i < TIMED_PACKETS; i++) {
+    if(alternate) {
+      send_packet(i % NUM_CONTEXTS, (i + 3) % NUM_CONTEXTS);
+    } else {
+      send_packet(1, 1);
+    }
+  }
+  return (unsigned long)((now_ns() - start) / TIMED_PACKETS);
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(sicslowpan_context_process, ev, data)
+{
+  uip_ipaddr_t prefix;
+  int no_context_len;
+  int failed;
+  int i;
+
+  PROCESS_BEGIN();
+
+  /* The native platform does not run the 6LoWPAN driver init: set
+   * all the contexts, the first one being fd00::/64 */
+  for(i = 0; i < NUM_CONTEXTS; i++) {
+    rsu_addr(&prefix, i, 0);
+    sicslowpan_set_addr_context(i, &prefix);
+  }
+
+  failed = 0;
+  /* The prefix of RSU NUM_CONTEXTS has no context */
+  no_context_len = send_packet(NUM_CONTEXTS, NUM_CONTEXTS);
+  for(i = 0; i < NUM_CONTEXTS; i++) {
+    if(send_packet(i, (i + 1) % NUM_CONTEXTS) !=
+       no_context_len - 2 * CONTEXT_SAVING + CID_LEN) {
+      printf("Context %u not used\n", i);
+      failed = 1;
+    }
+  }
+  /* A cleared context is no longer used */
+  sicslowpan_set_addr_context(3, NULL);
+  if(send_packet(3, 2) != no_context_len - CONTEXT_SAVING + CID_LEN) {
+    printf("Cleared context 3 still used\n");
+    failed = 1;
+  }
+  rsu_addr(&prefix, 3, 0);
+  sicslowpan_set_addr_context(3, &prefix);
+
+  printf("Frame of %d bytes, %d without context\n",
+         no_context_len - 2 * CONTEXT_SAVING + CID_LEN, no_context_len);
+  printf("Same prefixes: %lu ns/packet\n", time_packets(0));
+  printf("Alternating prefixes: %lu ns/packet\n", time_packets(1));
+
+  exit(failed ? EXIT_FAILURE : EXIT_SUCCESS);
+
+  PROCESS_END();
+}
@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ *      Measures how many bytes the 6LoWPAN output path copies for every
+ *      byte of IPv6 packet it hands to the MAC layer, from uip_buf to the
+ *      queued MAC frames. The MAC driver below queues every frame in a
+ *      queuebuf, as CSMA does. The native platform uses tun6 as its
+ *      network driver, so the 6LoWPAN driver is called directly.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "contiki.h"
+#include "net/netstack.h"
+#include "net/packetbuf.h"
+#include "net/queuebuf.h"
+#include "net/ipv6/uip.h"
+#include "net/ipv6/sicslowpan.h"
+/*---------------------------------------------------------------------------*/
+/* Largest frame payload reported by the MAC layer */
+#define MAC_MAX_PAYLOAD 102
+/* Upper bound on the number of bytes copied per IPv6 byte, in percent */
+#define MAX_COPY_RATIO 350
+/*---------------------------------------------------------------------------*/
+PROCESS(sicslowpan_copy_process, "6LoWPAN copy benchmark");
+AUTOSTART_PROCESSES(&sicslowpan_copy_process);
+
+static unsigned long bytes_copied;
+static unsigned frames_queued;
+/*---------------------------------------------------------------------------*/
+void *__real_memcpy(void *dst, const void *src, size_t len);
+void *__real_memmove(void *dst, const void *src, size_t len);
+
+void *
+__wrap_memcpy(void *dst, const void *src, size_t len)
+{
+  bytes_copied += len;
+  return __real_memcpy(dst, src, len);
+}
+
+void *
+__wrap_memmove(void *dst, const void *src, size_t len)
+{
+  bytes_copied += len;
+  return __real_memmove(dst, src, len);
+}
+/*---------------------------------------------------------------------------*/
+static void
+init(void)
+{
+}
+/*---------------------------------------------------------------------------*/
+static void
+send(mac_callback_t sent, void *ptr)
+{
+  struct queuebuf *q;
+
+  /* Queue the frame, then report it as sent right away */
+  q = queuebuf_new_from_packetbuf();
+  if(q == NULL) {
+    mac_call_sent_callback(sent, ptr, MAC_TX_ERR, 1);
+    return;
+  }
+  frames_queued++;
+  queuebuf_free(q);
+  mac_call_sent_callback(sent, ptr, MAC_TX_OK, 1);
+}
+/*---------------------------------------------------------------------------*/
+static void
+input(void)
+{
+}
+/*---------------------------------------------------------------------------*/
+static int
+on(void)
+{
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static int
+off(void)
+{
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static int
+max_payload(void)
+{
+  return MAC_MAX_PAYLOAD;
+}
+/*---------------------------------------------------------------------------*/
+const struct mac_driver queue_mac_driver = {
+  "queue-mac",
+  init,
+  send,
+  input,
+  on,
+  off,
+  max_payload,
+};
+/*---------------------------------------------------------------------------*/
+/* Fills uip_buf with a link-local UDP packet of the given total length */
+static void
+prepare_packet(uint16_t len)
+{
+  uint16_t payload_len = len - UIP_IPH_LEN;
+
+  memset(uip_buf, 0, UIP_IPH_LEN + UIP_UDPH_LEN);
+  UIP_IP_BUF->vtc = 0x60;
+  UIP_IP_BUF->proto = UIP_PROTO_UDP;
+  UIP_IP_BUF->ttl = 64;
+  uipbuf_set_len_field(UIP_IP_BUF, payload_len);
+  uip_ip6addr(&UIP_IP_BUF->srcipaddr, 0xfe80, 0, 0, 0, 0, 0, 0, 1);
+  uip_ip6addr(&UIP_IP_BUF->destipaddr, 0xfe80, 0, 0, 0, 0, 0, 0, 2);
+  UIP_UDP_BUF->srcport = UIP_HTONS(0xf0b1);
+  UIP_UDP_BUF->destport = UIP_HTONS(0xf0b2);
+  UIP_UDP_BUF->udplen = UIP_HTONS(payload_len);
+  memset(uip_buf + UIP_IPH_LEN + UIP_UDPH_LEN, 0x55,
+         payload_len - UIP_UDPH_LEN);
+  uip_len = len;
+  uipbuf_clear_attr();
+}
+/*---------------------------------------------------------------------------*/
+static int
+measure(uint16_t len)
+{
+  linkaddr_t dest;
+  unsigned long ratio;
+
+  memset(&dest, 0, sizeof(dest));
+  dest.u8[LINKADDR_SIZE - 1] = 2;
+
+  prepare_packet(len);
+  frames_queued = 0;
+  bytes_copied = 0;
+  if(!sicslowpan_driver.output(&dest)) {
+    printf("IPv6 packet of %4u bytes: output failed\n", len);
+    return 0;
+  }
+  ratio = bytes_copied * 100 / len;
+
+  printf("IPv6 packet of %4u bytes: %2u frames, %5lu bytes copied, "
+         "%lu.%02lu bytes copied per IPv6 byte\n",
+         len, frames_queued, bytes_copied, ratio / 100, ratio % 100);
+
+  return ratio <= MAX_COPY_RATIO;
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(sicslowpan_copy_process, ev, data)
+{
+  static const uint16_t lengths[] = { 64, 100, 200, 400, 800, 1280 };
+  int failed;
+  int i;
+
+  PROCESS_BEGIN();
+
+  failed = 0;
+  for(i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++) {
+    if(!measure(lengths[i])) {
+      failed = 1;
+    }
+  }
+
+  if(failed) {
+    printf("Copy ratio above %u.%02u\n",
+           MAX_COPY_RATIO / 100, MAX_COPY_RATIO % 100);
+    exit(EXIT_FAILURE);
+  }
+  exit(EXIT_SUCCESS);
+
+  PROCESS_END();
+}
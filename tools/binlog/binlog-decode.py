@@ -0,0 +1,291 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2026, Contiki-NG contributors.
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+# 1. Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+# 2. Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in the
+#    documentation and/or other materials provided with the distribution.
+# 3. Neither the name of the copyright holder nor the names of its
+#    contributors may be used to endorse or promote products derived
+#    from this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+# FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+# COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+# INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+# (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+# SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+# HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+# STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+# OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""Decode the records of the binary log (LOG_CONF_WITH_BINARY).
+
+The firmware prints each record as a hex line starting with "#B". This
+tool replaces these lines with the text the logs would have printed,
+looking up the format and module strings in the firmware image, which
+must be the ELF file of the exact build that produced the log (the
+.native executable, the .cooja library or the .elf file). Other lines
+are copied unchanged, so a COOJA.testlog or a serial dump can be
+decoded before being analysed as usual.
+
+Usage: binlog-decode.py [-t] FIRMWARE [LOGFILE ...]
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+MARKER = '#B'
+ANCHOR = 'log_binary_anchor'
+HEADER_LEN = 14
+FLAG_PREFIX = 0x80
+FLAG_LEVEL = 0x07
+LEVELS = {0: 'PRI', 1: 'ERR', 2: 'WARN', 3: 'INFO', 4: 'DBG'}
+
+FLAGS_WIDTH = '-+ #0123456789.*'
+LENGTH_MODIFIERS = 'hljzt'
+
+
+class Elf:
+    """Just enough of an ELF reader to find strings by address."""
+
+    def __init__(self, path):
+        with open(path, 'rb') as f:
+            self.data = f.read()
+        if self.data[:4] != b'\x7fELF':
+            raise ValueError('%s is not an ELF file' % path)
+        self.is64 = self.data[4] == 2
+        self.endian = '<' if self.data[5] == 1 else '>'
+        if self.is64:
+            shoff, = self.unpack('Q', 0x28)
+            shentsize, shnum, shstrndx = self.unpack('HHH', 0x3a)
+        else:
+            shoff, = self.unpack('I', 0x20)
+            shentsize, shnum, shstrndx = self.unpack('HHH', 0x2e)
+        self.sections = []
+        for i in range(shnum):
+            off = shoff + i * shentsize
+            if self.is64:
+                (name, stype, flags, addr, offset, size,
+                 link, _, _, entsize) = self.unpack('IIQQQQIIQQ', off)
+            else:
+                (name, stype, flags, addr, offset, size,
+                 link, _, _, entsize) = self.unpack('IIIIIIIIII', off)
+            self.sections.append(dict(name=name, type=stype, flags=flags,
+                                      addr=addr, offset=offset, size=size,
+                                      link=link, entsize=entsize))
+        self.anchor = self.find_symbol(ANCHOR)
+        if self.anchor is None:
+            raise ValueError('%s has no %s: not built with the binary log'
+                             % (path, ANCHOR))
+
+    def unpack(self, fmt, offset):
+        return struct.unpack_from(self.endian + fmt, self.data, offset)
+
+    def cstring(self, offset):
+        end = self.data.index(b'\0', offset)
+        return self.data[offset:end].decode('latin-1')
+
+    def find_symbol(self, wanted):
+        SHT_SYMTAB, SHT_DYNSYM = 2, 11
+        for sec in self.sections:
+            if sec['type'] not in (SHT_SYMTAB, SHT_DYNSYM):
+                continue
+            strtab = self.sections[sec['link']]['offset']
+            entsize = sec['entsize'] or (24 if self.is64 else 16)
+            for off in range(sec['offset'], sec['offset'] + sec['size'],
+                             entsize):
+                if self.is64:
+                    name, _, _, _, value, _ = self.unpack('IBBHQQ', off)
+                else:
+                    name, value, _, _, _, _ = self.unpack('IIIBBH', off)
+                if name and self.cstring(strtab + name) == wanted:
+                    return value
+        return None
+
+    def string_at(self, anchor_offset):
+        """The string at the given offset from the anchor."""
+        SHF_ALLOC, SHT_NOBITS = 0x2, 8
+        if anchor_offset >= 0x80000000:
+            anchor_offset -= 0x100000000
+        addr = self.anchor + anchor_offset
+        for sec in self.sections:
+            if (sec['flags'] & SHF_ALLOC and sec['type'] != SHT_NOBITS
+                    and sec['addr'] <= addr < sec['addr'] + sec['size']):
+                return self.cstring(sec['offset'] + addr - sec['addr'])
+        return '<unknown string %+d>' % anchor_offset
+
+
+class Args:
+    """The arguments of a record, read in the order of the format."""
+
+    def __init__(self, data, endian):
+        self.data = data
+        self.pos = 0
+        self.endian = endian
+
+    def take(self, fmt):
+        size = struct.calcsize(fmt)
+        if self.pos + size > len(self.data):
+            raise EOFError
+        value, = struct.unpack_from(self.endian + fmt, self.data, self.pos)
+        self.pos += size
+        return value
+
+    def string(self):
+        length = self.take('B')
+        if self.pos + length > len(self.data):
+            raise EOFError
+        value = self.data[self.pos:self.pos + length].decode('latin-1')
+        self.pos += length
+        return value
+
+
+def format_record(fmt, args):
+    """printf, with the same conversion parsing as log-binary.c."""
+    out = []
+    i = 0
+    try:
+        while i < len(fmt):
+            c = fmt[i]
+            i += 1
+            if c != '%':
+                out.append(c)
+                continue
+            spec = ''
+            while i < len(fmt) and fmt[i] in FLAGS_WIDTH:
+                spec += str(args.take('i')) if fmt[i] == '*' else fmt[i]
+                i += 1
+            lmod = ''
+            while i < len(fmt) and fmt[i] in LENGTH_MODIFIERS:
+                lmod += fmt[i]
+                i += 1
+            conv = fmt[i] if i < len(fmt) else ''
+            i += 1
+            wide = lmod in ('ll', 'j')
+            if conv in 'di':
+                value = args.take('q' if wide else 'i')
+                if lmod == 'h':
+                    value = struct.unpack('h', struct.pack('H', value & 0xffff))[0]
+                elif lmod == 'hh':
+                    value = struct.unpack('b', struct.pack('B', value & 0xff))[0]
+                out.append(('%' + spec + 'd') % value)
+            elif conv in 'uoxX':
+                value = args.take('Q' if wide else 'I')
+                if lmod == 'h':
+                    value &= 0xffff
+                elif lmod == 'hh':
+                    value &= 0xff
+                out.append(('%' + spec + conv.replace('u', 'd')) % value)
+            elif conv == 'c':
+                out.append(('%' + spec + 'c') % chr(args.take('I') & 0xff))
+            elif conv == 'p':
+                out.append(('%' + spec + 's') % ('0x%x' % args.take('I')))
+            elif conv == 's':
+                out.append(('%' + spec + 's') % args.string())
+            elif conv and conv in 'eEfFgG':
+                out.append(('%' + spec + conv) % args.take('f'))
+            elif conv == '%':
+                out.append('%')
+            else:
+                # Not stored by the firmware: print the rest as is
+                out.append('%' + spec + lmod + fmt[i - 1:])
+                break
+    except EOFError:
+        # The arguments did not fit in the record
+        out.append('<truncated>\n' if fmt.endswith('\n') else '<truncated>')
+    return ''.join(out)
+
+
+class Decoder:
+    def __init__(self, elf, with_time):
+        self.elf = elf
+        self.with_time = with_time
+        # Unfinished line of each source, keyed by the line prefix
+        self.pending = {}
+
+    def record(self, data):
+        length = data[0]
+        if length < HEADER_LEN or length > len(data):
+            raise ValueError('bad record length')
+        _, flags, time, module, fmt = struct.unpack_from(
+            self.elf.endian + 'BBIII', data)
+        text = format_record(self.elf.string_at(fmt),
+                             Args(data[HEADER_LEN:length], self.elf.endian))
+        if flags & FLAG_PREFIX:
+            level = LEVELS.get(flags & FLAG_LEVEL, '?')
+            text = '[%-4s: %-10s] %s' % (level, self.elf.string_at(module),
+                                         text)
+            if self.with_time:
+                text = '%u %s' % (time, text)
+        return text
+
+    def line(self, line):
+        pos = line.find(MARKER)
+        if pos < 0:
+            return [line]
+        prefix = line[:pos]
+        # The source of a line is its prefix without a leading timestamp
+        key = re.sub(r'^\s*[\d:.]+\s+', '', prefix)
+        try:
+            text = self.record(bytes.fromhex(line[pos + len(MARKER):].strip()))
+        except ValueError as e:
+            return ['%s<bad record: %s>' % (prefix, e)]
+        start, pending = self.pending.pop(key, (prefix, ''))
+        text = pending + text
+        lines = []
+        while '\n' in text:
+            head, text = text.split('\n', 1)
+            lines.append(start + head)
+            start = prefix
+        if text:
+            self.pending[key] = (start, text)
+        return lines
+
+    def flush(self):
+        lines = [start + text for start, text in self.pending.values()]
+        self.pending.clear()
+        return lines
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Decode the records of the Contiki-NG binary log.')
+    parser.add_argument('-t', '--time', action='store_true',
+                        help='start the log lines with the clock time of '
+                        'their record')
+    parser.add_argument('firmware', help='ELF image of the firmware')
+    parser.add_argument('logs', nargs='*',
+                        help='log files (default: standard input)')
+    args = parser.parse_args()
+
+    try:
+        elf = Elf(args.firmware)
+    except (OSError, ValueError) as e:
+        sys.exit('binlog-decode: %s' % e)
+
+    decoder = Decoder(elf, args.time)
+    for name in args.logs or ['-']:
+        f = sys.stdin if name == '-' else open(name, errors='replace')
+        for line in f:
+            for out in decoder.line(line.rstrip('\n')):
+                print(out)
+        if f is not sys.stdin:
+            f.close()
+    for out in decoder.flush():
+        print(out)
+
+
+if __name__ == '__main__':
+    main()